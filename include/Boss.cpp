@@ -146,59 +146,7 @@ void Boss::takeDamage(float amount, const AttackType &attack)
         active = false;
     }
 
-    glPushAttrib(GL_LIGHTING_BIT | GL_CURRENT_BIT);
-    glEnable(GL_COLOR_MATERIAL);
-
-    switch (attack){
-    case AttackType::PHYSICAL:
-        std::cout << "Boss hit by physical attack!" << std::endl;
-        glColor3f(1.0f, 0.0f, 0.0f);
-        glPushMatrix();
-        glTranslatef(x, y, z);
-        glutSolidSphere(0.6f, 16, 16); 
-        glPopMatrix();
-        break;
-
-    case AttackType::FIRE:
-        std::cout << "Boss hit by fire attack!" << std::endl;
-        glColor3f(1.0f, 0.5f, 0.0f);
-        glPushMatrix();
-        glTranslatef(x, y, z);
-        glutSolidSphere(0.5f, 16, 16);
-        glPopMatrix();
-        break;
-
-    case AttackType::ICE:
-        std::cout << "Boss hit by ice attack!" << std::endl;
-        glColor3f(0.0f, 0.7f, 1.0f);
-        glPushMatrix();
-        glTranslatef(x, y, z);
-        glutSolidSphere(0.6f, 16, 16);
-        glPopMatrix();
-        break;
-
-    case AttackType::POISON:
-        std::cout << "Boss hit by poison attack!" << std::endl;
-        glColor3f(0.0f, 1.0f, 0.0f);
-        glPushMatrix();
-        glTranslatef(x, y, z);
-        glutSolidSphere(0.55f, 16, 16);
-        glPopMatrix();
-        break;
-
-    case AttackType::MAGIC:
-        std::cout << "Boss hit by magic attack!" << std::endl;
-        glColor3f(0.5f, 0.0f, 0.5f);
-        glPushMatrix();
-        glTranslatef(x, y, z);
-        glutSolidSphere(0.65f, 16, 16);
-        glPopMatrix();
-        break;
-
-    default:
-        std::cout << "Boss hit by unknown attack type!" << std::endl;
-    }
-    glPopAttrib();
+    ParticleSystem::emitHit(x, y, z, attack, 1.5f);
 }
 
 void Boss::drawForLoader(MeshLoader &loader){
@@ -213,15 +161,15 @@ void Boss::drawHealthBar(){
     int windowWidth = glutGet(GLUT_WINDOW_WIDTH);
     int windowHeight = glutGet(GLUT_WINDOW_HEIGHT);
 
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, windowWidth, 0, windowHeight, -1, 1);
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-    glDisable(GL_LIGHTING);
-    glDisable(GL_DEPTH_TEST);
+    GLState::matrixMode(GL_PROJECTION);
+    GLState::pushMatrix();
+    GLState::loadIdentity();
+    GLState::ortho(0, windowWidth, 0, windowHeight, -1, 1);
+    GLState::matrixMode(GL_MODELVIEW);
+    GLState::pushMatrix();
+    GLState::loadIdentity();
+    GLState::disable(GL_LIGHTING);
+    GLState::disable(GL_DEPTH_TEST);
 
     float healthPercent = health / maxHealth;
     float barWidth = std::max(100.0f, std::min(windowWidth * 0.5f, windowWidth * 0.5f * healthPercent));
@@ -229,7 +177,7 @@ void Boss::drawHealthBar(){
     float barPosX = windowWidth * 0.5f - barWidth * 0.5f;
     float barPosY = windowHeight * 0.9f;
 
-    glColor3f(0.2f, 0.2f, 0.3f);
+    GLState::color(0.2f, 0.2f, 0.3f);
     glBegin(GL_QUADS);
     glVertex2f(barPosX, barPosY);
     glVertex2f(barPosX + barWidth, barPosY);
@@ -238,9 +186,9 @@ void Boss::drawHealthBar(){
     glEnd();
 
     if (enraged){
-        glColor3f(0.0f, 0.3f, 1.0f);
+        GLState::color(0.0f, 0.3f, 1.0f);
     }else{
-        glColor3f(0.0f, 0.4f + (0.6f * healthPercent), 0.6f + (0.4f * healthPercent));
+        GLState::color(0.0f, 0.4f + (0.6f * healthPercent), 0.6f + (0.4f * healthPercent));
     }
 
     glBegin(GL_QUADS);
@@ -250,19 +198,18 @@ void Boss::drawHealthBar(){
     glVertex2f(barPosX, barPosY + barHeight);
     glEnd();
 
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glRasterPos2f(barPosX + barWidth * 0.5f - 50, barPosY + barHeight + 20);
+    GLState::color(1.0f, 1.0f, 1.0f);
     const char *bossName = "OIIA OIIA EN";
-    for (const char *c = bossName; *c != '\0'; ++c){
-        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-    }
-
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_LIGHTING);
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+    float nameX = barPosX + barWidth * 0.5f - 50;
+    float nameY = barPosY + barHeight + 20;
+    TextRenderer::print(nameX, nameY, bossName, 18);
+
+    GLState::enable(GL_DEPTH_TEST);
+    GLState::enable(GL_LIGHTING);
+    GLState::matrixMode(GL_PROJECTION);
+    GLState::popMatrix();
+    GLState::matrixMode(GL_MODELVIEW);
+    GLState::popMatrix();
 }
 
 float Boss::getTerrainHeight(float x, float z){
@@ -4,6 +4,9 @@
 #include "GameObject.hpp"
 #include "Player.hpp"
 #include "MeshLoader.hpp"
+#include "glState.hpp"
+#include "textRenderer.hpp"
+#include "particleSystem.hpp"
 #include <vector>
 
 class Boss : public GameObject {
@@ -4,26 +4,43 @@
 Camera::Camera()
     : distance(5.0f), height(2.0f), zoom(50.f), topDownView(false), sensitivity(0.2f), rotationX(0.0f), rotationY(0.0f), panSpeed(0.05f) {}
 
-void Camera::applyView(const Player &player)
+void Camera::viewParams(const Player &player, float eye[3], float center[3], float up[3]) const
 {
     if (topDownView)
     {
-        gluLookAt(posX, zoom, posZ,
-                  posX, 0.0f, posZ,
-                  0.0f, 0.0f, -1.0f);
+        eye[0] = posX; eye[1] = zoom; eye[2] = posZ;
+        center[0] = posX; center[1] = 0.0f; center[2] = posZ;
+        up[0] = 0.0f; up[1] = 0.0f; up[2] = -1.0f;
     }
     else
     {
         float angleRad = player.getRotY() * M_PI / 180.0f;
-        float camX = player.getX() - distance * std::sin(angleRad + rotationY);
-        float camZ = player.getZ() - distance * std::cos(angleRad + rotationY);
-
-        gluLookAt(camX, player.getY() + height, camZ,
-                  player.getX(), player.getY(), player.getZ(),
-                  0.0f, 1.0f, 0.0f);
+        eye[0] = player.getX() - distance * std::sin(angleRad + rotationY);
+        eye[1] = player.getY() + height;
+        eye[2] = player.getZ() - distance * std::cos(angleRad + rotationY);
+        center[0] = player.getX(); center[1] = player.getY(); center[2] = player.getZ();
+        up[0] = 0.0f; up[1] = 1.0f; up[2] = 0.0f;
     }
 }
 
+void Camera::applyView(const Player &player)
+{
+    float eye[3], center[3], up[3];
+    viewParams(player, eye, center, up);
+    GLState::lookAt(eye[0], eye[1], eye[2],
+              center[0], center[1], center[2],
+              up[0], up[1], up[2]);
+}
+
+Mat4 Camera::viewMatrix(const Player &player) const
+{
+    float eye[3], center[3], up[3];
+    viewParams(player, eye, center, up);
+    return Mat4::lookAt(eye[0], eye[1], eye[2],
+                        center[0], center[1], center[2],
+                        up[0], up[1], up[2]);
+}
+
 void Camera::toggleTopDown(STATE_GAME &gameMode){
     gameMode = (gameMode == STATE_GAME::TOP_VIEW_MAP) ? STATE_GAME::PLAYING_EXPLORER : STATE_GAME::TOP_VIEW_MAP;
     topDownView = !topDownView;
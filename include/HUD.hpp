@@ -2,6 +2,9 @@
 #define HUD_HPP
 
 #include <GL/glut.h>
+#include "glState.hpp"
+#include "textRenderer.hpp"
+#include "hudWidget.hpp"
 #include "player.hpp"
 #include "skillTree.hpp"
 #include "skill.hpp"
@@ -15,7 +18,6 @@ public:
     void drawMainHUD(Player &player, STATE_GAME &gameMode, ACTION_BUTTON &action, Volume &volume);
     void drawSkillTree(std::vector<SkillNode> &skillN, SkillTooltip &skillTooltip);
     void addButtonMenu(float r, float g, float b, float x, float y, const char *text);
-    void renderRoundedButton(float x, float y, float width, float height, float radius);
     std::vector<Botao> getButtonMenu();
     void setHoveredButton(int id) { hoveredButtonID = id; }
     int getHoveredBUtton() { return hoveredButtonID; }
@@ -23,19 +25,44 @@ public:
     void screenshotAnimation(float deltaTime);
 
 private:
+    enum MenuScreen
+    {
+        MENU_SCREEN_NONE,
+        MENU_SCREEN_MAIN,
+        MENU_SCREEN_CREDITS,
+        MENU_SCREEN_CONTROLS,
+        MENU_SCREEN_SETTINGS,
+        MENU_SCREEN_GAME_OVER
+    };
+
     Player &player;
     int hoveredButtonID = -1;
     std::vector<Botao> botoesMenu;
 
+    // Tamanho da janela lido uma vez por desenho.
+    int windowWidth = 0, windowHeight = 0;
+    int skillLayoutWidth = 0, skillLayoutHeight = 0;
+    // Tela (e tamanho) para a qual botoesMenu foi montado.
+    MenuScreen menuScreen = MENU_SCREEN_NONE;
+    int menuWidth = 0, menuHeight = 0;
+
+    HudWidget statusBars;
+    HudWidget skillTreePanel;
+    HudWidget skillTreeNodes;
+    HudWidget skillTreeBorders;
+    HudWidget skillTooltipWidget;
+    HudWidget menuBackdrop;
+    HudWidget menuScreenWidget;
+
+    void refreshWindowSize();
+    bool enterMenuScreen(MenuScreen screen);
     void drawText(float x, float y, const char *text, int fontSize);
     void calculateSkillTreeLayout(std::vector<SkillNode> &skillNodes);
-    void drawSkillTreeConnections(std::vector<SkillNode> &skillNodes);
+    void addSkillTreeConnections(HudGeometry &geometry, const std::vector<SkillNode> &skillNodes);
     void drawSkillTreeNodes(std::vector<SkillNode> &skillNodes);
-    void drawSkillIcon(float x, float y, SkillType type);
-    void drawFilledCircle(float x, float y, float radius, int segments);
+    void addSkillIcon(HudGeometry &geometry, float x, float y, SkillType type);
     void drawSkillTooltip(SkillTooltip &skillTooltip);
-    void drawStar(float x, float y, float radius, int points);
-    void drawCircle(float x, float y, float radius, int segments);
+    void addRoundedButton(HudGeometry &geometry, float x, float y, float width, float height, float radius);
 
     void renderizarControles();
     void renderizarMenuCreditos();
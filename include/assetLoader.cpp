@@ -0,0 +1,122 @@
+#include "assetLoader.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+std::vector<std::thread> AssetLoader::workers;
+std::mutex AssetLoader::mutex;
+std::condition_variable AssetLoader::wake;
+std::deque<std::function<void()>> AssetLoader::jobs;
+std::deque<AssetLoader::Upload> AssetLoader::uploads;
+size_t AssetLoader::outstanding = 0;
+size_t AssetLoader::completed = 0;
+bool AssetLoader::stopping = false;
+GLint AssetLoader::maxTextureSize = 0;
+std::chrono::steady_clock::time_point AssetLoader::batchStart;
+
+void AssetLoader::start()
+{
+    if (!workers.empty())
+        return;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+
+    // Um núcleo fica para o jogo (e para o parser de OBJ, que divide o arquivo sozinho).
+    unsigned int threads = std::max(2u, std::thread::hardware_concurrency()) - 1;
+    stopping = false;
+    for (unsigned int i = 0; i < threads; ++i)
+        workers.emplace_back(&AssetLoader::run);
+    // O GLUT sai por exit(): as threads precisam ser juntadas antes dos estáticos morrerem.
+    static bool registered = false;
+    if (!registered)
+    {
+        std::atexit(&AssetLoader::shutdown);
+        registered = true;
+    }
+}
+
+void AssetLoader::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        jobs.clear();
+    }
+    wake.notify_all();
+    for (std::thread &worker : workers)
+        worker.join();
+    workers.clear();
+    uploads.clear();
+    outstanding = 0;
+}
+
+void AssetLoader::run()
+{
+    while (true)
+    {
+        std::function<void()> work;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [] { return stopping || !jobs.empty(); });
+            if (stopping)
+                return;
+            work = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        work();
+        std::lock_guard<std::mutex> lock(mutex);
+        --outstanding;
+    }
+}
+
+void AssetLoader::enqueue(std::function<void()> work)
+{
+    start();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (outstanding == 0)
+            batchStart = std::chrono::steady_clock::now();
+        ++outstanding;
+        jobs.push_back(std::move(work));
+    }
+    wake.notify_one();
+}
+
+void AssetLoader::upload(size_t bytes, std::function<void()> fn)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ++outstanding;
+    uploads.push_back({bytes, std::move(fn)});
+}
+
+bool AssetLoader::idle()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return outstanding == 0;
+}
+
+void AssetLoader::pump()
+{
+    size_t spent = 0;
+    while (true)
+    {
+        Upload next;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (uploads.empty() || (spent > 0 && spent + uploads.front().bytes > UPLOAD_BUDGET_BYTES))
+                return;
+            next = std::move(uploads.front());
+            uploads.pop_front();
+        }
+        next.fn();
+        spent += next.bytes;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        ++completed;
+        if (--outstanding == 0)
+        {
+            float ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - batchStart).count();
+            std::cout << "Assets carregados em segundo plano: " << completed << " em " << ms << " ms" << std::endl;
+            completed = 0;
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef ASSET_LOADER_HPP
+#define ASSET_LOADER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "glState.hpp"
+
+// Carregamento em segundo plano: decodificar imagens e ler malhas vai para um pool de
+// threads; o que precisa do contexto GL volta numa fila que o thread principal esvazia
+// no começo de cada frame (pump), até um orçamento de bytes enviados por frame.
+// Quem pede recebe na hora um handle válido que começa como substituto (textura branca
+// 1x1 do TextureManager, malha que não desenha) e passa a ser o asset de verdade quando
+// o upload acontece.
+class AssetLoader
+{
+public:
+    // Bytes enviados ao driver por frame antes de deixar o resto para o próximo
+    // (sempre pelo menos um item, para o carregamento nunca parar).
+    static const size_t UPLOAD_BUDGET_BYTES = 4 * 1024 * 1024;
+
+    // Sobe as threads (uma a menos que os núcleos, no mínimo uma). Precisa do contexto GL.
+    static void start();
+    static void shutdown();
+
+    // GL_MAX_TEXTURE_SIZE lido no start(), para os decodificadores fora do thread GL.
+    static GLint textureSizeLimit() { return maxTextureSize; }
+
+    // work roda num thread do pool. De dentro dele, upload(bytes, fn) agenda fn para o
+    // thread principal.
+    static void enqueue(std::function<void()> work);
+    static void upload(size_t bytes, std::function<void()> fn);
+
+    // Executa uploads pendentes até o orçamento do frame; no thread principal.
+    static void pump();
+    // Nada na fila, decodificando ou esperando upload.
+    static bool idle();
+
+private:
+    struct Upload
+    {
+        size_t bytes;
+        std::function<void()> fn;
+    };
+
+    static std::vector<std::thread> workers;
+    static std::mutex mutex;
+    static std::condition_variable wake;
+    static std::deque<std::function<void()>> jobs;
+    static std::deque<Upload> uploads;
+    static size_t outstanding; // pedidos ainda não enviados
+    static size_t completed;
+    static bool stopping;
+    static GLint maxTextureSize;
+    static std::chrono::steady_clock::time_point batchStart;
+
+    static void run();
+};
+
+#endif
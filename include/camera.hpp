@@ -2,6 +2,7 @@
 #define CAMERA_H
 
 #include <GL/glu.h>
+#include "glState.hpp"
 #include "player.hpp"
 
 class Camera
@@ -13,6 +14,8 @@ private:
     float sensitivity; 
     float zoom;        
 
+    void viewParams(const Player &player, float eye[3], float center[3], float up[3]) const;
+
 public:
     float posX = 0.0f;
     float posZ = 0.0f;
@@ -23,6 +26,8 @@ public:
     Camera();
 
     void applyView(const Player &player);
+    // Mesma view do applyView sem tocar no OpenGL (usada fora do render).
+    Mat4 viewMatrix(const Player &player) const;
     void toggleTopDown(STATE_GAME &gameMode);
     void toggleDistance();
     void adjustHeight(int deltaY);
@@ -67,145 +67,58 @@ void Enemy::takeDamage(float amount, const AttackType &attack)
         active = false;
     }
 
-    glPushAttrib(GL_LIGHTING_BIT | GL_CURRENT_BIT);
-    glEnable(GL_COLOR_MATERIAL);
-
-    switch (attack)
-    {
-    case AttackType::PHYSICAL:
-        std::cout << "Displaying physical effect: impact!" << std::endl;
-        glColor3f(1.0f, 0.0f, 0.0f);
-        glPushMatrix();
-        glTranslatef(x, y, z);
-        glutSolidSphere(0.4f, 16, 16);
-        glPopMatrix();
-        break;
-    case AttackType::FIRE:
-        std::cout << "Displaying fire effect: flame burst!" << std::endl;
-        glColor3f(1.0f, 0.5f, 0.0f);
-        glPushMatrix();
-        glTranslatef(x, y, z);
-        glutSolidSphere(0.3f, 16, 16);
-        glPopMatrix();
-        break;
-    case AttackType::ICE:
-        std::cout << "Displaying ice effect: freezing!" << std::endl;
-        glColor3f(0.0f, 0.7f, 1.0f);
-        glPushMatrix();
-        glTranslatef(x, y, z);
-        glutSolidSphere(0.4f, 16, 16);
-        glPopMatrix();
-        break;
-    case AttackType::POISON:
-        std::cout << "Displaying poison effect: toxic pools!" << std::endl;
-        glColor3f(0.0f, 1.0f, 0.0f);
-        glPushMatrix();
-        glTranslatef(x, y, z);         
-        glutSolidSphere(0.35f, 16, 16); 
-        glPopMatrix();
-        break;
-
-    case AttackType::MAGIC:
-        std::cout << "Displaying magic effect: magic glow!" << std::endl;
-        glColor3f(0.5f, 0.0f, 0.5f);
-        glPushMatrix();
-        glTranslatef(x, y, z);          
-        glutSolidSphere(0.45f, 16, 16);
-        glPopMatrix();
-        break;
-    default:
-        std::cout << "Unknown effect type!" << std::endl;
-    }
-    glPopAttrib();
+    ParticleSystem::emitHit(x, y, z, attack);
 }
 
 void Enemy::draw()
 {
     if (!active) return;
 
-    glPushMatrix();
-    glTranslatef(x, y, z);
+    GLState::pushMatrix();
+    GLState::translate(x, y, z);
 
     GLfloat ambient[] = {1.0f, 0.1f, 0.1f, 1.0f};
     GLfloat diffuse[] = {0.8f, 0.2f, 0.2f, 1.0f};
     GLfloat specular[] = {0.9f, 0.0f, 0.0f, 1.0f};
     GLfloat shininess = 2.0f;
 
-    glDisable(GL_COLOR_MATERIAL);
-    glMaterialfv(GL_FRONT, GL_AMBIENT, ambient);
-    glMaterialfv(GL_FRONT, GL_DIFFUSE, diffuse);
-    glMaterialfv(GL_FRONT, GL_SPECULAR, specular);
-    glMaterialf(GL_FRONT, GL_SHININESS, shininess);
-
-    glPushMatrix();
-    glScalef(size, size, size);
-    glutSolidCube(0.8f);
-    glPopMatrix();
-
-    glPushMatrix();
-    glTranslatef(0.0f, size * 0.6f, 0.0f);
-    glutSolidSphere(size * 0.3f, 8, 8);
-    glPopMatrix();
-
-    drawHealthBar();
+    GLState::disable(GL_COLOR_MATERIAL);
+    GLState::material(GL_AMBIENT, ambient);
+    GLState::material(GL_DIFFUSE, diffuse);
+    GLState::material(GL_SPECULAR, specular);
+    GLState::materialf(GL_SHININESS, shininess);
 
-    glPopMatrix();
-}
+    if (Renderer::isActive())
+    {
+        Renderer::matchFixedFunction(1.0f, 1.0f, 1.0f);
+
+        GLState::pushMatrix();
+        GLState::scale(size * 0.8f, size * 0.8f, size * 0.8f);
+        Renderer::draw(Renderer::unitCube());
+        GLState::popMatrix();
+
+        GLState::pushMatrix();
+        GLState::translate(0.0f, size * 0.6f, 0.0f);
+        GLState::scale(size * 0.3f, size * 0.3f, size * 0.3f);
+        Renderer::draw(Renderer::unitSphere());
+        GLState::popMatrix();
+    }
+    else
+    {
+        GLState::pushMatrix();
+        GLState::scale(size, size, size);
+        glutSolidCube(0.8f);
+        GLState::forgetCurrent(GLState::CURRENT_NORMAL);
+        GLState::popMatrix();
+
+        GLState::pushMatrix();
+        GLState::translate(0.0f, size * 0.6f, 0.0f);
+        glutSolidSphere(size * 0.3f, 8, 8);
+        GLState::forgetCurrent(GLState::CURRENT_NORMAL);
+        GLState::popMatrix();
+    }
 
-void Enemy::drawHealthBar(){
-    glPushMatrix();
-    float modelview[16];
-    glGetFloatv(GL_MODELVIEW_MATRIX, modelview);
-
-    modelview[0] = 1.0f;
-    modelview[1] = 0.0f;
-    modelview[2] = 0.0f;
-    modelview[4] = 0.0f;
-    modelview[5] = 1.0f;
-    modelview[6] = 0.0f;
-    modelview[8] = 0.0f;
-    modelview[9] = 0.0f;
-    modelview[10] = 1.0f;
-
-    glLoadMatrixf(modelview);
-    glTranslatef(x * 0.1f, y + size * 0.6f, z * 0.005f);
-
-    glDisable(GL_LIGHTING);
-    glDisable(GL_DEPTH_TEST);
-
-    float barWidth = size * 2.0f;
-    float barHeight = size * 0.2f;
-    float healthPercent = health / maxHealth;
-
-    glColor3f(0.3f, 0.3f, 0.3f);
-    glBegin(GL_QUADS);
-    glVertex3f(-barWidth / 2, 0, 0);
-    glVertex3f(barWidth / 2, 0, 0);
-    glVertex3f(barWidth / 2, barHeight, 0);
-    glVertex3f(-barWidth / 2, barHeight, 0);
-    glEnd();
-
-    glColor3f(1.0f - healthPercent, healthPercent, 0.0f);
-    glBegin(GL_QUADS);
-    glVertex3f(-barWidth / 2, 0, 0.01f);
-    glVertex3f(-barWidth / 2 + barWidth * healthPercent, 0, 0.01f);
-    glVertex3f(-barWidth / 2 + barWidth * healthPercent, barHeight, 0.01f);
-    glVertex3f(-barWidth / 2, barHeight, 0.01f);
-    glEnd();
-
-    glColor3f(0.0f, 0.0f, 0.0f);
-    glLineWidth(2.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex3f(-barWidth / 2, 0, 0.02f);
-    glVertex3f(barWidth / 2, 0, 0.02f);
-    glVertex3f(barWidth / 2, barHeight, 0.02f);
-    glVertex3f(-barWidth / 2, barHeight, 0.02f);
-    glEnd();
-
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_LIGHTING);
-
-    glPopMatrix();
+    GLState::popMatrix();
 }
 
 float Enemy::getTerrainHeight(float x, float z){
@@ -4,6 +4,9 @@
 #include "GameObject.hpp"
 #include "Player.hpp"
 #include <GL/glut.h>
+#include "glState.hpp"
+#include "renderer.hpp"
+#include "particleSystem.hpp"
 #include <cmath>
 
 class Enemy : public GameObject {
@@ -27,7 +30,6 @@ public:
     bool attackPlayer(Player& player, float deltaTime);
     void takeDamage(float amount, const AttackType& attack);
     void draw() override;
-    void drawHealthBar();
     float getTerrainHeight(float x, float z);
     bool isExperienceGiven() const;
     void markExperienceAsGiven();
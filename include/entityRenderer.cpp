@@ -0,0 +1,210 @@
+#include "entityRenderer.hpp"
+#include <cstring>
+
+extern unsigned int textureItem;
+
+EntityRenderer::EntityRenderer() : itemFloatOffset(0.0f), itemRotateAngle(0.0f) {}
+
+void EntityRenderer::begin()
+{
+    enemyBodies.clear();
+    enemyHeads.clear();
+    itemCoins.clear();
+    itemRings.clear();
+
+    itemFloatOffset += 0.03f;
+    itemRotateAngle += 0.8f;
+}
+
+bool EntityRenderer::add(GameObject &object)
+{
+    // Sem shader o agrupamento depende só de VBO.
+    if (!Renderer::isActive() && !GLExt::hasBuffers())
+        return false;
+
+    if (object.getType() == ENEMY)
+    {
+        if (auto enemy = dynamic_cast<Enemy *>(&object))
+        {
+            addEnemy(*enemy);
+            return true;
+        }
+    }
+    else if (object.getType() == ITEM)
+    {
+        addItem(object, std::sin(itemFloatOffset) * 0.05f);
+        return true;
+    }
+    return false;
+}
+
+void EntityRenderer::push(std::vector<InstanceData> &batch, const Mat4 &model, float r, float g, float b, float a)
+{
+    InstanceData instance;
+    std::memcpy(instance.model, model.m, sizeof(instance.model));
+    instance.color[0] = r;
+    instance.color[1] = g;
+    instance.color[2] = b;
+    instance.color[3] = a;
+    batch.push_back(instance);
+}
+
+void EntityRenderer::addEnemy(Enemy &enemy)
+{
+    float size = enemy.getSize();
+    Mat4 base = Mat4::translation(enemy.getX(), enemy.getY(), enemy.getZ());
+
+    // Escurece conforme perde vida.
+    float healthPercent = enemy.getMaxHealth() > 0 ? enemy.getHealth() / enemy.getMaxHealth() : 0.0f;
+    float tint = 0.35f + 0.65f * healthPercent;
+
+    push(enemyBodies, base * Mat4::scaling(size * 0.8f, size * 0.8f, size * 0.8f), tint, tint, tint);
+    push(enemyHeads, base * Mat4::translation(0.0f, size * 0.6f, 0.0f) * Mat4::scaling(size * 0.3f, size * 0.3f, size * 0.3f),
+         tint, tint, tint);
+}
+
+void EntityRenderer::addItem(const GameObject &item, float floatHeight)
+{
+    float radius = item.getSize() * 0.5f;
+    Mat4 base = Mat4::translation(item.getX(), item.getY() + floatHeight, item.getZ());
+
+    push(itemCoins, base * Mat4::scaling(radius, radius * 0.2f, radius), 1.0f, 1.0f, 1.0f);
+    push(itemRings, base * Mat4::rotation(itemRotateAngle, 0.0f, 1.0f, 0.0f), 1.0f, 1.0f, 1.0f);
+}
+
+void EntityRenderer::flush()
+{
+    if (enemyBodies.empty() && itemCoins.empty())
+        return;
+
+    buildMeshes();
+    flushEnemies();
+    flushItems();
+}
+
+void EntityRenderer::buildMeshes()
+{
+    std::vector<GpuVertex> vertices;
+    std::vector<unsigned int> indices;
+    if (ringMesh.isEmpty())
+    {
+        GpuMesh::buildTorus(0.05f, 0.15f, 6, 16, vertices, indices);
+        ringMesh.upload(vertices, indices);
+    }
+    if (Renderer::isActive() || !fixedCube.isEmpty())
+        return;
+
+    GpuMesh::buildCube(1.0f, vertices, indices);
+    fixedCube.upload(vertices, indices);
+    GpuMesh::buildSphere(1.0f, 8, 8, vertices, indices);
+    fixedHead.upload(vertices, indices);
+    GpuMesh::buildSphere(1.0f, 24, 24, vertices, indices);
+    fixedCoin.upload(vertices, indices);
+}
+
+void EntityRenderer::drawFixed(const GpuMesh &mesh, const std::vector<InstanceData> &batch,
+                               const GLfloat ambient[4], const GLfloat diffuse[4])
+{
+    // As escalas da matriz de cada instância encurtam a normal.
+    bool normalize = !GLState::isEnabled(GL_NORMALIZE);
+    if (normalize)
+        GLState::enable(GL_NORMALIZE);
+
+    mesh.bindFixedFunction();
+    for (const InstanceData &instance : batch)
+    {
+        // Cor repetida (ex.: inimigos com vida cheia) não chega ao driver: o GLState filtra.
+        GLfloat tintedAmbient[4], tintedDiffuse[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            tintedAmbient[i] = ambient[i] * instance.color[i];
+            tintedDiffuse[i] = diffuse[i] * instance.color[i];
+        }
+        GLState::material(GL_AMBIENT, tintedAmbient);
+        GLState::material(GL_DIFFUSE, tintedDiffuse);
+
+        GLState::pushMatrix();
+        GLState::multMatrix(instance.model);
+        mesh.drawFixedElements();
+        GLState::popMatrix();
+    }
+    mesh.unbindFixedFunction();
+
+    if (normalize)
+        GLState::disable(GL_NORMALIZE);
+}
+
+void EntityRenderer::flushEnemies()
+{
+    if (enemyBodies.empty())
+        return;
+
+    // Mesmo material do Enemy::draw.
+    GLfloat ambient[] = {1.0f, 0.1f, 0.1f, 1.0f};
+    GLfloat diffuse[] = {0.8f, 0.2f, 0.2f, 1.0f};
+    GLfloat specular[] = {0.9f, 0.0f, 0.0f, 1.0f};
+
+    GLState::disable(GL_COLOR_MATERIAL);
+    GLState::disable(GL_TEXTURE_2D);
+    GLState::material(GL_AMBIENT, ambient);
+    GLState::material(GL_DIFFUSE, diffuse);
+    GLState::material(GL_SPECULAR, specular);
+    GLState::materialf(GL_SHININESS, 2.0f);
+
+    if (!Renderer::isActive())
+    {
+        drawFixed(fixedCube, enemyBodies, ambient, diffuse);
+        drawFixed(fixedHead, enemyHeads, ambient, diffuse);
+        return;
+    }
+
+    Renderer::matchFixedFunction(1.0f, 1.0f, 1.0f);
+    Renderer::drawInstanced(Renderer::unitCube(), enemyBodies);
+    Renderer::drawInstanced(Renderer::unitSphere(), enemyHeads);
+}
+
+void EntityRenderer::flushItems()
+{
+    if (itemCoins.empty())
+        return;
+
+    // Mesmos materiais do case ITEM em StaticObject::draw.
+    GLfloat goldAmbient[] = {0.3f, 0.2f, 0.1f, 1.0f};
+    GLfloat goldDiffuse[] = {0.8f, 0.7f, 0.2f, 1.0f};
+    GLfloat goldSpecular[] = {0.6f, 0.6f, 0.3f, 1.0f};
+    GLfloat goldEmission[] = {0.1f, 0.1f, 0.0f, 1.0f};
+    GLfloat gemDiffuse[] = {0.9f, 0.8f, 0.1f, 1.0f};
+    GLfloat noEmission[] = {0.0f, 0.0f, 0.0f, 1.0f};
+
+    GLState::enable(GL_LIGHTING);
+    GLState::enable(GL_TEXTURE_2D);
+    GLState::bindTexture(textureItem);
+    GLState::matrixMode(GL_TEXTURE);
+    GLState::loadIdentity();
+    GLState::matrixMode(GL_MODELVIEW);
+    GLState::texEnvMode(GL_MODULATE);
+    GLState::material(GL_AMBIENT, goldAmbient);
+    GLState::material(GL_DIFFUSE, goldDiffuse);
+    GLState::material(GL_SPECULAR, goldSpecular);
+    GLState::materialf(GL_SHININESS, 50.0f);
+    GLState::material(GL_EMISSION, goldEmission);
+
+    if (Renderer::isActive())
+    {
+        Renderer::matchFixedFunction(1.0f, 1.0f, 1.0f);
+        Renderer::drawInstanced(Renderer::unitSphere(), itemCoins);
+
+        GLState::disable(GL_TEXTURE_2D);
+        GLState::material(GL_AMBIENT_AND_DIFFUSE, gemDiffuse);
+        Renderer::matchFixedFunction(1.0f, 1.0f, 1.0f);
+        Renderer::drawInstanced(ringMesh, itemRings);
+    }
+    else
+    {
+        drawFixed(fixedCoin, itemCoins, goldAmbient, goldDiffuse);
+        GLState::disable(GL_TEXTURE_2D);
+        drawFixed(ringMesh, itemRings, gemDiffuse, gemDiffuse);
+    }
+
+    GLState::material(GL_EMISSION, noEmission);
+}
@@ -0,0 +1,48 @@
+#ifndef ENTITY_RENDERER_HPP
+#define ENTITY_RENDERER_HPP
+
+#include <vector>
+#include "GameObject.hpp"
+#include "enemy.hpp"
+#include "renderer.hpp"
+#include "matrix.hpp"
+
+// Agrupa as entidades dinâmicas repetidas (inimigos e itens) e desenha cada
+// tipo com uma chamada instanciada, independente de quantas estão na tela.
+// No pipeline fixo cada tipo faz um bind só do VBO e troca apenas matriz e cor por instância.
+class EntityRenderer
+{
+public:
+    EntityRenderer();
+
+    void begin();
+    // Retorna false quando o objeto não é agrupável e deve usar o draw() próprio.
+    bool add(GameObject &object);
+    void flush();
+
+private:
+    std::vector<InstanceData> enemyBodies;
+    std::vector<InstanceData> enemyHeads;
+    std::vector<InstanceData> itemCoins;
+    std::vector<InstanceData> itemRings;
+    GpuMesh ringMesh;
+    // Malhas do pipeline fixo, na mesma tesselagem do glut/GLU que o draw() próprio usava.
+    GpuMesh fixedCube;
+    GpuMesh fixedHead;
+    GpuMesh fixedCoin;
+
+    float itemFloatOffset;
+    float itemRotateAngle;
+
+    static void push(std::vector<InstanceData> &batch, const Mat4 &model, float r, float g, float b, float a = 1.0f);
+    void addEnemy(Enemy &enemy);
+    void addItem(const GameObject &item, float floatHeight);
+    void flushEnemies();
+    void flushItems();
+    void buildMeshes();
+    // Material base multiplicado pela cor de cada instância, como o uTint do shader.
+    static void drawFixed(const GpuMesh &mesh, const std::vector<InstanceData> &batch,
+                          const GLfloat ambient[4], const GLfloat diffuse[4]);
+};
+
+#endif
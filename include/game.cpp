@@ -1,6 +1,12 @@
 #include "game.hpp"
 
 const float Game::WORLD_SIZE = 25.0f;
+const float Game::LAKE_RADIUS = 3.5f;
+const float Game::LAKE_CENTERS[Game::LAKE_COUNT][2] = {
+    {5.0f, 5.0f},
+    {-7.0f, -3.0f},
+    {8.0f, -6.0f},
+    {-4.0f, 7.0f}};
 extern unsigned int texturaGrama;
 extern unsigned int texturaParaside;
 extern unsigned int texturaBoss;
@@ -60,42 +66,15 @@ float Game::lerp(float a, float b, float t) { return a + (b - a) * t; }
 
 bool Game::isUnderWater(float x, float z)
 {
-    std::vector<std::pair<float, float>> lakeCenters = {
-        {5.0f, 5.0f},
-        {-7.0f, -3.0f},
-        {8.0f, -6.0f},
-        {-4.0f, 7.0f}};
+    if (lakes.empty())
+        buildLakes();
 
-    float radius = 3.5f;
-
-    for (const auto &center : lakeCenters)
+    for (const Lake &lake : lakes)
     {
-
-        float cx = center.first;
-        float cz = center.second;
-        float dist = std::sqrt((x - cx) * (x - cx) + (z - cz) * (z - cz));
-
-        if (dist < radius)
-        {
-
-            float maxEdgeHeight = -1000.0f;
-
-            for (int angle = 0; angle < 360; angle += 10)
-            {
-                float rad = angle * M_PI / 180.0f;
-                float bx = cx + cos(rad) * radius;
-                float bz = cz + sin(rad) * radius;
-                float h = getTerrainHeight(bx, bz);
-                if (h > maxEdgeHeight)
-                    maxEdgeHeight = h;
-            }
-
-            float waterHeight = maxEdgeHeight - 0.02f;
-            float terrainY = getTerrainHeight(x, z);
-
-            if (terrainY < waterHeight)
-                return true;
-        }
+        float dx = x - lake.cx;
+        float dz = z - lake.cz;
+        if (dx * dx + dz * dz < LAKE_RADIUS * LAKE_RADIUS && getTerrainHeight(x, z) < lake.floodHeight)
+            return true;
     }
     return false;
 }
@@ -178,6 +157,7 @@ void Game::generateNaturalTrail(float worldSize)
 {
     trailCurvePoints.clear();
     trailClearings.clear();
+    groundMeshDirty = true;
 
     float minX = -worldSize;
     float maxX = worldSize;
@@ -214,6 +194,9 @@ void Game::loadMainMap()
 {
     currentMap = MapType::MAIN;
     gameObjects.clear();
+    ParticleSystem::clear();
+    occlusion.invalidate();
+    minimap.invalidate();
 
     skyColor[0] = 0.4f;
     skyColor[1] = 0.7f;
@@ -243,6 +226,9 @@ void Game::loadDungeonMap()
 {
     currentMap = MapType::DUNGEON_ONE_LEVEL;
     gameObjects.clear();
+    ParticleSystem::clear();
+    occlusion.invalidate();
+    minimap.invalidate();
     skyColor[0] = 0.05f;
     skyColor[1] = 0.05f;
     skyColor[2] = 0.1f;
@@ -348,6 +334,9 @@ void Game::loadDungeonMap_Level2()
 {
     currentMap = MapType::DUNGEON_TWO_LEVEL;
     gameObjects.clear();
+    ParticleSystem::clear();
+    occlusion.invalidate();
+    minimap.invalidate();
     skyColor[0] = 0.05f;
     skyColor[1] = 0.05f;
     skyColor[2] = 0.1f;
@@ -429,6 +418,9 @@ void Game::loadDungeonMap_Level3()
     currentMap = MapType::DUNGEON_THREE_LEVEL;
 
     gameObjects.clear();
+    ParticleSystem::clear();
+    occlusion.invalidate();
+    minimap.invalidate();
     skyColor[0] = 0.05f;
     skyColor[1] = 0.05f;
     skyColor[2] = 0.1f;
@@ -501,6 +493,9 @@ void Game::loadDungeonMap_Boss()
 {
     currentMap = MapType::BOSS;
     gameObjects.clear();
+    ParticleSystem::clear();
+    occlusion.invalidate();
+    minimap.invalidate();
     skyColor[0] = 0.1f;
     skyColor[1] = 0.02f;
     skyColor[2] = 0.02f;
@@ -541,6 +536,9 @@ void Game::loadParasideMap()
 {
     currentMap = MapType::PARASIDE;
     gameObjects.clear();
+    ParticleSystem::clear();
+    occlusion.invalidate();
+    minimap.invalidate();
 
     skyColor[0] = 0.7f;
     skyColor[1] = 0.9f;
@@ -890,6 +888,10 @@ void Game::update()
     {
         this->updateMoviment();
         player.update(deltaTime);
+        ParticleSystem::update(deltaTime);
+        LightManager::update(deltaTime);
+        // A rasterização dos oclusores corre em paralelo com o resto da simulação.
+        launchOcclusion();
         bool isAnyEnemyActive = false;
         int quant_enemies = 0;
 
@@ -1077,49 +1079,168 @@ void Game::animateSwordAttack(float deltaTime, MeshLoader &loader, const Player
 }
 void Game::render()
 {
+    if (gameMode == STATE_GAME::TOP_VIEW_MAP)
+    {
+        renderMapView();
+        drawInterface();
+        return;
+    }
+
+    QualityManager::setViewer(player.getX(), player.getZ());
+    QualityManager::beginScene(glutGet(GLUT_WINDOW_WIDTH), glutGet(GLUT_WINDOW_HEIGHT));
+
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    gluPerspective(45.0f, glutGet(GLUT_WINDOW_WIDTH) / (float)glutGet(GLUT_WINDOW_HEIGHT), 0.1f, 100.0f);
-    glMatrixMode(GL_MODELVIEW);
+    GLState::matrixMode(GL_PROJECTION);
+    GLState::loadIdentity();
+    GLState::perspective(45.0f, glutGet(GLUT_WINDOW_WIDTH) / (float)glutGet(GLUT_WINDOW_HEIGHT), 0.1f, farPlane());
+    GLState::matrixMode(GL_MODELVIEW);
 
-    glLoadIdentity();
+    GLState::loadIdentity();
     camera.applyView(player);
+    Renderer::beginFrame();
+    LightManager::beginFrame();
 
+    // Chão e lagos são uma malha só: usam as luzes do trecho em volta do jogador.
+    LightManager::apply(player.getX(), player.getZ());
     drawGround();
     drawLakes();
 
-    for (auto &object : gameObjects)
+    entityRenderer.begin();
+    healthBars.begin();
+    // Câmera mexeu desde o update (mouse, reshape): o resultado é descartado e tudo desenha.
+    occlusion.wait(cameraViewProjection());
+    for (size_t i = 0; i < gameObjects.size(); ++i)
     {
-        if (object->isActive())
+        auto &object = gameObjects[i];
+        if (!object->isActive() || !QualityManager::inDrawDistance(object->getX(), object->getZ(), object->getSize()))
+            continue;
+        if (object->getType() == GRASS && !QualityManager::keepGrass(object->getX(), object->getZ()))
+            continue;
+        if (passesOcclusion(i))
         {
             if (auto boss = dynamic_cast<Boss *>(object.get()))
             {
+                LightManager::apply(boss->getX(), boss->getZ());
                 boss->drawForLoader(loader);
+                healthBars.add(boss->getX(), boss->getY() + boss->getSize() * 2.5f, boss->getZ(),
+                               boss->getSize() * 2.5f, boss->getSize() * 0.25f, boss->getHealth() / boss->getMaxHealth());
             }
             else
             {
-                object->draw();
+                if (!entityRenderer.add(*object))
+                {
+                    LightManager::apply(object->getX(), object->getZ());
+                    object->draw();
+                }
+
+                if (object->getType() == ENEMY)
+                {
+                    Enemy *enemy = static_cast<Enemy *>(object.get());
+                    healthBars.add(enemy->getX(), enemy->getY() + enemy->getSize() * 1.1f, enemy->getZ(),
+                                   enemy->getSize() * 2.0f, enemy->getSize() * 0.2f, enemy->getHealth() / enemy->getMaxHealth());
+                }
             }
         }
     }
+    occlusion.invalidate();
+    // Inimigos e itens agrupados saem em uma chamada; usam as luzes perto do jogador.
+    LightManager::apply(player.getX(), player.getZ());
+    entityRenderer.flush();
 
     loader.drawForId(0);
     loader.updateModelTranslationXById(0, player.getX());
     loader.updateModelTranslationYById(0, player.getY());
     loader.updateModelTranslationZById(0, player.getZ() - 0.4f);
     player.draw();
+    LightManager::disableAll();
+
+    ParticleSystem::draw();
+    healthBars.draw();
+    QualityManager::endScene();
+
+    drawInterface();
+}
 
+void Game::drawInterface()
+{
     hud.drawHUD(player, gameMode, showPortalMessage, isOpenHouse);
     if (this->getGameMode() == STATE_GAME::SKILL_TREE)
         hud.drawSkillTree(skillNodes, skillTooltip);
     if (this->getGameMode() == STATE_GAME::MENU || this->getGameMode() == STATE_GAME::GAME_OVER)
         hud.drawMainHUD(player, gameMode, button_action, volume);
+    QualityManager::drawOverlay(glutGet(GLUT_WINDOW_WIDTH), glutGet(GLUT_WINDOW_HEIGHT));
+}
+void Game::captureMinimap()
+{
+    minimap.beginCapture(skyColor);
+    Renderer::beginFrame();
+    LightManager::beginFrame();
+    LightManager::disableAll();
+
+    drawGround();
+    drawLakes();
+
+    // Só o que não se mexe; grama não aparece de cima e fica de fora.
+    for (auto &object : gameObjects)
+    {
+        if (!object->isActive())
+            continue;
+        switch (object->getType())
+        {
+        case ENEMY:
+        case BOSS:
+        case PORTAL:
+        case ITEM:
+        case NPC:
+        case GRASS:
+            break;
+        default:
+            object->draw();
+            break;
+        }
+    }
+    minimap.endCapture();
+}
+
+void Game::renderMapView()
+{
+    if (minimap.needsCapture())
+        captureMinimap();
+
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    minimap.beginMarkers();
+    for (auto &object : gameObjects)
+    {
+        if (!object->isActive())
+            continue;
+        switch (object->getType())
+        {
+        case ENEMY:
+            minimap.addMarker(Minimap::SQUARE, object->getX(), object->getZ(), 8.0f, 220, 40, 40);
+            break;
+        case BOSS:
+            minimap.addMarker(Minimap::DIAMOND, object->getX(), object->getZ(), 16.0f, 200, 0, 0);
+            break;
+        case PORTAL:
+            minimap.addMarker(Minimap::DIAMOND, object->getX(), object->getZ(), 12.0f, 160, 80, 255);
+            break;
+        case ITEM:
+            minimap.addMarker(Minimap::SQUARE, object->getX(), object->getZ(), 6.0f, 255, 210, 40);
+            break;
+        default:
+            break;
+        }
+    }
+    minimap.addMarker(Minimap::ARROW, player.getX(), player.getZ(), 14.0f, 255, 255, 255, player.getRotY());
+
+    // Mesma área que a antiga câmera perspectiva (fovy 45) via de cima na altura do zoom.
+    float halfHeight = camera.getZoom() * std::tan(22.5f * static_cast<float>(M_PI) / 180.0f);
+    minimap.draw(camera.getPosX(), camera.getPosZ(), halfHeight, glutGet(GLUT_WINDOW_WIDTH), glutGet(GLUT_WINDOW_HEIGHT));
 }
+
 void Game::drawGround()
 {
-    const float step = 1.0f;
-    const float size = WORLD_SIZE;
     GLfloat ambient[4];
     GLfloat diffuse[4];
     GLfloat specular[4];
@@ -1229,17 +1350,201 @@ void Game::drawGround()
         texturaAtual = texturaGrama;
     }
 
-    glDisable(GL_COLOR_MATERIAL);
-    glMaterialfv(GL_FRONT, GL_AMBIENT, ambient);
-    glMaterialfv(GL_FRONT, GL_DIFFUSE, diffuse);
-    glMaterialfv(GL_FRONT, GL_SPECULAR, specular);
-    glMaterialf(GL_FRONT, GL_SHININESS, shininess);
+    GLState::disable(GL_COLOR_MATERIAL);
+    GLState::material(GL_AMBIENT, ambient);
+    GLState::material(GL_DIFFUSE, diffuse);
+    GLState::material(GL_SPECULAR, specular);
+    GLState::materialf(GL_SHININESS, shininess);
+
+    if (groundMeshDirty)
+        buildGroundMeshes();
+
+    GLState::enable(GL_TEXTURE_2D);
+    GLState::bindTexture(texturaAtual);
+
+    // Sem shaders o chão usa a luz assada por vértice (refeita quando muda o mapa ou as luzes fixas).
+    bool shaded = Renderer::isActive();
+    if (!shaded && (bakedLightingMap != currentMap || bakedLightingVersion != LightManager::staticVersion()))
+    {
+        BakeMaterial ground = {{ambient[0], ambient[1], ambient[2]}, {diffuse[0], diffuse[1], diffuse[2]}};
+        bakeGroundLighting(ground);
+    }
+
+    if (shaded)
+    {
+        Renderer::matchFixedFunction(1.0f, 1.0f, 1.0f);
+        Renderer::draw(terrainMesh);
+    }
+    else
+    {
+        GLState::disable(GL_LIGHTING);
+        drawGroundArrays(terrainMesh, terrainVertices, terrainLighting);
+    }
 
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, texturaAtual);
+    // Trilhas e clareiras: a mesma malha de novo, com a textura de splat como máscara.
+    // Vértices idênticos + GL_LEQUAL = sem z-fighting e seguindo o relevo exatamente.
+    // Material branco: a cor vem do texel, igual ao antigo GL_AMBIENT_AND_DIFFUSE da trilha.
+    GLfloat decalColor[] = {1.0f, 1.0f, 1.0f, 1.0f};
+    GLfloat decalSpecular[] = {0.2f, 0.2f, 0.2f, 1.0f};
+    GLState::material(GL_AMBIENT_AND_DIFFUSE, decalColor);
+    GLState::material(GL_SPECULAR, decalSpecular);
+    GLState::materialf(GL_SHININESS, 10.0f);
 
-    float texScale = 0.5f;
+    GLState::bindTexture(groundSplatTexture);
+    GLState::texEnvMode(GL_MODULATE);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthFunc(GL_LEQUAL);
+    glDepthMask(GL_FALSE);
 
+    if (shaded)
+    {
+        Renderer::matchFixedFunction(1.0f, 1.0f, 1.0f);
+        Renderer::draw(decalMesh);
+    }
+    else
+    {
+        drawGroundArrays(decalMesh, decalVertices, decalLighting);
+        GLState::enable(GL_LIGHTING);
+    }
+
+    glDepthMask(GL_TRUE);
+    glDepthFunc(GL_LESS);
+    GLState::disable(GL_BLEND);
+    GLState::disable(GL_TEXTURE_2D);
+}
+
+void Game::drawGroundArrays(const GpuMesh &mesh, const std::vector<GpuVertex> &vertices,
+                            const std::vector<GLubyte> &colors)
+{
+    if (!mesh.isEmpty())
+    {
+        mesh.drawFixedFunction(colors.data());
+        return;
+    }
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(GpuVertex), &vertices[0].px);
+    glColorPointer(4, GL_UNSIGNED_BYTE, 0, colors.data());
+    glTexCoordPointer(2, GL_FLOAT, sizeof(GpuVertex), &vertices[0].u);
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(terrainIndices.size()), GL_UNSIGNED_INT, terrainIndices.data());
+    GLState::forgetCurrent(GLState::CURRENT_COLOR | GLState::CURRENT_TEXCOORD);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+void Game::bakeGroundLighting(const BakeMaterial &ground)
+{
+    // Decalques usam material branco: a cor da trilha vem do texel do splat.
+    const BakeMaterial decal = {{1.0f, 1.0f, 1.0f}, {1.0f, 1.0f, 1.0f}};
+    LightBaker::shade(terrainVertices, terrainOcclusion, ground, terrainLighting);
+    LightBaker::shade(terrainVertices, terrainOcclusion, decal, decalLighting);
+
+    bakedLightingMap = currentMap;
+    bakedLightingVersion = LightManager::staticVersion();
+}
+
+void Game::buildOcclusionTerrain()
+{
+    // Grade grossa com a menor altura em volta de cada vértice: fica sempre abaixo do chão desenhado.
+    const float step = 2.5f;
+    const int count = static_cast<int>(2.0f * WORLD_SIZE / step) + 1;
+
+    std::vector<float> positions;
+    std::vector<unsigned int> indices;
+    for (int i = 0; i < count; ++i)
+    {
+        for (int j = 0; j < count; ++j)
+        {
+            float x = -WORLD_SIZE + i * step;
+            float z = -WORLD_SIZE + j * step;
+            float lowest = getTerrainHeight(x, z);
+            for (float dx = -step; dx <= step; dx += step * 0.25f)
+                for (float dz = -step; dz <= step; dz += step * 0.25f)
+                    lowest = std::min(lowest, getTerrainHeight(x + dx, z + dz));
+
+            positions.push_back(x);
+            positions.push_back(lowest - 0.05f);
+            positions.push_back(z);
+        }
+    }
+    for (int i = 0; i + 1 < count; ++i)
+    {
+        for (int j = 0; j + 1 < count; ++j)
+        {
+            unsigned int a = i * count + j, b = (i + 1) * count + j;
+            unsigned int c = (i + 1) * count + j + 1, d = i * count + j + 1;
+            indices.insert(indices.end(), {a, b, c, a, c, d});
+        }
+    }
+    occlusion.setTerrain(positions, indices);
+    occlusionTerrainBuilt = true;
+}
+
+void Game::launchOcclusion()
+{
+    occlusionIds.assign(gameObjects.size(), -1);
+    if (currentMap != MapType::MAIN)
+        return;
+    if (!occlusionTerrainBuilt)
+        buildOcclusionTerrain();
+
+    occlusion.begin(cameraViewProjection());
+
+    // Folga para o que ainda se mexe entre o disparo e o render (inimigos).
+    const float margin = 0.25f;
+    for (size_t i = 0; i < gameObjects.size(); ++i)
+    {
+        const GameObject &object = *gameObjects[i];
+        if (!object.isActive() || object.getType() == PORTAL || object.getType() == BOSS)
+            continue;
+
+        float x = object.getX(), y = object.getY(), z = object.getZ(), s = object.getSize();
+
+        // Oclusores: caixas inscritas nas paredes da casa e no elipsoide da pedra.
+        if (object.getType() == HOUSE)
+            occlusion.addOccluder({{x - 0.4f * s, y, z - 0.4f * s}, {x + 0.4f * s, y + 0.8f * s, z + 0.4f * s}});
+        else if (object.getType() == ROCK && s >= 0.5f)
+            occlusion.addOccluder({{x - 0.28f * s, y - 0.2f * s, z - 0.28f * s}, {x + 0.28f * s, y + 0.2f * s, z + 0.28f * s}});
+
+        float half = object.getType() == GRASS ? 0.1f : s * 1.3f;
+        float top = object.getType() == GRASS ? 0.35f : s * 2.0f; // lâmina de grama tem 0.3 de altura
+        occlusionIds[i] = occlusion.addOccludee({{x - half - margin, y - s * 0.7f - margin, z - half - margin},
+                                                 {x + half + margin, y + top + margin, z + half + margin}});
+    }
+    occlusion.launch();
+}
+
+Mat4 Game::cameraViewProjection() const
+{
+    float aspect = glutGet(GLUT_WINDOW_WIDTH) / (float)glutGet(GLUT_WINDOW_HEIGHT);
+    return Mat4::perspective(45.0f, aspect, 0.1f, farPlane()) * camera.viewMatrix(player);
+}
+
+float Game::farPlane() const
+{
+    return QualityManager::settings().drawDistance + camera.getDistance();
+}
+
+bool Game::passesOcclusion(size_t index) const
+{
+    return index >= occlusionIds.size() || occlusion.isVisible(occlusionIds[index]);
+}
+
+void Game::buildGroundMeshes()
+{
+    const float step = 1.0f;
+    const float size = WORLD_SIZE;
+    const float texScale = 0.5f;
+
+    terrainVertices.clear();
+    decalVertices.clear();
+    terrainIndices.clear();
+
+    // Mesmos vértices, normais e coordenadas de textura do antigo caminho imediato.
     for (float x = -size; x < size; x += step)
     {
         for (float z = -size; z < size; z += step)
@@ -1249,153 +1554,261 @@ void Game::drawGround()
             float y3 = getTerrainHeight(x + step, z + step);
             float y4 = getTerrainHeight(x, z + step);
 
-            glBegin(GL_QUADS);
-            float nx1 = x - (x + step);
-            float ny1 = y1 - y2;
-            float nz1 = z - z;
-            float len1 = sqrt(nx1 * nx1 + ny1 * ny1 + nz1 * nz1);
-            if (len1 > 0)
+            float nx = -step, ny = y1 - y2, nz = 0.0f;
+            float len = std::sqrt(nx * nx + ny * ny + nz * nz);
+            if (len > 0)
             {
-                glNormal3f(nx1 / len1, ny1 / len1, nz1 / len1);
+                nx /= len;
+                ny /= len;
             }
             else
             {
-                glNormal3f(0, 1, 0);
+                nx = 0.0f;
+                ny = 1.0f;
             }
 
-            glTexCoord2f(x * texScale, z * texScale);
-            glVertex3f(x, y1, z);
-
-            glTexCoord2f((x + step) * texScale, z * texScale);
-            glVertex3f(x + step, y2, z);
-
-            glTexCoord2f((x + step) * texScale, (z + step) * texScale);
-            glVertex3f(x + step, y3, z + step);
-
-            glTexCoord2f(x * texScale, (z + step) * texScale);
-            glVertex3f(x, y4, z + step);
-
-            glEnd();
+            unsigned int base = static_cast<unsigned int>(terrainVertices.size());
+            terrainVertices.push_back({x, y1, z, nx, ny, nz, x * texScale, z * texScale});
+            terrainVertices.push_back({x + step, y2, z, nx, ny, nz, (x + step) * texScale, z * texScale});
+            terrainVertices.push_back({x + step, y3, z + step, nx, ny, nz, (x + step) * texScale, (z + step) * texScale});
+            terrainVertices.push_back({x, y4, z + step, nx, ny, nz, x * texScale, (z + step) * texScale});
+            terrainIndices.insert(terrainIndices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
         }
     }
 
-    glDisable(GL_TEXTURE_2D);
-
-    GLfloat trailColor[] = {0.55f, 0.45f, 0.25f, 1.0f};
-    GLfloat trailSpecular[] = {0.2f, 0.2f, 0.2f, 1.0f};
-
-    glMaterialfv(GL_FRONT, GL_AMBIENT_AND_DIFFUSE, trailColor);
-    glMaterialfv(GL_FRONT, GL_SPECULAR, trailSpecular);
-    glMaterialf(GL_FRONT, GL_SHININESS, 10.0f);
-
-    float trailWidth = 0.5f;
-    for (size_t i = 1; i < trailCurvePoints.size(); ++i)
+    // Camada de decalque: mesma geometria, coordenadas cobrindo o mundo inteiro no splat.
+    decalVertices = terrainVertices;
+    for (GpuVertex &v : decalVertices)
     {
-        TrailPoint p1 = trailCurvePoints[i - 1];
-        TrailPoint p2 = trailCurvePoints[i];
+        v.u = (v.px + size) / (2.0f * size);
+        v.v = (v.pz + size) / (2.0f * size);
+    }
 
-        p1.y = getTerrainHeight(p1.x, p1.z) + 0.01f;
-        p2.y = getTerrainHeight(p2.x, p2.z) + 0.01f;
+    // Compacto (16 bytes por vértice) serve aos dois caminhos: sem shader o drawGroundArrays
+    // lê o mesmo VBO e só a cor assada vem da memória.
+    VertexPacking::upload(terrainMesh, terrainVertices.data(), terrainVertices.size(), terrainIndices.data(),
+                          terrainIndices.size(), GL_UNSIGNED_INT, "terreno");
+    VertexPacking::upload(decalMesh, decalVertices.data(), decalVertices.size(), terrainIndices.data(),
+                          terrainIndices.size(), GL_UNSIGNED_INT, "decalque");
+    bakeGroundSplat();
 
-        float dx = p2.z - p1.z;
-        float dz = -(p2.x - p1.x);
-        float len = std::sqrt(dx * dx + dz * dz);
-        dx /= len;
-        dz /= len;
+    // A oclusão só depende do relevo; a luz é assada de novo no próximo drawGround.
+    LightBaker::occlusion(terrainVertices, [this](float x, float z) { return getTerrainHeight(x, z); }, terrainOcclusion);
+    bakedLightingVersion = 0;
 
-        glBegin(GL_TRIANGLE_STRIP);
-        glNormal3f(0.0f, 1.0f, 0.0f);
+    groundMeshDirty = false;
+}
 
-        glVertex3f(p1.x + dx * trailWidth, p1.y, p1.z + dz * trailWidth);
-        glVertex3f(p1.x - dx * trailWidth, p1.y, p1.z - dz * trailWidth);
-        glVertex3f(p2.x + dx * trailWidth, p2.y, p2.z + dz * trailWidth);
-        glVertex3f(p2.x - dx * trailWidth, p2.y, p2.z - dz * trailWidth);
-        glEnd();
-    }
+void Game::bakeGroundSplat()
+{
+    // RGB = cor da trilha/clareira, A = cobertura (com meio texel de antialias na borda).
+    const int resolution = GROUND_SPLAT_SIZE;
+    const float size = WORLD_SIZE;
+    const float texel = 2.0f * size / resolution;
+    const float trailWidth = 0.5f;
+    const float clearingRadius = 1.5f;
+    const float trailColor[3] = {0.55f, 0.45f, 0.25f};
+    const float clearingColor[3] = {0.6f, 0.5f, 0.3f};
+
+    std::vector<float> trailCoverage(resolution * resolution, 0.0f);
+    std::vector<float> clearingCoverage(resolution * resolution, 0.0f);
+
+    // Percorre só os texels dentro da caixa de cada forma.
+    auto stamp = [&](std::vector<float> &coverage, float minX, float minZ, float maxX, float maxZ, auto &&distance, float radius)
+    {
+        int i0 = std::max(0, static_cast<int>((minX - radius + size) / texel) - 1);
+        int i1 = std::min(resolution - 1, static_cast<int>((maxX + radius + size) / texel) + 1);
+        int j0 = std::max(0, static_cast<int>((minZ - radius + size) / texel) - 1);
+        int j1 = std::min(resolution - 1, static_cast<int>((maxZ + radius + size) / texel) + 1);
+        for (int j = j0; j <= j1; ++j)
+        {
+            float wz = -size + (j + 0.5f) * texel;
+            for (int i = i0; i <= i1; ++i)
+            {
+                float wx = -size + (i + 0.5f) * texel;
+                float c = std::max(0.0f, std::min(1.0f, (radius - distance(wx, wz)) / texel + 0.5f));
+                float &target = coverage[j * resolution + i];
+                target = std::max(target, c);
+            }
+        }
+    };
 
-    GLfloat clearingColor[] = {0.6f, 0.5f, 0.3f, 1.0f};
-    glMaterialfv(GL_FRONT, GL_AMBIENT_AND_DIFFUSE, clearingColor);
+    for (size_t i = 1; i < trailCurvePoints.size(); ++i)
+    {
+        const TrailPoint &p1 = trailCurvePoints[i - 1];
+        const TrailPoint &p2 = trailCurvePoints[i];
+        float sx = p2.x - p1.x, sz = p2.z - p1.z;
+        float lengthSq = sx * sx + sz * sz;
+        auto segmentDistance = [&](float wx, float wz)
+        {
+            float t = lengthSq > 0.0f ? ((wx - p1.x) * sx + (wz - p1.z) * sz) / lengthSq : 0.0f;
+            t = std::max(0.0f, std::min(1.0f, t));
+            float dx = wx - (p1.x + sx * t), dz = wz - (p1.z + sz * t);
+            return std::sqrt(dx * dx + dz * dz);
+        };
+        stamp(trailCoverage, std::min(p1.x, p2.x), std::min(p1.z, p2.z), std::max(p1.x, p2.x), std::max(p1.z, p2.z),
+              segmentDistance, trailWidth);
+    }
 
     for (const auto &c : trailClearings)
     {
-        float radius = 1.5f;
-        float segments = 16.0f;
-        float centerY = getTerrainHeight(c.x, c.z) + 0.01f;
-
-        glBegin(GL_TRIANGLE_FAN);
-        glNormal3f(0.0f, 1.0f, 0.0f);
-
-        glVertex3f(c.x, centerY, c.z);
-        for (int i = 0; i <= segments; ++i)
+        auto centerDistance = [&](float wx, float wz)
         {
-            float angle = 2.0f * M_PI * i / segments;
-            float x = c.x + std::cos(angle) * radius;
-            float z = c.z + std::sin(angle) * radius;
-            float y = getTerrainHeight(x, z) + 0.01f;
-            glVertex3f(x, y, z);
-        }
-        glEnd();
-    }
+            return std::sqrt((wx - c.x) * (wx - c.x) + (wz - c.z) * (wz - c.z));
+        };
+        stamp(clearingCoverage, c.x, c.z, c.x, c.z, centerDistance, clearingRadius);
+    }
+
+    std::vector<GLubyte> pixels(resolution * resolution * 4);
+    for (int i = 0; i < resolution * resolution; ++i)
+    {
+        float trail = trailCoverage[i], clearing = clearingCoverage[i];
+        float alpha = std::max(trail, clearing);
+        float mix = alpha > 0.0f ? clearing / (trail + clearing) : 0.0f;
+        for (int k = 0; k < 3; ++k)
+            pixels[i * 4 + k] = static_cast<GLubyte>(lerp(trailColor[k], clearingColor[k], mix) * 255.0f);
+        pixels[i * 4 + 3] = static_cast<GLubyte>(alpha * 255.0f);
+    }
+
+    // Linhas do splat seguem z e colunas seguem x, como as coordenadas da camada de decalque.
+    GLuint previous = GLState::boundTexture();
+    if (!groundSplatTexture)
+        glGenTextures(1, &groundSplatTexture);
+    GLState::bindTexture(groundSplatTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    gluBuild2DMipmaps(GL_TEXTURE_2D, GL_RGBA, resolution, resolution, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    GLState::bindTexture(previous);
 }
 
-void Game::drawLakes()
+void Game::buildLakes()
 {
-    float time = glutGet(GLUT_ELAPSED_TIME) / 1000.0f;
-    std::vector<std::pair<float, float>> lakeCenters = {
-        {5.0f, 5.0f},
-        {-7.0f, -3.0f},
-        {8.0f, -6.0f},
-        {-4.0f, 7.0f}};
+    // Anéis concêntricos em volta do centro: mais vértices no interior para a onda.
+    const int rings = 8;
+    const int segments = 36;
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_LIGHTING);
+    lakes.clear();
+    lakeVertices.clear();
+    lakeWaves.clear();
+    lakeIndices.clear();
 
-    for (const auto &center : lakeCenters)
+    for (int l = 0; l < LAKE_COUNT; ++l)
     {
-        float cx = center.first;
-        float cz = center.second;
-        float radius = 3.5f;
+        Lake lake;
+        lake.cx = LAKE_CENTERS[l][0];
+        lake.cz = LAKE_CENTERS[l][1];
 
         float minEdgeHeight = 1000.0f;
+        float maxEdgeHeight = -1000.0f;
         for (int angle = 0; angle < 360; angle += 10)
         {
             float rad = angle * M_PI / 180.0f;
-            float x = cx + cos(rad) * radius;
-            float z = cz + sin(rad) * radius;
-            float height = getTerrainHeight(x, z);
-            if (height < minEdgeHeight)
+            float h = getTerrainHeight(lake.cx + cos(rad) * LAKE_RADIUS, lake.cz + sin(rad) * LAKE_RADIUS);
+            minEdgeHeight = std::min(minEdgeHeight, h);
+            maxEdgeHeight = std::max(maxEdgeHeight, h);
+        }
+        lake.waterHeight = minEdgeHeight - 0.02f;
+        lake.floodHeight = maxEdgeHeight - 0.02f;
+        lakes.push_back(lake);
+
+        // Centro com a cor do antigo leque; até a borda a cor passa para a da margem
+        // e o alfa passa a seguir a profundidade da água naquele ponto.
+        GLushort center = static_cast<GLushort>(lakeVertices.size());
+        for (int ring = 0; ring <= rings; ++ring)
+        {
+            float t = static_cast<float>(ring) / rings;
+            int count = ring == 0 ? 1 : segments;
+            for (int i = 0; i < count; ++i)
             {
-                minEdgeHeight = height;
+                float rad = i * 2.0f * M_PI / segments;
+                float x = lake.cx + cos(rad) * LAKE_RADIUS * t;
+                float z = lake.cz + sin(rad) * LAKE_RADIUS * t;
+                float depth = lake.waterHeight - getTerrainHeight(x, z);
+                float edgeAlpha = std::min(0.5f, std::max(0.15f, depth * 0.8f));
+
+                LakeVertex v;
+                v.x = x;
+                v.y = lake.waterHeight;
+                v.z = z;
+                v.r = static_cast<GLubyte>(lerp(0.0f, 0.2f, t) * 255.0f);
+                v.b = static_cast<GLubyte>(lerp(0.7f, 0.8f, t) * 255.0f);
+                v.a = static_cast<GLubyte>(lerp(0.25f, edgeAlpha, t) * 255.0f);
+                v.g = 0;
+                lakeVertices.push_back(v);
+
+                LakeWave w;
+                w.baseY = lake.waterHeight;
+                w.baseGreen = lerp(0.4f, 0.6f, t);
+                w.sinA = sin(rad * 4);
+                w.cosA = cos(rad * 4);
+                w.ampA = 0.02f * t;
+                w.sinB = sin(t * 9.0f);
+                w.cosB = cos(t * 9.0f);
+                w.ampB = 0.008f * (1.0f - t) * t * 4.0f;
+                lakeWaves.push_back(w);
             }
         }
-        float waterHeight = minEdgeHeight - 0.02f;
-
-        float depthColor = std::min(1.0f, (waterHeight + 1.0f) / 5.0f);
-        glColor4f(0.0f, 0.4f + 0.1f * sin(time), 0.7f, 0.25f);
 
-        glBegin(GL_TRIANGLE_FAN);
-        glVertex3f(cx, waterHeight, cz);
-        for (int angle = 0; angle <= 360; angle += 10)
+        for (int i = 0; i < segments; ++i)
         {
-            float rad = angle * M_PI / 180.0f;
-            float x = cx + cos(rad) * radius;
-            float z = cz + sin(rad) * radius;
-            float wave = sin(rad * 4 + time * 2) * 0.02f;
+            int next = (i + 1) % segments;
+            lakeIndices.push_back(center);
+            lakeIndices.push_back(static_cast<GLushort>(center + 1 + i));
+            lakeIndices.push_back(static_cast<GLushort>(center + 1 + next));
+        }
+        for (int ring = 1; ring < rings; ++ring)
+        {
+            GLushort inner = static_cast<GLushort>(center + 1 + (ring - 1) * segments);
+            GLushort outer = static_cast<GLushort>(inner + segments);
+            for (int i = 0; i < segments; ++i)
+            {
+                int next = (i + 1) % segments;
+                lakeIndices.push_back(static_cast<GLushort>(inner + i));
+                lakeIndices.push_back(static_cast<GLushort>(outer + i));
+                lakeIndices.push_back(static_cast<GLushort>(outer + next));
+                lakeIndices.push_back(static_cast<GLushort>(inner + i));
+                lakeIndices.push_back(static_cast<GLushort>(outer + next));
+                lakeIndices.push_back(static_cast<GLushort>(inner + next));
+            }
+        }
+    }
+}
 
-            float terrainHeight = getTerrainHeight(x, z);
-            float depth = waterHeight - terrainHeight;
+void Game::drawLakes()
+{
+    if (lakes.empty())
+        buildLakes();
 
-            float alpha = std::min(0.5f, std::max(0.15f, depth * 0.8f));
-            glColor4f(0.2f, 0.6f + 0.1f * sin(time), 0.8f, alpha);
+    float time = glutGet(GLUT_ELAPSED_TIME) / 1000.0f;
 
-            glVertex3f(x, waterHeight + wave, z);
-        }
-        glEnd();
+    // sin(fase + tempo) = sin(fase)cos(tempo) + cos(fase)sin(tempo): dois senos por frame no total.
+    float sinA = sin(time * 2), cosA = cos(time * 2);
+    float sinB = sin(-time * 3), cosB = cos(-time * 3);
+    float green = 0.1f * sin(time);
+    for (size_t i = 0; i < lakeVertices.size(); ++i)
+    {
+        const LakeWave &w = lakeWaves[i];
+        lakeVertices[i].y = w.baseY + w.ampA * (w.sinA * cosA + w.cosA * sinA) + w.ampB * (w.sinB * cosB + w.cosB * sinB);
+        lakeVertices[i].g = static_cast<GLubyte>((w.baseGreen + green) * 255.0f);
     }
 
-    glDisable(GL_BLEND);
-    glEnable(GL_LIGHTING);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::disable(GL_LIGHTING);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(LakeVertex), &lakeVertices[0].x);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(LakeVertex), &lakeVertices[0].r);
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(lakeIndices.size()), GL_UNSIGNED_SHORT, lakeIndices.data());
+    GLState::forgetCurrent(GLState::CURRENT_COLOR);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    GLState::disable(GL_BLEND);
+    GLState::enable(GL_LIGHTING);
 }
 
 void Game::calculateSkillTreeLayout()
@@ -1666,6 +2079,21 @@ void Game::handleSpecialKeyPress(int key, int x, int y)
     case 112:
         player.toggleRunning();
         break;
+    case GLUT_KEY_F3:
+        QualityManager::toggleOverlay();
+        break;
+    case GLUT_KEY_F4:
+        // Automático -> LOW -> MEDIUM -> HIGH -> ULTRA -> automático
+        if (QualityManager::isAutomatic())
+            QualityManager::setTier(QualityManager::LOW);
+        else if (QualityManager::tier() == QualityManager::ULTRA)
+            QualityManager::setAutomatic(true);
+        else
+            QualityManager::setTier(static_cast<QualityManager::Tier>(QualityManager::tier() + 1));
+        break;
+    case GLUT_KEY_F5:
+        TextureManager::report();
+        break;
     }
 }
 
@@ -1843,6 +2271,9 @@ void Game::handleJoystick(unsigned int btn, int x, int y, int z)
                     break;
                 case ACTION_BUTTON::RESET_ALL:
                     gameObjects.clear();
+                    ParticleSystem::clear();
+                    occlusion.invalidate();
+                    minimap.invalidate();
                     player.reset();
                     player.setPosition(0.0f, getTerrainHeight(0.0f, 0.0f) + 0.3f, 0.0f);
                     initObjects();
@@ -2342,6 +2773,9 @@ void Game::handleButtonMenuClick(int x, int y)
                 break;
             case ACTION_BUTTON::RESET_ALL:
                 gameObjects.clear();
+                ParticleSystem::clear();
+                occlusion.invalidate();
+                minimap.invalidate();
                 player.reset();
                 player.setPosition(0.0f, getTerrainHeight(0.0f, 0.0f) + 0.3f, 0.0f);
                 initObjects();
@@ -2545,7 +2979,18 @@ void Game::motionCallback(int x, int y) { GetInstance().handleMouseMotion(x, y);
 void Game::passiveMotionCallback(int x, int y) { GetInstance().handlePassiveMouseMotion(x, y); }
 void Game::displayCallback()
 {
+    TextRenderer::init();
+    // Uploads de assets que terminaram de carregar; fora da medida do QualityManager para
+    // o carregamento não derrubar a qualidade.
+    AssetLoader::pump();
+    QualityManager::beginWork();
+    QualityManager::beginGpu();
     GetInstance().render();
+    QualityManager::endWork();
+    QualityManager::endGpu();
+    QualityManager::endFrame();
+    if (GLState::isValidating())
+        GLState::validate("frame");
     glutSwapBuffers();
 }
 void Game::reshapeCallback(int w, int h) { glViewport(0, 0, w, h); }
@@ -2567,7 +3012,9 @@ void Game::JoystickCallback(unsigned int key, int x, int y, int z)
 
 void Game::timerCallback(int value)
 {
+    QualityManager::beginWork();
     GetInstance().update();
+    QualityManager::endWork();
     glutPostRedisplay();
     glutTimerFunc(16, timerCallback, 0);
 }
@@ -2586,18 +3033,12 @@ float Game::getTerrainHeight(float x, float z)
     height += std::cos(z * 0.1f) * 0.5f;
     height += (std::sin(x * 0.3f + z * 0.5f) * 0.3f);
 
-    std::vector<std::pair<float, float>> lakeCenters = {
-        {5.0f, 5.0f},
-        {-7.0f, -3.0f},
-        {8.0f, -6.0f},
-        {-4.0f, 7.0f}};
-
-    for (const auto &center : lakeCenters)
+    for (const auto &center : LAKE_CENTERS)
     {
-        float dist = std::sqrt((x - center.first) * (x - center.first) + (z - center.second) * (z - center.second));
-        if (dist < 3.5f)
+        float dist = std::sqrt((x - center[0]) * (x - center[0]) + (z - center[1]) * (z - center[1]));
+        if (dist < LAKE_RADIUS)
         {
-            height -= (3.5f - dist) * 0.4f;
+            height -= (LAKE_RADIUS - dist) * 0.4f;
         }
     }
 
@@ -6,6 +6,8 @@
 #include <cmath>
 #include <iostream>
 #include <GL/glut.h>
+#include "glState.hpp"
+#include "renderer.hpp"
 #include <windows.h>
 
 #include "data.hpp"
@@ -19,6 +21,16 @@
 #include "meshLoader.hpp"
 #include "AudioManager.hpp"
 #include "Boss.hpp"
+#include "entityRenderer.hpp"
+#include "healthBarPass.hpp"
+#include "particleSystem.hpp"
+#include "lightBaker.hpp"
+#include "occlusionCuller.hpp"
+#include "minimap.hpp"
+#include "qualityManager.hpp"
+#include "vertexPacking.hpp"
+#include "assetLoader.hpp"
+#include "textureManager.hpp"
 
 class Game
 {
@@ -58,10 +70,71 @@ private:
     static const int DUNGEON_HEIGHT = 10;
     bool dungeonGrid[DUNGEON_WIDTH][DUNGEON_HEIGHT];
 
+    // Oclusão por software no mapa principal: disparada no update, consultada no render.
+    // occlusionIds[i] é o índice do gameObjects[i] no culler (-1 = não testado).
+    OcclusionCuller occlusion;
+    std::vector<int> occlusionIds;
+    bool occlusionTerrainBuilt = false;
+
+    // Modo mapa: parte fixa capturada em textura quando o mapa carrega (na primeira vez que é aberto).
+    Minimap minimap;
+
     std::vector<TrailPoint> trailCurvePoints;
     std::vector<TrailPoint> trailClearings;
     std::vector<GrassPatch> grassPatches;
 
+    EntityRenderer entityRenderer;
+    HealthBarPass healthBars;
+
+    // Geometria do chão, refeita quando as trilhas mudam. Trilhas e clareiras são
+    // pintadas uma vez em uma textura de splat aplicada sobre a própria malha do terreno.
+    static const int GROUND_SPLAT_SIZE = 512;
+    std::vector<GpuVertex> terrainVertices;
+    std::vector<GpuVertex> decalVertices;
+    std::vector<unsigned int> terrainIndices;
+    GpuMesh terrainMesh;
+    GpuMesh decalMesh;
+    GLuint groundSplatTexture = 0;
+    bool groundMeshDirty = true;
+
+    // Luz assada do chão (pipeline fixo): oclusão por vértice e cor final do terreno e dos decalques.
+    std::vector<float> terrainOcclusion;
+    std::vector<GLubyte> terrainLighting;
+    std::vector<GLubyte> decalLighting;
+    MapType bakedLightingMap = MapType::MAIN;
+    unsigned int bakedLightingVersion = 0;
+
+    // Lagos: a malha (altura, cor e alfa pela profundidade) é montada uma vez;
+    // por frame só a onda é aplicada, sem amostrar o terreno nem chamar sin/cos.
+    struct Lake
+    {
+        float cx, cz;
+        float waterHeight; // superfície desenhada (borda mais baixa)
+        float floodHeight; // limite usado pelo isUnderWater (borda mais alta)
+    };
+
+    struct LakeVertex
+    {
+        GLfloat x, y, z;
+        GLubyte r, g, b, a;
+    };
+
+    // sin/cos da fase de cada onda guardados para somar com o tempo por identidade.
+    struct LakeWave
+    {
+        float baseY, baseGreen;
+        float sinA, cosA, ampA;
+        float sinB, cosB, ampB;
+    };
+
+    static const int LAKE_COUNT = 4;
+    static const float LAKE_RADIUS;
+    static const float LAKE_CENTERS[LAKE_COUNT][2];
+    std::vector<Lake> lakes;
+    std::vector<LakeVertex> lakeVertices;
+    std::vector<LakeWave> lakeWaves;
+    std::vector<GLushort> lakeIndices;
+
     std::vector<SkillNode> skillNodes;
     SkillTooltip skillTooltip;
 
@@ -95,8 +168,23 @@ public:
     void updateMoviment();
 
     void render();
+    void renderMapView();
+    void captureMinimap();
+    void drawInterface();
     void drawGround();
+    void drawGroundArrays(const GpuMesh &mesh, const std::vector<GpuVertex> &vertices, const std::vector<GLubyte> &colors);
+    void bakeGroundLighting(const BakeMaterial &ground);
     void drawLakes();
+    void buildLakes();
+    void buildGroundMeshes();
+    void bakeGroundSplat();
+    void buildOcclusionTerrain();
+    void launchOcclusion();
+    bool passesOcclusion(size_t index) const;
+    // Projeção * view da câmera do jogo, como o render aplica.
+    Mat4 cameraViewProjection() const;
+    // Far plane da câmera do jogo: distância de desenho do QualityManager mais o recuo da câmera.
+    float farPlane() const;
 
     void drawSkillTree();
     void calculateSkillTreeLayout();
@@ -0,0 +1,158 @@
+#include "glExt.hpp"
+#include <GL/freeglut_ext.h>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace GLExt
+{
+#define GL_EXT_DEFINE(type, name, symbol) type name = nullptr;
+    GL_EXT_FUNCTIONS_BUFFERS(GL_EXT_DEFINE)
+    GL_EXT_FUNCTIONS(GL_EXT_DEFINE)
+    GL_EXT_FUNCTIONS_3X(GL_EXT_DEFINE)
+    GL_EXT_FUNCTIONS_FBO(GL_EXT_DEFINE)
+    GL_EXT_FUNCTIONS_COMPRESSION(GL_EXT_DEFINE)
+    GL_EXT_FUNCTIONS_TIMER(GL_EXT_DEFINE)
+#undef GL_EXT_DEFINE
+
+    static bool shaders = false;
+    static bool vertexArrays = false;
+    static bool uniformBuffers = false;
+    static bool instancing = false;
+    static int buffers = -1;      // -1: ainda não carregado
+    static bool halfFloatVertex = false;
+    static int framebuffers = -1;
+    static int textureCompression = -1;
+    static int timerQuery = -1;
+    static int glVersion = 11;
+
+    bool load()
+    {
+        const char *versionString = reinterpret_cast<const char *>(glGetString(GL_VERSION));
+        int major = 1, minor = 1;
+        if (versionString)
+            std::sscanf(versionString, "%d.%d", &major, &minor);
+        glVersion = major * 10 + minor;
+
+        bool ok = true;
+#define GL_EXT_LOAD(type, name, symbol)                                              \
+    name = reinterpret_cast<type>(glutGetProcAddress(#symbol));                      \
+    if (!name)                                                                       \
+    {                                                                                \
+        std::cerr << "Função OpenGL não encontrada: " << #symbol << std::endl;       \
+        ok = false;                                                                  \
+    }
+        GL_EXT_FUNCTIONS(GL_EXT_LOAD)
+#undef GL_EXT_LOAD
+
+#define GL_EXT_LOAD_OPTIONAL(type, name, symbol) \
+    name = reinterpret_cast<type>(glutGetProcAddress(#symbol));
+        GL_EXT_FUNCTIONS_3X(GL_EXT_LOAD_OPTIONAL)
+#undef GL_EXT_LOAD_OPTIONAL
+
+        shaders = ok && loadBuffers() && glVersion >= 20;
+        vertexArrays = shaders && GenVertexArrays && DeleteVertexArrays && BindVertexArray;
+        uniformBuffers = shaders && glVersion >= 31 && GetUniformBlockIndex && UniformBlockBinding && BindBufferBase;
+        instancing = shaders && glVersion >= 33 && DrawElementsInstanced && VertexAttribDivisor;
+        loadFramebuffers();
+        return shaders;
+    }
+
+    bool loadBuffers()
+    {
+        if (buffers >= 0)
+            return buffers != 0;
+
+        const char *versionString = reinterpret_cast<const char *>(glGetString(GL_VERSION));
+        const char *extensions = reinterpret_cast<const char *>(glGetString(GL_EXTENSIONS));
+        int major = 1, minor = 1;
+        if (versionString)
+            std::sscanf(versionString, "%d.%d", &major, &minor);
+        bool ok = major * 10 + minor >= 15 || (extensions && std::strstr(extensions, "GL_ARB_vertex_buffer_object"));
+#define GL_EXT_LOAD_BUFFERS(type, name, symbol)                     \
+    name = reinterpret_cast<type>(glutGetProcAddress(#symbol));     \
+    ok = ok && name;
+        GL_EXT_FUNCTIONS_BUFFERS(GL_EXT_LOAD_BUFFERS)
+#undef GL_EXT_LOAD_BUFFERS
+        buffers = ok ? 1 : 0;
+        halfFloatVertex = ok && (major >= 3 || (extensions && std::strstr(extensions, "GL_ARB_half_float_vertex")));
+        return ok;
+    }
+
+    bool loadFramebuffers()
+    {
+        if (framebuffers >= 0)
+            return framebuffers != 0;
+
+        // No GLX o endereço vem mesmo sem suporte: confere versão ou extensão antes.
+        const char *versionString = reinterpret_cast<const char *>(glGetString(GL_VERSION));
+        const char *extensions = reinterpret_cast<const char *>(glGetString(GL_EXTENSIONS));
+        int major = 1;
+        if (versionString)
+            std::sscanf(versionString, "%d", &major);
+        bool ok = major >= 3 || (extensions && std::strstr(extensions, "GL_ARB_framebuffer_object"));
+#define GL_EXT_LOAD_FBO(type, name, symbol)                         \
+    name = reinterpret_cast<type>(glutGetProcAddress(#symbol));     \
+    ok = ok && name;
+        GL_EXT_FUNCTIONS_FBO(GL_EXT_LOAD_FBO)
+#undef GL_EXT_LOAD_FBO
+        framebuffers = ok ? 1 : 0;
+        return ok;
+    }
+
+    bool loadTextureCompression()
+    {
+        if (textureCompression >= 0)
+            return textureCompression != 0;
+
+        const char *versionString = reinterpret_cast<const char *>(glGetString(GL_VERSION));
+        const char *extensions = reinterpret_cast<const char *>(glGetString(GL_EXTENSIONS));
+        int major = 1, minor = 1;
+        if (versionString)
+            std::sscanf(versionString, "%d.%d", &major, &minor);
+        bool ok = (major * 10 + minor >= 13 || (extensions && std::strstr(extensions, "GL_ARB_texture_compression"))) &&
+                  extensions && std::strstr(extensions, "GL_EXT_texture_compression_s3tc");
+#define GL_EXT_LOAD_COMPRESSION(type, name, symbol)                 \
+    name = reinterpret_cast<type>(glutGetProcAddress(#symbol));     \
+    ok = ok && name;
+        GL_EXT_FUNCTIONS_COMPRESSION(GL_EXT_LOAD_COMPRESSION)
+#undef GL_EXT_LOAD_COMPRESSION
+        textureCompression = ok ? 1 : 0;
+        return ok;
+    }
+
+    bool loadTimerQuery()
+    {
+        if (timerQuery >= 0)
+            return timerQuery != 0;
+
+        const char *versionString = reinterpret_cast<const char *>(glGetString(GL_VERSION));
+        const char *extensions = reinterpret_cast<const char *>(glGetString(GL_EXTENSIONS));
+        int major = 1, minor = 1;
+        if (versionString)
+            std::sscanf(versionString, "%d.%d", &major, &minor);
+        bool ok = major * 10 + minor >= 33 ||
+                  (extensions && (std::strstr(extensions, "GL_ARB_timer_query") ||
+                                  std::strstr(extensions, "GL_EXT_timer_query")));
+        // As queries em si são do 1.5; o timer só acrescenta o alvo GL_TIME_ELAPSED.
+        ok = ok && major * 10 + minor >= 15;
+#define GL_EXT_LOAD_TIMER(type, name, symbol)                       \
+    name = reinterpret_cast<type>(glutGetProcAddress(#symbol));     \
+    ok = ok && name;
+        GL_EXT_FUNCTIONS_TIMER(GL_EXT_LOAD_TIMER)
+#undef GL_EXT_LOAD_TIMER
+        timerQuery = ok ? 1 : 0;
+        return ok;
+    }
+
+    bool hasShaders() { return shaders; }
+    bool hasVertexArrays() { return vertexArrays; }
+    bool hasUniformBuffers() { return uniformBuffers; }
+    bool hasInstancing() { return instancing; }
+    bool hasFramebuffers() { return framebuffers > 0; }
+    bool hasBuffers() { return buffers > 0; }
+    bool hasHalfFloatVertex() { return halfFloatVertex; }
+    bool hasTextureCompression() { return textureCompression > 0; }
+    bool hasTimerQuery() { return timerQuery > 0; }
+    int version() { return glVersion; }
+}
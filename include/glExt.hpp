@@ -0,0 +1,118 @@
+#ifndef GL_EXT_HPP
+#define GL_EXT_HPP
+
+#include <GL/glut.h>
+#include <GL/glext.h>
+
+// Funções do OpenGL acima do 1.1. No Windows o opengl32 só exporta o 1.1,
+// então tudo o que vem depois precisa ser buscado em tempo de execução.
+#define GL_EXT_FUNCTIONS(X)                                              \
+    X(PFNGLCREATESHADERPROC, CreateShader, glCreateShader)               \
+    X(PFNGLSHADERSOURCEPROC, ShaderSource, glShaderSource)               \
+    X(PFNGLCOMPILESHADERPROC, CompileShader, glCompileShader)            \
+    X(PFNGLGETSHADERIVPROC, GetShaderiv, glGetShaderiv)                  \
+    X(PFNGLGETSHADERINFOLOGPROC, GetShaderInfoLog, glGetShaderInfoLog)   \
+    X(PFNGLDELETESHADERPROC, DeleteShader, glDeleteShader)               \
+    X(PFNGLCREATEPROGRAMPROC, CreateProgram, glCreateProgram)            \
+    X(PFNGLATTACHSHADERPROC, AttachShader, glAttachShader)               \
+    X(PFNGLBINDATTRIBLOCATIONPROC, BindAttribLocation, glBindAttribLocation) \
+    X(PFNGLLINKPROGRAMPROC, LinkProgram, glLinkProgram)                  \
+    X(PFNGLGETPROGRAMIVPROC, GetProgramiv, glGetProgramiv)               \
+    X(PFNGLGETPROGRAMINFOLOGPROC, GetProgramInfoLog, glGetProgramInfoLog) \
+    X(PFNGLDELETEPROGRAMPROC, DeleteProgram, glDeleteProgram)            \
+    X(PFNGLUSEPROGRAMPROC, UseProgram, glUseProgram)                     \
+    X(PFNGLGETUNIFORMLOCATIONPROC, GetUniformLocation, glGetUniformLocation) \
+    X(PFNGLUNIFORM1IPROC, Uniform1i, glUniform1i)                        \
+    X(PFNGLUNIFORM1FPROC, Uniform1f, glUniform1f)                        \
+    X(PFNGLUNIFORM4FPROC, Uniform4f, glUniform4f)                        \
+    X(PFNGLUNIFORM4FVPROC, Uniform4fv, glUniform4fv)                     \
+    X(PFNGLUNIFORMMATRIX3FVPROC, UniformMatrix3fv, glUniformMatrix3fv)   \
+    X(PFNGLUNIFORMMATRIX4FVPROC, UniformMatrix4fv, glUniformMatrix4fv)   \
+    X(PFNGLENABLEVERTEXATTRIBARRAYPROC, EnableVertexAttribArray, glEnableVertexAttribArray) \
+    X(PFNGLDISABLEVERTEXATTRIBARRAYPROC, DisableVertexAttribArray, glDisableVertexAttribArray) \
+    X(PFNGLVERTEXATTRIBPOINTERPROC, VertexAttribPointer, glVertexAttribPointer) \
+    X(PFNGLACTIVETEXTUREPROC, ActiveTexture, glActiveTexture)
+
+// Buffers de vértice (1.5): usados pelos shaders e também pelo pipeline fixo.
+#define GL_EXT_FUNCTIONS_BUFFERS(X)                                      \
+    X(PFNGLGENBUFFERSPROC, GenBuffers, glGenBuffers)                     \
+    X(PFNGLDELETEBUFFERSPROC, DeleteBuffers, glDeleteBuffers)            \
+    X(PFNGLBINDBUFFERPROC, BindBuffer, glBindBuffer)                     \
+    X(PFNGLBUFFERDATAPROC, BufferData, glBufferData)                     \
+    X(PFNGLBUFFERSUBDATAPROC, BufferSubData, glBufferSubData)
+
+// Opcionais: só existem a partir do 3.x (ou com a extensão ARB equivalente).
+#define GL_EXT_FUNCTIONS_3X(X)                                           \
+    X(PFNGLGENVERTEXARRAYSPROC, GenVertexArrays, glGenVertexArrays)      \
+    X(PFNGLDELETEVERTEXARRAYSPROC, DeleteVertexArrays, glDeleteVertexArrays) \
+    X(PFNGLBINDVERTEXARRAYPROC, BindVertexArray, glBindVertexArray)      \
+    X(PFNGLGETUNIFORMBLOCKINDEXPROC, GetUniformBlockIndex, glGetUniformBlockIndex) \
+    X(PFNGLUNIFORMBLOCKBINDINGPROC, UniformBlockBinding, glUniformBlockBinding) \
+    X(PFNGLBINDBUFFERBASEPROC, BindBufferBase, glBindBufferBase)          \
+    X(PFNGLDRAWELEMENTSINSTANCEDPROC, DrawElementsInstanced, glDrawElementsInstanced) \
+    X(PFNGLVERTEXATTRIBDIVISORPROC, VertexAttribDivisor, glVertexAttribDivisor)
+
+// Render-to-texture (3.0 ou ARB_framebuffer_object), carregado à parte porque
+// não depende dos shaders: minimapa e escala de resolução usam mesmo no pipeline fixo.
+#define GL_EXT_FUNCTIONS_FBO(X)                                          \
+    X(PFNGLGENFRAMEBUFFERSPROC, GenFramebuffers, glGenFramebuffers)      \
+    X(PFNGLDELETEFRAMEBUFFERSPROC, DeleteFramebuffers, glDeleteFramebuffers) \
+    X(PFNGLBINDFRAMEBUFFERPROC, BindFramebuffer, glBindFramebuffer)      \
+    X(PFNGLFRAMEBUFFERTEXTURE2DPROC, FramebufferTexture2D, glFramebufferTexture2D) \
+    X(PFNGLCHECKFRAMEBUFFERSTATUSPROC, CheckFramebufferStatus, glCheckFramebufferStatus) \
+    X(PFNGLGENRENDERBUFFERSPROC, GenRenderbuffers, glGenRenderbuffers)   \
+    X(PFNGLDELETERENDERBUFFERSPROC, DeleteRenderbuffers, glDeleteRenderbuffers) \
+    X(PFNGLBINDRENDERBUFFERPROC, BindRenderbuffer, glBindRenderbuffer)   \
+    X(PFNGLRENDERBUFFERSTORAGEPROC, RenderbufferStorage, glRenderbufferStorage) \
+    X(PFNGLFRAMEBUFFERRENDERBUFFERPROC, FramebufferRenderbuffer, glFramebufferRenderbuffer)
+
+// Texturas comprimidas em bloco (1.3 + EXT_texture_compression_s3tc: BC1/BC3).
+#define GL_EXT_FUNCTIONS_COMPRESSION(X)                                  \
+    X(PFNGLCOMPRESSEDTEXIMAGE2DPROC, CompressedTexImage2D, glCompressedTexImage2D)
+
+// Tempo de GPU (3.3, ARB_timer_query ou EXT_timer_query): queries GL_TIME_ELAPSED.
+#define GL_EXT_FUNCTIONS_TIMER(X)                                        \
+    X(PFNGLGENQUERIESPROC, GenQueries, glGenQueries)                     \
+    X(PFNGLDELETEQUERIESPROC, DeleteQueries, glDeleteQueries)            \
+    X(PFNGLBEGINQUERYPROC, BeginQuery, glBeginQuery)                     \
+    X(PFNGLENDQUERYPROC, EndQuery, glEndQuery)                           \
+    X(PFNGLGETQUERYOBJECTUIVPROC, GetQueryObjectuiv, glGetQueryObjectuiv)
+
+namespace GLExt
+{
+#define GL_EXT_DECLARE(type, name, symbol) extern type name;
+    GL_EXT_FUNCTIONS_BUFFERS(GL_EXT_DECLARE)
+    GL_EXT_FUNCTIONS(GL_EXT_DECLARE)
+    GL_EXT_FUNCTIONS_3X(GL_EXT_DECLARE)
+    GL_EXT_FUNCTIONS_FBO(GL_EXT_DECLARE)
+    GL_EXT_FUNCTIONS_COMPRESSION(GL_EXT_DECLARE)
+    GL_EXT_FUNCTIONS_TIMER(GL_EXT_DECLARE)
+#undef GL_EXT_DECLARE
+
+    // Precisa de um contexto ativo (chamar depois do glutCreateWindow).
+    bool load();
+    // Só as funções de buffer de vértice; pode ser chamado sem o load().
+    bool loadBuffers();
+    // Só as funções de framebuffer; pode ser chamado sem o load().
+    bool loadFramebuffers();
+    // Só o upload de texturas S3TC; pode ser chamado sem o load().
+    bool loadTextureCompression();
+    // Só as queries de tempo; pode ser chamado sem o load().
+    bool loadTimerQuery();
+
+    bool hasShaders();
+    bool hasVertexArrays();
+    bool hasUniformBuffers();
+    bool hasInstancing();
+    bool hasFramebuffers();
+    bool hasBuffers();
+    // Atributos em half float (3.0 ou ARB_half_float_vertex); vem junto do loadBuffers().
+    bool hasHalfFloatVertex();
+    bool hasTextureCompression();
+    bool hasTimerQuery();
+
+    // Versão do contexto, ex.: 33 para 3.3.
+    int version();
+}
+
+#endif
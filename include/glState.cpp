@@ -0,0 +1,546 @@
+#include "glState.hpp"
+#include <GL/glu.h>
+#include <cstring>
+#include <cmath>
+#include <iostream>
+#include <algorithm>
+
+GLState::Snapshot GLState::current;
+std::vector<GLState::Snapshot> GLState::attribStack;
+std::vector<Mat4> GLState::modelviewStack(1, Mat4::identity());
+std::vector<Mat4> GLState::projectionStack(1, Mat4::identity());
+std::vector<Mat4> GLState::textureStack(1, Mat4::identity());
+GLenum GLState::currentMatrixMode = GL_MODELVIEW;
+bool GLState::validation = false;
+
+static const GLenum trackedCaps[] = {
+    GL_LIGHTING, GL_LIGHT0, GL_LIGHT1, GL_LIGHT2, GL_LIGHT3, GL_LIGHT4, GL_LIGHT5, GL_LIGHT6, GL_LIGHT7,
+    GL_TEXTURE_2D, GL_COLOR_MATERIAL, GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_NORMALIZE,
+    GL_ALPHA_TEST, GL_FOG, GL_POINT_SMOOTH, GL_LINE_SMOOTH, GL_POLYGON_OFFSET_FILL,
+    GL_TEXTURE_GEN_S, GL_TEXTURE_GEN_T, GL_SCISSOR_TEST, GL_STENCIL_TEST};
+
+static const GLenum materialParams[] = {GL_AMBIENT, GL_DIFFUSE, GL_SPECULAR, GL_EMISSION, GL_SHININESS};
+
+void GLState::init()
+{
+    // Parte dos valores padrão da especificação, assim nenhum glGet é necessário.
+    for (int i = 0; i < MAX_CAPS; ++i)
+        current.caps[i] = OFF;
+    current.texture = 0;
+    current.texEnv = GL_MODULATE;
+    current.blendSrc = GL_ONE;
+    current.blendDst = GL_ZERO;
+    current.lineWidth = 1.0f;
+    current.pointSize = 1.0f;
+    const GLfloat white[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    const GLfloat up[3] = {0.0f, 0.0f, 1.0f};
+    std::memcpy(current.color, white, sizeof(white));
+    std::memcpy(current.normal, up, sizeof(up));
+    current.texCoord[0] = current.texCoord[1] = 0.0f;
+    current.currentKnown = CURRENT_ALL;
+
+    const GLfloat defaults[MATERIAL_PARAMS][4] = {
+        {0.2f, 0.2f, 0.2f, 1.0f},
+        {0.8f, 0.8f, 0.8f, 1.0f},
+        {0.0f, 0.0f, 0.0f, 1.0f},
+        {0.0f, 0.0f, 0.0f, 1.0f},
+        {0.0f, 0.0f, 0.0f, 0.0f}};
+    std::memcpy(current.material, defaults, sizeof(defaults));
+    for (int i = 0; i < MATERIAL_PARAMS; ++i)
+        current.materialKnown[i] = true;
+
+    attribStack.clear();
+    modelviewStack.assign(1, Mat4::identity());
+    projectionStack.assign(1, Mat4::identity());
+    textureStack.assign(1, Mat4::identity());
+    currentMatrixMode = GL_MODELVIEW;
+}
+
+int GLState::capIndex(GLenum cap)
+{
+    for (int i = 0; i < MAX_CAPS; ++i)
+        if (trackedCaps[i] == cap)
+            return i;
+    return -1;
+}
+
+GLenum GLState::capFromIndex(int index) { return trackedCaps[index]; }
+
+int GLState::materialIndex(GLenum pname)
+{
+    for (int i = 0; i < MATERIAL_PARAMS; ++i)
+        if (materialParams[i] == pname)
+            return i;
+    return -1;
+}
+
+int GLState::materialSize(int index) { return materialParams[index] == GL_SHININESS ? 1 : 4; }
+
+void GLState::forgetColorMaterial()
+{
+    // Com GL_COLOR_MATERIAL ativo o glColor sobrescreve ambiente e difusa.
+    current.materialKnown[0] = false;
+    current.materialKnown[1] = false;
+}
+
+void GLState::enable(GLenum cap)
+{
+    int idx = capIndex(cap);
+    if (idx < 0)
+    {
+        glEnable(cap);
+        return;
+    }
+    if (current.caps[idx] == ON)
+        return;
+    glEnable(cap);
+    current.caps[idx] = ON;
+    if (cap == GL_COLOR_MATERIAL)
+        forgetColorMaterial();
+}
+
+void GLState::disable(GLenum cap)
+{
+    int idx = capIndex(cap);
+    if (idx < 0)
+    {
+        glDisable(cap);
+        return;
+    }
+    if (current.caps[idx] == OFF)
+        return;
+    glDisable(cap);
+    current.caps[idx] = OFF;
+}
+
+void GLState::setEnabled(GLenum cap, bool on)
+{
+    if (on)
+        enable(cap);
+    else
+        disable(cap);
+}
+
+bool GLState::isEnabled(GLenum cap)
+{
+    int idx = capIndex(cap);
+    if (idx < 0 || current.caps[idx] == UNKNOWN)
+    {
+        bool on = glIsEnabled(cap) == GL_TRUE;
+        if (idx >= 0)
+            current.caps[idx] = on ? ON : OFF;
+        return on;
+    }
+    return current.caps[idx] == ON;
+}
+
+void GLState::bindTexture(GLuint texture)
+{
+    if (current.texture == texture)
+        return;
+    glBindTexture(GL_TEXTURE_2D, texture);
+    current.texture = texture;
+}
+
+GLuint GLState::boundTexture() { return current.texture; }
+
+void GLState::texEnvMode(GLint mode)
+{
+    if (current.texEnv == mode)
+        return;
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, mode);
+    current.texEnv = mode;
+}
+
+void GLState::blendFunc(GLenum src, GLenum dst)
+{
+    if (current.blendSrc == src && current.blendDst == dst)
+        return;
+    glBlendFunc(src, dst);
+    current.blendSrc = src;
+    current.blendDst = dst;
+}
+
+void GLState::lineWidth(GLfloat width)
+{
+    if (current.lineWidth == width)
+        return;
+    glLineWidth(width);
+    current.lineWidth = width;
+}
+
+void GLState::pointSize(GLfloat size)
+{
+    if (current.pointSize == size)
+        return;
+    glPointSize(size);
+    current.pointSize = size;
+}
+
+void GLState::color(GLfloat r, GLfloat g, GLfloat b, GLfloat a)
+{
+    GLfloat *c = current.color;
+    if ((current.currentKnown & CURRENT_COLOR) && c[0] == r && c[1] == g && c[2] == b && c[3] == a)
+        return;
+    glColor4f(r, g, b, a);
+    c[0] = r;
+    c[1] = g;
+    c[2] = b;
+    c[3] = a;
+    current.currentKnown |= CURRENT_COLOR;
+}
+
+void GLState::color(const GLubyte rgba[4])
+{
+    // Mesma conversão do driver para a cor em unsigned byte.
+    color(rgba[0] / 255.0f, rgba[1] / 255.0f, rgba[2] / 255.0f, rgba[3] / 255.0f);
+}
+
+void GLState::normal(GLfloat x, GLfloat y, GLfloat z)
+{
+    GLfloat *n = current.normal;
+    if ((current.currentKnown & CURRENT_NORMAL) && n[0] == x && n[1] == y && n[2] == z)
+        return;
+    glNormal3f(x, y, z);
+    n[0] = x;
+    n[1] = y;
+    n[2] = z;
+    current.currentKnown |= CURRENT_NORMAL;
+}
+
+void GLState::texCoord(GLfloat s, GLfloat t)
+{
+    GLfloat *uv = current.texCoord;
+    if ((current.currentKnown & CURRENT_TEXCOORD) && uv[0] == s && uv[1] == t)
+        return;
+    glTexCoord2f(s, t);
+    uv[0] = s;
+    uv[1] = t;
+    current.currentKnown |= CURRENT_TEXCOORD;
+}
+
+void GLState::forgetCurrent(unsigned bits) { current.currentKnown &= ~bits; }
+
+void GLState::material(GLenum pname, const GLfloat *params)
+{
+    if (pname == GL_AMBIENT_AND_DIFFUSE)
+    {
+        material(GL_AMBIENT, params);
+        material(GL_DIFFUSE, params);
+        return;
+    }
+
+    int idx = materialIndex(pname);
+    if (idx < 0)
+    {
+        glMaterialfv(GL_FRONT, pname, params);
+        return;
+    }
+
+    int n = materialSize(idx);
+    bool colorTracked = idx < 2 && current.caps[capIndex(GL_COLOR_MATERIAL)] != OFF;
+    if (!colorTracked && current.materialKnown[idx] &&
+        std::memcmp(current.material[idx], params, n * sizeof(GLfloat)) == 0)
+        return;
+
+    glMaterialfv(GL_FRONT, pname, params);
+    std::memcpy(current.material[idx], params, n * sizeof(GLfloat));
+    current.materialKnown[idx] = !colorTracked;
+}
+
+void GLState::materialf(GLenum pname, GLfloat value)
+{
+    GLfloat v[4] = {value, 0.0f, 0.0f, 0.0f};
+    material(pname, v);
+}
+
+void GLState::getMaterial(GLenum pname, GLfloat *out)
+{
+    int idx = materialIndex(pname);
+    if (idx >= 0 && current.materialKnown[idx])
+    {
+        std::memcpy(out, current.material[idx], materialSize(idx) * sizeof(GLfloat));
+        return;
+    }
+
+    // Só acontece quando o glColor controlou o material desde a última troca.
+    glGetMaterialfv(GL_FRONT, pname, out);
+    if (idx >= 0 && current.caps[capIndex(GL_COLOR_MATERIAL)] == OFF)
+    {
+        std::memcpy(current.material[idx], out, materialSize(idx) * sizeof(GLfloat));
+        current.materialKnown[idx] = true;
+    }
+}
+
+std::vector<Mat4> &GLState::activeStack()
+{
+    if (currentMatrixMode == GL_PROJECTION)
+        return projectionStack;
+    if (currentMatrixMode == GL_TEXTURE)
+        return textureStack;
+    return modelviewStack;
+}
+
+void GLState::applyMatrix(const Mat4 &m)
+{
+    Mat4 &top = activeStack().back();
+    top = top * m;
+}
+
+void GLState::matrixMode(GLenum mode)
+{
+    if (currentMatrixMode == mode)
+        return;
+    glMatrixMode(mode);
+    currentMatrixMode = mode;
+}
+
+void GLState::pushMatrix()
+{
+    glPushMatrix();
+    std::vector<Mat4> &stack = activeStack();
+    stack.push_back(stack.back());
+}
+
+void GLState::popMatrix()
+{
+    glPopMatrix();
+    std::vector<Mat4> &stack = activeStack();
+    if (stack.size() > 1)
+        stack.pop_back();
+}
+
+void GLState::loadIdentity()
+{
+    glLoadIdentity();
+    activeStack().back() = Mat4::identity();
+}
+
+void GLState::loadMatrix(const GLfloat *m)
+{
+    glLoadMatrixf(m);
+    activeStack().back() = Mat4::fromArray(m);
+}
+
+void GLState::multMatrix(const GLfloat *m)
+{
+    glMultMatrixf(m);
+    applyMatrix(Mat4::fromArray(m));
+}
+
+void GLState::translate(GLfloat x, GLfloat y, GLfloat z)
+{
+    glTranslatef(x, y, z);
+    applyMatrix(Mat4::translation(x, y, z));
+}
+
+void GLState::rotate(GLfloat angle, GLfloat x, GLfloat y, GLfloat z)
+{
+    glRotatef(angle, x, y, z);
+    applyMatrix(Mat4::rotation(angle, x, y, z));
+}
+
+void GLState::scale(GLfloat x, GLfloat y, GLfloat z)
+{
+    glScalef(x, y, z);
+    applyMatrix(Mat4::scaling(x, y, z));
+}
+
+void GLState::ortho(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble zNear, GLdouble zFar)
+{
+    glOrtho(left, right, bottom, top, zNear, zFar);
+    applyMatrix(Mat4::ortho(left, right, bottom, top, zNear, zFar));
+}
+
+void GLState::ortho2D(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top)
+{
+    ortho(left, right, bottom, top, -1.0, 1.0);
+}
+
+void GLState::perspective(GLdouble fovy, GLdouble aspect, GLdouble zNear, GLdouble zFar)
+{
+    gluPerspective(fovy, aspect, zNear, zFar);
+    applyMatrix(Mat4::perspective(fovy, aspect, zNear, zFar));
+}
+
+void GLState::lookAt(GLdouble eyeX, GLdouble eyeY, GLdouble eyeZ,
+                     GLdouble centerX, GLdouble centerY, GLdouble centerZ,
+                     GLdouble upX, GLdouble upY, GLdouble upZ)
+{
+    gluLookAt(eyeX, eyeY, eyeZ, centerX, centerY, centerZ, upX, upY, upZ);
+    applyMatrix(Mat4::lookAt(eyeX, eyeY, eyeZ, centerX, centerY, centerZ, upX, upY, upZ));
+}
+
+const Mat4 &GLState::modelview()
+{
+    if (validation)
+        validate("modelview()");
+    return modelviewStack.back();
+}
+
+const Mat4 &GLState::projection() { return projectionStack.back(); }
+
+void GLState::pushAttrib() { attribStack.push_back(current); }
+
+void GLState::popAttrib()
+{
+    if (attribStack.empty())
+        return;
+    Snapshot saved = attribStack.back();
+    attribStack.pop_back();
+    restore(saved);
+}
+
+void GLState::restore(const Snapshot &saved)
+{
+    for (int i = 0; i < MAX_CAPS; ++i)
+    {
+        if (saved.caps[i] == ON)
+            enable(capFromIndex(i));
+        else if (saved.caps[i] == OFF)
+            disable(capFromIndex(i));
+    }
+
+    bindTexture(saved.texture);
+    texEnvMode(saved.texEnv);
+    blendFunc(saved.blendSrc, saved.blendDst);
+    lineWidth(saved.lineWidth);
+    pointSize(saved.pointSize);
+
+    // Valor indefinido no push continua indefinido: ninguém podia depender dele.
+    if (saved.currentKnown & CURRENT_COLOR)
+        color(saved.color[0], saved.color[1], saved.color[2], saved.color[3]);
+    if (saved.currentKnown & CURRENT_NORMAL)
+        normal(saved.normal[0], saved.normal[1], saved.normal[2]);
+    if (saved.currentKnown & CURRENT_TEXCOORD)
+        texCoord(saved.texCoord[0], saved.texCoord[1]);
+
+    for (int i = 0; i < MATERIAL_PARAMS; ++i)
+    {
+        if (saved.materialKnown[i])
+            material(materialParams[i], saved.material[i]);
+        else
+            current.materialKnown[i] = false;
+    }
+}
+
+void GLState::setValidation(bool on) { validation = on; }
+bool GLState::isValidating() { return validation; }
+
+static bool matrixMatches(const Mat4 &cached, GLenum query)
+{
+    GLfloat real[16];
+    glGetFloatv(query, real);
+    for (int i = 0; i < 16; ++i)
+    {
+        float tolerance = 1e-3f * std::max(1.0f, std::fabs(real[i]));
+        if (std::fabs(real[i] - cached.m[i]) > tolerance)
+            return false;
+    }
+    return true;
+}
+
+static bool closeTo(const GLfloat *real, const GLfloat *cached, int count, float tolerance)
+{
+    for (int i = 0; i < count; ++i)
+        if (std::fabs(real[i] - cached[i]) > tolerance)
+            return false;
+    return true;
+}
+
+bool GLState::validate(const char *where)
+{
+    bool ok = true;
+    auto report = [&](const char *what)
+    {
+        std::cerr << "[GLState] " << where << ": cache divergente em " << what << std::endl;
+        ok = false;
+    };
+
+    for (int i = 0; i < MAX_CAPS; ++i)
+    {
+        if (current.caps[i] == UNKNOWN)
+            continue;
+        bool real = glIsEnabled(capFromIndex(i)) == GL_TRUE;
+        if (real != (current.caps[i] == ON))
+        {
+            std::cerr << "[GLState] " << where << ": cap 0x" << std::hex << capFromIndex(i) << std::dec
+                      << " esperado " << (current.caps[i] == ON) << std::endl;
+            ok = false;
+        }
+    }
+
+    GLint value = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &value);
+    if (static_cast<GLuint>(value) != current.texture)
+        report("GL_TEXTURE_BINDING_2D");
+
+    glGetTexEnviv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, &value);
+    if (value != current.texEnv)
+        report("GL_TEXTURE_ENV_MODE");
+
+    GLint src = 0, dst = 0;
+    glGetIntegerv(GL_BLEND_SRC, &src);
+    glGetIntegerv(GL_BLEND_DST, &dst);
+    if (static_cast<GLenum>(src) != current.blendSrc || static_cast<GLenum>(dst) != current.blendDst)
+        report("glBlendFunc");
+
+    GLfloat width = 0.0f;
+    glGetFloatv(GL_LINE_WIDTH, &width);
+    if (width != current.lineWidth)
+        report("GL_LINE_WIDTH");
+
+    GLfloat size = 0.0f;
+    glGetFloatv(GL_POINT_SIZE, &size);
+    if (size != current.pointSize)
+        report("GL_POINT_SIZE");
+
+    GLfloat attribute[4];
+    if (current.currentKnown & CURRENT_COLOR)
+    {
+        glGetFloatv(GL_CURRENT_COLOR, attribute);
+        if (!closeTo(attribute, current.color, 4, 1e-3f))
+            report("GL_CURRENT_COLOR");
+    }
+    if (current.currentKnown & CURRENT_NORMAL)
+    {
+        glGetFloatv(GL_CURRENT_NORMAL, attribute);
+        if (!closeTo(attribute, current.normal, 3, 1e-4f))
+            report("GL_CURRENT_NORMAL");
+    }
+    if (current.currentKnown & CURRENT_TEXCOORD)
+    {
+        glGetFloatv(GL_CURRENT_TEXTURE_COORDS, attribute);
+        if (!closeTo(attribute, current.texCoord, 2, 1e-4f))
+            report("GL_CURRENT_TEXTURE_COORDS");
+    }
+
+    glGetIntegerv(GL_MATRIX_MODE, &value);
+    if (static_cast<GLenum>(value) != currentMatrixMode)
+        report("GL_MATRIX_MODE");
+
+    for (int i = 0; i < MATERIAL_PARAMS; ++i)
+    {
+        if (!current.materialKnown[i])
+            continue;
+        GLfloat real[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        glGetMaterialfv(GL_FRONT, materialParams[i], real);
+        for (int c = 0; c < materialSize(i); ++c)
+        {
+            if (std::fabs(real[c] - current.material[i][c]) > 1e-4f)
+            {
+                report("glMaterial");
+                break;
+            }
+        }
+    }
+
+    if (!matrixMatches(modelviewStack.back(), GL_MODELVIEW_MATRIX))
+        report("GL_MODELVIEW_MATRIX");
+    if (!matrixMatches(projectionStack.back(), GL_PROJECTION_MATRIX))
+        report("GL_PROJECTION_MATRIX");
+    if (!matrixMatches(textureStack.back(), GL_TEXTURE_MATRIX))
+        report("GL_TEXTURE_MATRIX");
+
+    return ok;
+}
@@ -0,0 +1,115 @@
+#ifndef GL_STATE_HPP
+#define GL_STATE_HPP
+
+#include <GL/glut.h>
+#include <vector>
+#include "matrix.hpp"
+
+// Cache do estado do OpenGL no lado da CPU.
+// Toda troca de estado passa por aqui: chamadas redundantes são descartadas e
+// consultas (matrizes, materiais, flags) são respondidas sem glGet*.
+// Com a validação ligada o cache é comparado com o estado real do driver.
+class GLState
+{
+public:
+    static void init();
+
+    static void enable(GLenum cap);
+    static void disable(GLenum cap);
+    static void setEnabled(GLenum cap, bool on);
+    static bool isEnabled(GLenum cap);
+
+    static void bindTexture(GLuint texture);
+    static GLuint boundTexture();
+    static void texEnvMode(GLint mode);
+    static void blendFunc(GLenum src, GLenum dst);
+    static void lineWidth(GLfloat width);
+    static void pointSize(GLfloat size);
+
+    // Cor, normal e coordenada de textura atuais (o antigo GL_CURRENT_BIT). Valem também
+    // entre glBegin/glEnd.
+    static void color(GLfloat r, GLfloat g, GLfloat b, GLfloat a = 1.0f);
+    static void color(const GLubyte rgba[4]);
+    static void normal(GLfloat x, GLfloat y, GLfloat z);
+    static void texCoord(GLfloat s, GLfloat t);
+
+    // Depois de um draw com vertex arrays o valor atual dos atributos que estavam em array
+    // fica indefinido; glut e glu emitem as próprias normais e uv. Quem desenha assim avisa
+    // o cache, que deixa de restaurar esses valores no popAttrib até o próximo color/normal/texCoord.
+    enum CurrentBits : unsigned { CURRENT_COLOR = 1, CURRENT_NORMAL = 2, CURRENT_TEXCOORD = 4, CURRENT_ALL = 7 };
+    static void forgetCurrent(unsigned bits);
+
+    static void material(GLenum pname, const GLfloat *params);
+    static void materialf(GLenum pname, GLfloat value);
+    static void getMaterial(GLenum pname, GLfloat *out);
+
+    static void matrixMode(GLenum mode);
+    static void pushMatrix();
+    static void popMatrix();
+    static void loadIdentity();
+    static void loadMatrix(const GLfloat *m);
+    static void multMatrix(const GLfloat *m);
+    static void translate(GLfloat x, GLfloat y, GLfloat z);
+    static void rotate(GLfloat angle, GLfloat x, GLfloat y, GLfloat z);
+    static void scale(GLfloat x, GLfloat y, GLfloat z);
+    static void ortho(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble zNear, GLdouble zFar);
+    static void ortho2D(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top);
+    static void perspective(GLdouble fovy, GLdouble aspect, GLdouble zNear, GLdouble zFar);
+    static void lookAt(GLdouble eyeX, GLdouble eyeY, GLdouble eyeZ,
+                       GLdouble centerX, GLdouble centerY, GLdouble centerZ,
+                       GLdouble upX, GLdouble upY, GLdouble upZ);
+
+    static const Mat4 &modelview();
+    static const Mat4 &projection();
+
+    // Substitui glPushAttrib/glPopAttrib: salva o estado em cache e, ao restaurar,
+    // reemite apenas o que mudou. Cor, normal e uv atuais entram no salvamento quando o
+    // cache os conhece (ver forgetCurrent).
+    static void pushAttrib();
+    static void popAttrib();
+
+    static void setValidation(bool on);
+    static bool isValidating();
+    static bool validate(const char *where);
+
+private:
+    static const int MAX_CAPS = 24;
+    static const int MATERIAL_PARAMS = 5;
+
+    enum Tri : unsigned char { UNKNOWN = 0, OFF = 1, ON = 2 };
+
+    struct Snapshot
+    {
+        Tri caps[MAX_CAPS];
+        GLuint texture;
+        GLint texEnv;
+        GLenum blendSrc, blendDst;
+        GLfloat lineWidth;
+        GLfloat pointSize;
+        GLfloat material[MATERIAL_PARAMS][4];
+        bool materialKnown[MATERIAL_PARAMS];
+        GLfloat color[4];
+        GLfloat normal[3];
+        GLfloat texCoord[2];
+        unsigned currentKnown; // CurrentBits
+    };
+
+    static Snapshot current;
+    static std::vector<Snapshot> attribStack;
+    static std::vector<Mat4> modelviewStack;
+    static std::vector<Mat4> projectionStack;
+    static std::vector<Mat4> textureStack;
+    static GLenum currentMatrixMode;
+    static bool validation;
+
+    static int capIndex(GLenum cap);
+    static GLenum capFromIndex(int index);
+    static int materialIndex(GLenum pname);
+    static int materialSize(int index);
+    static std::vector<Mat4> &activeStack();
+    static void applyMatrix(const Mat4 &m);
+    static void forgetColorMaterial();
+    static void restore(const Snapshot &saved);
+};
+
+#endif
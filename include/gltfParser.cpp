@@ -0,0 +1,762 @@
+#include "gltfParser.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+namespace
+{
+    // JSON mínimo para o cabeçalho do glTF (o grosso do arquivo é binário).
+    struct JsonValue
+    {
+        enum Type
+        {
+            NUL,
+            BOOLEAN,
+            NUMBER,
+            STRING,
+            ARRAY,
+            OBJECT
+        };
+
+        Type type = NUL;
+        bool boolean = false;
+        double number = 0.0;
+        std::string text;
+        std::vector<JsonValue> items;
+        std::vector<std::pair<std::string, JsonValue>> members;
+
+        const JsonValue &operator[](const char *key) const;
+        const JsonValue &at(size_t i) const;
+        size_t size() const { return type == ARRAY ? items.size() : 0; }
+        bool has(const char *key) const { return &(*this)[key] != &missing(); }
+        double numberOr(double fallback) const { return type == NUMBER ? number : fallback; }
+        // Índice para outro array do glTF; -1 se ausente ou inválido.
+        long indexOr(long fallback = -1) const
+        {
+            return type == NUMBER && number >= 0.0 ? static_cast<long>(number) : fallback;
+        }
+
+        static const JsonValue &missing()
+        {
+            static const JsonValue none;
+            return none;
+        }
+    };
+
+    const JsonValue &JsonValue::operator[](const char *key) const
+    {
+        if (type == OBJECT)
+            for (const auto &member : members)
+                if (member.first == key)
+                    return member.second;
+        return missing();
+    }
+
+    const JsonValue &JsonValue::at(size_t i) const
+    {
+        return type == ARRAY && i < items.size() ? items[i] : missing();
+    }
+
+    class JsonReader
+    {
+    public:
+        JsonReader(const char *begin, const char *end) : p(begin), end(end) {}
+
+        bool parse(JsonValue &out)
+        {
+            if (!value(out, 0))
+                return false;
+            skipBlanks();
+            return p == end || *p == '\0';
+        }
+
+    private:
+        static const int MAX_DEPTH = 64;
+        const char *p;
+        const char *end;
+
+        void skipBlanks()
+        {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+                ++p;
+        }
+
+        bool literal(const char *word)
+        {
+            size_t length = std::strlen(word);
+            if (static_cast<size_t>(end - p) < length || std::memcmp(p, word, length) != 0)
+                return false;
+            p += length;
+            return true;
+        }
+
+        static void appendUtf8(std::string &out, uint32_t code)
+        {
+            if (code < 0x80)
+                out += static_cast<char>(code);
+            else if (code < 0x800)
+            {
+                out += static_cast<char>(0xC0 | (code >> 6));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+            else
+            {
+                out += static_cast<char>(0xE0 | (code >> 12));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+        }
+
+        bool string(std::string &out)
+        {
+            ++p; // aspas
+            const char *start = p;
+            while (p < end && *p != '"' && *p != '\\')
+                ++p;
+            out.assign(start, p);
+            while (p < end && *p != '"')
+            {
+                if (*p != '\\')
+                {
+                    out += *p++;
+                    continue;
+                }
+                if (++p >= end)
+                    return false;
+                char c = *p++;
+                switch (c)
+                {
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u':
+                {
+                    uint32_t code = 0;
+                    if (end - p < 4 || std::from_chars(p, p + 4, code, 16).ptr != p + 4)
+                        return false;
+                    p += 4;
+                    appendUtf8(out, code);
+                    break;
+                }
+                default: out += c; break;
+                }
+            }
+            if (p >= end)
+                return false;
+            ++p;
+            return true;
+        }
+
+        bool value(JsonValue &out, int depth)
+        {
+            skipBlanks();
+            if (p >= end || depth > MAX_DEPTH)
+                return false;
+
+            switch (*p)
+            {
+            case '{':
+            {
+                out.type = JsonValue::OBJECT;
+                ++p;
+                skipBlanks();
+                if (p < end && *p == '}')
+                {
+                    ++p;
+                    return true;
+                }
+                while (true)
+                {
+                    skipBlanks();
+                    if (p >= end || *p != '"')
+                        return false;
+                    out.members.emplace_back();
+                    if (!string(out.members.back().first))
+                        return false;
+                    skipBlanks();
+                    if (p >= end || *p++ != ':')
+                        return false;
+                    if (!value(out.members.back().second, depth + 1))
+                        return false;
+                    skipBlanks();
+                    if (p < end && *p == ',')
+                    {
+                        ++p;
+                        continue;
+                    }
+                    if (p < end && *p == '}')
+                    {
+                        ++p;
+                        return true;
+                    }
+                    return false;
+                }
+            }
+            case '[':
+            {
+                out.type = JsonValue::ARRAY;
+                ++p;
+                skipBlanks();
+                if (p < end && *p == ']')
+                {
+                    ++p;
+                    return true;
+                }
+                while (true)
+                {
+                    out.items.emplace_back();
+                    if (!value(out.items.back(), depth + 1))
+                        return false;
+                    skipBlanks();
+                    if (p < end && *p == ',')
+                    {
+                        ++p;
+                        continue;
+                    }
+                    if (p < end && *p == ']')
+                    {
+                        ++p;
+                        return true;
+                    }
+                    return false;
+                }
+            }
+            case '"':
+                out.type = JsonValue::STRING;
+                return string(out.text);
+            case 't':
+                out.type = JsonValue::BOOLEAN;
+                out.boolean = true;
+                return literal("true");
+            case 'f':
+                out.type = JsonValue::BOOLEAN;
+                return literal("false");
+            case 'n':
+                return literal("null");
+            default:
+            {
+                out.type = JsonValue::NUMBER;
+                std::from_chars_result result = std::from_chars(p, end, out.number);
+                if (result.ec != std::errc())
+                    return false;
+                p = result.ptr;
+                return true;
+            }
+            }
+        }
+    };
+
+    struct BufferRange
+    {
+        const char *data;
+        size_t size;
+    };
+
+    // Accessor resolvido para bytes: elemento i começa em data + i * stride.
+    struct AccessorView
+    {
+        const char *data;
+        size_t count;
+        size_t stride;
+        int componentType;
+        int components;
+    };
+
+    enum ComponentType
+    {
+        UNSIGNED_BYTE = 5121,
+        UNSIGNED_SHORT = 5123,
+        UNSIGNED_INT = 5125,
+        FLOAT = 5126
+    };
+
+    size_t componentSize(int componentType)
+    {
+        switch (componentType)
+        {
+        case 5120:
+        case 5121: return 1;
+        case 5122:
+        case 5123: return 2;
+        case 5125:
+        case 5126: return 4;
+        default: return 0;
+        }
+    }
+
+    int componentCount(const std::string &type)
+    {
+        if (type == "SCALAR") return 1;
+        if (type == "VEC2") return 2;
+        if (type == "VEC3") return 3;
+        if (type == "VEC4") return 4;
+        if (type == "MAT4") return 16;
+        return 0;
+    }
+
+    // Sem bufferView (accessor zerado) e sparse ficam de fora.
+    bool resolveAccessor(const JsonValue &root, long index, const std::vector<BufferRange> &buffers,
+                         AccessorView &out)
+    {
+        const JsonValue &accessor = root["accessors"].at(static_cast<size_t>(std::max(index, 0L)));
+        if (index < 0 || accessor.type != JsonValue::OBJECT || accessor.has("sparse"))
+            return false;
+        long viewIndex = accessor["bufferView"].indexOr();
+        const JsonValue &view = root["bufferViews"].at(static_cast<size_t>(std::max(viewIndex, 0L)));
+        long buffer = view["buffer"].indexOr();
+        if (viewIndex < 0 || buffer < 0 || static_cast<size_t>(buffer) >= buffers.size())
+            return false;
+
+        out.componentType = static_cast<int>(accessor["componentType"].numberOr(0));
+        out.components = componentCount(accessor["type"].text);
+        out.count = static_cast<size_t>(accessor["count"].numberOr(0));
+        size_t elementSize = componentSize(out.componentType) * out.components;
+        if (elementSize == 0)
+            return false;
+        out.stride = static_cast<size_t>(view["byteStride"].numberOr(0));
+        if (out.stride == 0)
+            out.stride = elementSize;
+
+        size_t viewOffset = static_cast<size_t>(view["byteOffset"].numberOr(0));
+        size_t viewLength = static_cast<size_t>(view["byteLength"].numberOr(0));
+        size_t offset = static_cast<size_t>(accessor["byteOffset"].numberOr(0));
+        const BufferRange &range = buffers[buffer];
+        if (viewOffset > range.size || viewLength > range.size - viewOffset)
+            return false;
+        if (out.count > 0 && (offset > viewLength || (out.count - 1) * out.stride + elementSize > viewLength - offset))
+            return false;
+        out.data = range.data + viewOffset + offset;
+        return true;
+    }
+
+    inline void readFloats(const AccessorView &view, size_t i, float *out, int n)
+    {
+        std::memcpy(out, view.data + i * view.stride, n * sizeof(float));
+    }
+
+    Mat4 nodeTransform(const JsonValue &node)
+    {
+        const JsonValue &matrix = node["matrix"];
+        if (matrix.size() == 16)
+        {
+            Mat4 r;
+            for (int i = 0; i < 16; ++i)
+                r.m[i] = static_cast<float>(matrix.at(i).numberOr(0));
+            return r;
+        }
+
+        const JsonValue &t = node["translation"];
+        const JsonValue &q = node["rotation"];
+        const JsonValue &s = node["scale"];
+        Mat4 translation = Mat4::translation(static_cast<float>(t.at(0).numberOr(0)),
+                                             static_cast<float>(t.at(1).numberOr(0)),
+                                             static_cast<float>(t.at(2).numberOr(0)));
+        Mat4 scale = Mat4::scaling(static_cast<float>(s.at(0).numberOr(1)), static_cast<float>(s.at(1).numberOr(1)),
+                                   static_cast<float>(s.at(2).numberOr(1)));
+
+        // Quaternion (x, y, z, w) para matriz de rotação, em coluna.
+        float x = static_cast<float>(q.at(0).numberOr(0)), y = static_cast<float>(q.at(1).numberOr(0));
+        float z = static_cast<float>(q.at(2).numberOr(0)), w = static_cast<float>(q.at(3).numberOr(1));
+        Mat4 rotation = Mat4::identity();
+        rotation.m[0] = 1.0f - 2.0f * (y * y + z * z);
+        rotation.m[1] = 2.0f * (x * y + z * w);
+        rotation.m[2] = 2.0f * (x * z - y * w);
+        rotation.m[4] = 2.0f * (x * y - z * w);
+        rotation.m[5] = 1.0f - 2.0f * (x * x + z * z);
+        rotation.m[6] = 2.0f * (y * z + x * w);
+        rotation.m[8] = 2.0f * (x * z + y * w);
+        rotation.m[9] = 2.0f * (y * z - x * w);
+        rotation.m[10] = 1.0f - 2.0f * (x * x + y * y);
+        return translation * rotation * scale;
+    }
+
+    // PBR metal/rugosidade aproximado para Phong: a cor base vira difusa (metade para metal,
+    // que sem reflexo do ambiente ficaria preto) e um pouco de ambiente; o especular vai de
+    // 0.04 (dielétrico) à cor base (metal) e some com a rugosidade, e o expoente sai do alfa
+    // do GGX (n = 2/alfa^2 - 2).
+    Material convertMaterial(const JsonValue &material)
+    {
+        const JsonValue &pbr = material["pbrMetallicRoughness"];
+        const JsonValue &base = pbr["baseColorFactor"];
+        float color[3];
+        for (int c = 0; c < 3; ++c)
+            color[c] = static_cast<float>(base.at(c).numberOr(1));
+        float metallic = static_cast<float>(pbr["metallicFactor"].numberOr(1));
+        float roughness = std::max(0.05f, static_cast<float>(pbr["roughnessFactor"].numberOr(1)));
+
+        float specular[3];
+        for (int c = 0; c < 3; ++c)
+            specular[c] = (0.04f + (color[c] - 0.04f) * metallic) * (1.0f - roughness);
+        float alpha = roughness * roughness;
+
+        float diffuse = 1.0f - 0.5f * metallic;
+
+        Material out;
+        out.ambient = {color[0] * 0.2f, color[1] * 0.2f, color[2] * 0.2f};
+        out.diffuse = {color[0] * diffuse, color[1] * diffuse, color[2] * diffuse};
+        out.specular = {specular[0], specular[1], specular[2]};
+        out.shininess = std::min(128.0f, std::max(1.0f, 2.0f / (alpha * alpha) - 2.0f));
+        return out;
+    }
+
+    bool decodeBase64(const char *p, const char *end, std::vector<char> &out)
+    {
+        auto digit = [](char c) -> int {
+            if (c >= 'A' && c <= 'Z') return c - 'A';
+            if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+            if (c >= '0' && c <= '9') return c - '0' + 52;
+            if (c == '+') return 62;
+            if (c == '/') return 63;
+            return -1;
+        };
+        out.clear();
+        out.reserve((end - p) / 4 * 3);
+        uint32_t bits = 0;
+        int count = 0;
+        for (; p < end && *p != '='; ++p)
+        {
+            int value = digit(*p);
+            if (value < 0)
+                return false;
+            bits = (bits << 6) | static_cast<uint32_t>(value);
+            if (++count == 4)
+            {
+                out.push_back(static_cast<char>(bits >> 16));
+                out.push_back(static_cast<char>(bits >> 8));
+                out.push_back(static_cast<char>(bits));
+                bits = 0;
+                count = 0;
+            }
+        }
+        if (count == 2)
+            out.push_back(static_cast<char>(bits >> 4));
+        else if (count == 3)
+        {
+            out.push_back(static_cast<char>(bits >> 10));
+            out.push_back(static_cast<char>(bits >> 2));
+        }
+        return count != 1;
+    }
+
+    // Monta uma primitiva de triângulos; false se faltar POSITION ou algo estiver fora do buffer.
+    bool buildPrimitive(const JsonValue &root, const JsonValue &primitive, const std::vector<BufferRange> &buffers,
+                        GltfPrimitive &out, bool &zeroCopy, const std::string &label)
+    {
+        const JsonValue &attributes = primitive["attributes"];
+        AccessorView position, normal, texCoord;
+        if (!resolveAccessor(root, attributes["POSITION"].indexOr(), buffers, position) ||
+            position.componentType != FLOAT || position.components != 3)
+            return false;
+        bool hasNormal = resolveAccessor(root, attributes["NORMAL"].indexOr(), buffers, normal) &&
+                         normal.componentType == FLOAT && normal.components == 3 && normal.count == position.count;
+        bool hasTexCoord = resolveAccessor(root, attributes["TEXCOORD_0"].indexOr(), buffers, texCoord) &&
+                           texCoord.componentType == FLOAT && texCoord.components == 2 &&
+                           texCoord.count == position.count;
+        size_t vertexCount = position.count;
+
+        // Já intercalado como o GpuVertex: aponta para o buffer, sem cópia.
+        const GpuVertex *vertices = nullptr;
+        if (hasNormal && hasTexCoord && position.stride == sizeof(GpuVertex) && normal.stride == sizeof(GpuVertex) &&
+            texCoord.stride == sizeof(GpuVertex) && normal.data == position.data + offsetof(GpuVertex, nx) &&
+            texCoord.data == position.data + offsetof(GpuVertex, u) &&
+            reinterpret_cast<uintptr_t>(position.data) % alignof(GpuVertex) == 0)
+        {
+            vertices = reinterpret_cast<const GpuVertex *>(position.data);
+        }
+        else
+        {
+            out.vertexStorage.assign(vertexCount, GpuVertex());
+            for (size_t i = 0; i < vertexCount; ++i)
+            {
+                GpuVertex &v = out.vertexStorage[i];
+                readFloats(position, i, &v.px, 3);
+                if (hasNormal)
+                    readFloats(normal, i, &v.nx, 3);
+                if (hasTexCoord)
+                    readFloats(texCoord, i, &v.u, 2);
+            }
+            vertices = out.vertexStorage.data();
+        }
+
+        const void *indices = nullptr;
+        size_t indexCount = 0;
+        GLenum indexType = GL_UNSIGNED_SHORT;
+        AccessorView indexView;
+        if (primitive.has("indices"))
+        {
+            if (!resolveAccessor(root, primitive["indices"].indexOr(), buffers, indexView) || indexView.components != 1)
+                return false;
+            indexCount = indexView.count / 3 * 3;
+            size_t size = componentSize(indexView.componentType);
+            bool aligned = reinterpret_cast<uintptr_t>(indexView.data) % size == 0 && indexView.stride == size;
+            if (indexView.componentType == UNSIGNED_SHORT && aligned)
+                indices = indexView.data;
+            else if (indexView.componentType == UNSIGNED_INT && aligned)
+            {
+                indices = indexView.data;
+                indexType = GL_UNSIGNED_INT;
+            }
+            else if (indexView.componentType == UNSIGNED_BYTE)
+            {
+                out.indexStorage16.resize(indexCount);
+                for (size_t i = 0; i < indexCount; ++i)
+                    out.indexStorage16[i] = static_cast<unsigned char>(indexView.data[i * indexView.stride]);
+                indices = out.indexStorage16.data();
+            }
+            else
+                return false;
+        }
+        else
+        {
+            // Sem índices: cada três vértices formam um triângulo.
+            indexCount = vertexCount / 3 * 3;
+            if (vertexCount <= 0xFFFF)
+            {
+                out.indexStorage16.resize(indexCount);
+                for (size_t i = 0; i < indexCount; ++i)
+                    out.indexStorage16[i] = static_cast<GLushort>(i);
+                indices = out.indexStorage16.data();
+            }
+            else
+            {
+                out.indexStorage32.resize(indexCount);
+                for (size_t i = 0; i < indexCount; ++i)
+                    out.indexStorage32[i] = static_cast<unsigned int>(i);
+                indices = out.indexStorage32.data();
+                indexType = GL_UNSIGNED_INT;
+            }
+        }
+
+        auto indexAt = [&](size_t i) -> size_t {
+            return indexType == GL_UNSIGNED_SHORT ? static_cast<const GLushort *>(indices)[i]
+                                                  : static_cast<const unsigned int *>(indices)[i];
+        };
+        for (size_t i = 0; i < indexCount; ++i)
+            if (indexAt(i) >= vertexCount)
+                return false;
+
+        // Sem NORMAL: média das normais das faces em cada vértice.
+        if (!hasNormal)
+        {
+            for (size_t i = 0; i < indexCount; i += 3)
+            {
+                GpuVertex *v[3] = {&out.vertexStorage[indexAt(i)], &out.vertexStorage[indexAt(i + 1)],
+                                   &out.vertexStorage[indexAt(i + 2)]};
+                float ex = v[1]->px - v[0]->px, ey = v[1]->py - v[0]->py, ez = v[1]->pz - v[0]->pz;
+                float fx = v[2]->px - v[0]->px, fy = v[2]->py - v[0]->py, fz = v[2]->pz - v[0]->pz;
+                float face[3] = {ey * fz - ez * fy, ez * fx - ex * fz, ex * fy - ey * fx};
+                for (GpuVertex *corner : v)
+                {
+                    corner->nx += face[0];
+                    corner->ny += face[1];
+                    corner->nz += face[2];
+                }
+            }
+            for (GpuVertex &v : out.vertexStorage)
+            {
+                float length = std::sqrt(v.nx * v.nx + v.ny * v.ny + v.nz * v.nz);
+                if (length > 0.0f)
+                {
+                    v.nx /= length;
+                    v.ny /= length;
+                    v.nz /= length;
+                }
+            }
+        }
+
+        zeroCopy = out.vertexStorage.empty();
+        out.geometry.useExternal(vertices, vertexCount, indices, indexCount, indexType, label.c_str());
+        return true;
+    }
+}
+
+bool GltfParser::load(const char *path, GltfModel &out)
+{
+    out = GltfModel();
+    MappedFile source;
+    if (!source.open(path))
+    {
+        std::cerr << "Erro ao abrir o arquivo: " << path << std::endl;
+        return false;
+    }
+
+    // GLB: header de 12 bytes, chunk JSON e (opcional) chunk BIN, todos alinhados em 4.
+    const char *json = source.data();
+    const char *jsonEnd = source.data() + source.size();
+    BufferRange glbBinary = {nullptr, 0};
+    uint32_t header[3] = {0, 0, 0};
+    if (source.size() >= sizeof(header))
+        std::memcpy(header, source.data(), sizeof(header));
+    if (header[0] == GLB_MAGIC)
+    {
+        if (header[1] != 2 || header[2] > source.size())
+        {
+            std::cerr << "GLB inválido ou de versão não suportada: " << path << std::endl;
+            return false;
+        }
+        size_t offset = sizeof(header);
+        while (offset + 8 <= header[2])
+        {
+            uint32_t chunk[2];
+            std::memcpy(chunk, source.data() + offset, sizeof(chunk));
+            offset += sizeof(chunk);
+            if (chunk[0] > header[2] - offset)
+                break;
+            if (chunk[1] == GLB_CHUNK_JSON)
+            {
+                json = source.data() + offset;
+                jsonEnd = json + chunk[0];
+            }
+            else if (chunk[1] == GLB_CHUNK_BIN && !glbBinary.data)
+                glbBinary = {source.data() + offset, chunk[0]};
+            offset += (chunk[0] + 3) & ~3u;
+        }
+    }
+
+    JsonValue root;
+    if (!JsonReader(json, jsonEnd).parse(root) || root.type != JsonValue::OBJECT)
+    {
+        std::cerr << "JSON do glTF inválido: " << path << std::endl;
+        return false;
+    }
+
+    std::string directory(path);
+    size_t slash = directory.find_last_of("/\\");
+    directory = slash == std::string::npos ? std::string() : directory.substr(0, slash + 1);
+
+    std::vector<BufferRange> buffers;
+    const JsonValue &bufferList = root["buffers"];
+    for (size_t i = 0; i < bufferList.size(); ++i)
+    {
+        const JsonValue &uri = bufferList.at(i)["uri"];
+        size_t length = static_cast<size_t>(bufferList.at(i)["byteLength"].numberOr(0));
+        BufferRange range = {nullptr, 0};
+        if (uri.type != JsonValue::STRING)
+            range = i == 0 ? glbBinary : range;
+        else if (uri.text.compare(0, 5, "data:") == 0)
+        {
+            size_t comma = uri.text.find(',');
+            out.decodedBuffers.emplace_back();
+            if (comma != std::string::npos &&
+                decodeBase64(uri.text.data() + comma + 1, uri.text.data() + uri.text.size(), out.decodedBuffers.back()))
+                range = {out.decodedBuffers.back().data(), out.decodedBuffers.back().size()};
+        }
+        else
+        {
+            MappedFile file;
+            if (file.open((directory + uri.text).c_str()))
+            {
+                range = {file.data(), file.size()};
+                out.files.push_back(std::move(file));
+            }
+        }
+        if (!range.data || range.size < length)
+        {
+            std::cerr << "Buffer " << i << " do glTF ausente ou curto: " << path << std::endl;
+            return false;
+        }
+        buffers.push_back({range.data, length});
+    }
+    out.files.push_back(std::move(source));
+
+    // Cada mesh vira suas primitivas uma vez só, mesmo usado por vários nós.
+    const JsonValue &meshes = root["meshes"];
+    const JsonValue &materials = root["materials"];
+    std::vector<std::vector<size_t>> meshPrimitives(meshes.size());
+    std::vector<bool> meshBuilt(meshes.size(), false);
+    size_t zeroCopyCount = 0;
+    auto primitivesOf = [&](size_t mesh) -> const std::vector<size_t> & {
+        if (meshBuilt[mesh])
+            return meshPrimitives[mesh];
+        meshBuilt[mesh] = true;
+        const JsonValue &list = meshes.at(mesh)["primitives"];
+        for (size_t p = 0; p < list.size(); ++p)
+        {
+            if (list.at(p)["mode"].numberOr(4) != 4)
+            {
+                std::cerr << "Primitiva " << mesh << "." << p << " não é de triângulos, ignorada: " << path
+                          << std::endl;
+                continue;
+            }
+            GltfPrimitive primitive;
+            bool zeroCopy = false;
+            std::string label = std::string(path) + "#" + std::to_string(mesh) + "." + std::to_string(p);
+            if (!buildPrimitive(root, list.at(p), buffers, primitive, zeroCopy, label))
+            {
+                std::cerr << "Primitiva " << mesh << "." << p << " inválida ou sem suporte: " << path << std::endl;
+                continue;
+            }
+            long material = list.at(p)["material"].indexOr();
+            if (material >= 0 && static_cast<size_t>(material) < materials.size())
+            {
+                primitive.material = convertMaterial(materials.at(material));
+                primitive.hasMaterial = true;
+            }
+            zeroCopyCount += zeroCopy;
+            meshPrimitives[mesh].push_back(out.primitives.size());
+            out.primitives.push_back(std::move(primitive));
+        }
+        return meshPrimitives[mesh];
+    };
+
+    // Percorre a cena padrão (ou os nós sem pai) acumulando as transformações.
+    const JsonValue &nodes = root["nodes"];
+    std::vector<long> roots;
+    const JsonValue &scene = root["scenes"].at(static_cast<size_t>(root["scene"].indexOr(0)));
+    if (scene.has("nodes"))
+        for (const JsonValue &node : scene["nodes"].items)
+            roots.push_back(node.indexOr());
+    else
+    {
+        std::vector<bool> isChild(nodes.size(), false);
+        for (const JsonValue &node : nodes.items)
+            for (const JsonValue &child : node["children"].items)
+                if (child.indexOr() >= 0 && static_cast<size_t>(child.indexOr()) < nodes.size())
+                    isChild[child.indexOr()] = true;
+        for (size_t i = 0; i < nodes.size(); ++i)
+            if (!isChild[i])
+                roots.push_back(static_cast<long>(i));
+    }
+
+    // Pilha em ordem reversa para visitar os nós na ordem do arquivo.
+    std::vector<std::pair<long, Mat4>> stack;
+    for (auto node = roots.rbegin(); node != roots.rend(); ++node)
+        stack.push_back({*node, Mat4::identity()});
+    size_t visited = 0;
+    while (!stack.empty() && visited <= nodes.size() * 4)
+    {
+        std::pair<long, Mat4> item = stack.back();
+        stack.pop_back();
+        if (item.first < 0 || static_cast<size_t>(item.first) >= nodes.size())
+            continue;
+        ++visited;
+        const JsonValue &node = nodes.at(item.first);
+        Mat4 world = item.second * nodeTransform(node);
+        long mesh = node["mesh"].indexOr();
+        if (mesh >= 0 && static_cast<size_t>(mesh) < meshes.size())
+            for (size_t primitive : primitivesOf(mesh))
+                out.instances.push_back({primitive, world});
+        const std::vector<JsonValue> &children = node["children"].items;
+        for (auto child = children.rbegin(); child != children.rend(); ++child)
+            stack.push_back({child->indexOr(), world});
+    }
+    // Arquivo só com meshes, sem nós: desenha cada um na origem.
+    if (nodes.size() == 0)
+        for (size_t mesh = 0; mesh < meshes.size(); ++mesh)
+            for (size_t primitive : primitivesOf(mesh))
+                out.instances.push_back({primitive, Mat4::identity()});
+
+    if (out.instances.empty())
+    {
+        std::cerr << "Nenhuma malha desenhável no glTF: " << path << std::endl;
+        return false;
+    }
+    std::cout << "glTF " << path << ": " << out.primitives.size() << " primitivas (" << zeroCopyCount
+              << " sem cópia dos vértices), " << out.instances.size() << " instâncias" << std::endl;
+    return true;
+}
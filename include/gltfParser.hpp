@@ -0,0 +1,61 @@
+#ifndef GLTF_PARSER_HPP
+#define GLTF_PARSER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "data.hpp"
+#include "gpuMesh.hpp"
+#include "mappedFile.hpp"
+#include "matrix.hpp"
+#include "meshGeometry.hpp"
+
+// Uma primitiva (triângulos) de um mesh do glTF, com o material dela.
+// A geometria aponta direto para o buffer mapeado quando o layout já é o do GpuVertex
+// (posição/normal/uv intercalados em 32 bytes) e os índices são de 16/32 bits; senão
+// os dados são montados nos vetores de storage.
+struct GltfPrimitive
+{
+    MeshGeometry geometry;
+    GpuMesh gpu;
+    std::vector<GpuVertex> vertexStorage;
+    std::vector<GLushort> indexStorage16;
+    std::vector<unsigned int> indexStorage32;
+    Material material = Material();
+    bool hasMaterial = false;
+};
+
+// Primitiva desenhada por um nó da cena, com a transformação acumulada dos pais.
+struct GltfInstance
+{
+    size_t primitive;
+    Mat4 transform;
+};
+
+// Modelo glTF/GLB carregado. Os arquivos ficam mapeados enquanto o modelo existir,
+// porque as geometrias podem apontar para eles.
+struct GltfModel
+{
+    std::vector<MappedFile> files;
+    std::vector<std::vector<char>> decodedBuffers; // buffers em data: URI (base64)
+    std::vector<GltfPrimitive> primitives;
+    std::vector<GltfInstance> instances;
+};
+
+// Leitor de glTF 2.0: .glb (JSON + BIN num arquivo só) ou .gltf com .bin externo ou
+// buffer embutido. Só o JSON é texto; vértices e índices saem dos buffers binários.
+// Lê POSITION, NORMAL e TEXCOORD_0 em float, índices de 8/16/32 bits, materiais
+// pbrMetallicRoughness (fatores, aproximados para o material do pipeline fixo) e a
+// hierarquia de nós da cena padrão (matrix ou TRS).
+class GltfParser
+{
+public:
+    static bool load(const char *path, GltfModel &out);
+
+private:
+    static const uint32_t GLB_MAGIC = 0x46546C67;      // "glTF"
+    static const uint32_t GLB_CHUNK_JSON = 0x4E4F534A; // "JSON"
+    static const uint32_t GLB_CHUNK_BIN = 0x004E4942;  // "BIN\0"
+};
+
+#endif
@@ -0,0 +1,421 @@
+#include "gpuMesh.hpp"
+#include "glState.hpp"
+#include "vertexPacking.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+GpuMesh::GpuMesh()
+    : vao(0), vbo(0), ibo(0), indexCount(0), rangeFirst(0), rangeCount(0), indexType(GL_UNSIGNED_INT),
+      primitive(GL_TRIANGLES), packed(false), decode{0.0f, 0.0f, 0.0f, 1.0f}
+{
+}
+
+GpuMesh::~GpuMesh() { release(); }
+
+GpuMesh::GpuMesh(GpuMesh &&other) noexcept
+    : vao(other.vao), vbo(other.vbo), ibo(other.ibo), indexCount(other.indexCount), rangeFirst(other.rangeFirst),
+      rangeCount(other.rangeCount), indexType(other.indexType), primitive(other.primitive), packed(other.packed),
+      decode{other.decode[0], other.decode[1], other.decode[2], other.decode[3]}
+{
+    other.vao = other.vbo = other.ibo = 0;
+    other.indexCount = other.rangeCount = 0;
+}
+
+GpuMesh &GpuMesh::operator=(GpuMesh &&other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        vao = other.vao;
+        vbo = other.vbo;
+        ibo = other.ibo;
+        indexCount = other.indexCount;
+        rangeFirst = other.rangeFirst;
+        rangeCount = other.rangeCount;
+        indexType = other.indexType;
+        primitive = other.primitive;
+        packed = other.packed;
+        std::copy(other.decode, other.decode + 4, decode);
+        other.vao = other.vbo = other.ibo = 0;
+        other.indexCount = other.rangeCount = 0;
+    }
+    return *this;
+}
+
+void GpuMesh::upload(const std::vector<GpuVertex> &vertices, const std::vector<unsigned int> &indices, GLenum prim)
+{
+    upload(vertices.data(), vertices.size(), indices.data(), indices.size(), prim);
+}
+
+void GpuMesh::upload(const GpuVertex *vertices, size_t vertexCount, const unsigned int *indices, size_t indexCount, GLenum prim)
+{
+    upload(vertices, vertexCount, indices, indexCount, GL_UNSIGNED_INT, prim);
+}
+
+void GpuMesh::upload(const GpuVertex *vertices, size_t vertexCount, const void *indices, size_t indexCount,
+                     GLenum type, GLenum prim)
+{
+    packed = false;
+    uploadBuffers(vertices, vertexCount * sizeof(GpuVertex), vertexCount, indices, indexCount, type, prim);
+}
+
+void GpuMesh::uploadPacked(const PackedVertex *vertices, size_t vertexCount, const float decode[4],
+                           const void *indices, size_t indexCount, GLenum type, GLenum prim)
+{
+    packed = true;
+    for (int i = 0; i < 4; ++i)
+        this->decode[i] = decode[i];
+    uploadBuffers(vertices, vertexCount * sizeof(PackedVertex), vertexCount, indices, indexCount, type, prim);
+}
+
+void GpuMesh::uploadBuffers(const void *vertices, size_t vertexBytes, size_t vertexCount, const void *indices,
+                            size_t indexCount, GLenum type, GLenum prim)
+{
+    if (!GLExt::loadBuffers())
+        return;
+
+    // Índices de 32 bits que cabem em 16 sobem como 16: metade do IBO e da leitura.
+    std::vector<GLushort> narrowed;
+    if (type == GL_UNSIGNED_INT && vertexCount <= 0xFFFF)
+    {
+        const GLuint *wide = static_cast<const GLuint *>(indices);
+        narrowed.assign(wide, wide + indexCount);
+        indices = narrowed.data();
+        type = GL_UNSIGNED_SHORT;
+    }
+    size_t indexBytes = indexCount * (type == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint));
+
+    if (!vbo)
+        GLExt::GenBuffers(1, &vbo);
+    if (!ibo)
+        GLExt::GenBuffers(1, &ibo);
+
+    GLExt::BindBuffer(GL_ARRAY_BUFFER, vbo);
+    GLExt::BufferData(GL_ARRAY_BUFFER, vertexBytes, vertices, GL_STATIC_DRAW);
+    GLExt::BindBuffer(GL_ARRAY_BUFFER, 0);
+
+    if (GLExt::hasVertexArrays())
+    {
+        if (!vao)
+        {
+            GLExt::GenVertexArrays(1, &vao);
+        }
+        GLExt::BindVertexArray(vao);
+        bindAttributes();
+        GLExt::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+        GLExt::BufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes, indices, GL_STATIC_DRAW);
+        GLExt::BindVertexArray(0);
+        GLExt::BindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    else
+    {
+        GLExt::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+        GLExt::BufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes, indices, GL_STATIC_DRAW);
+        GLExt::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+
+    this->indexCount = static_cast<GLsizei>(indexCount);
+    rangeFirst = 0;
+    rangeCount = this->indexCount;
+    indexType = type;
+    primitive = prim;
+}
+
+void GpuMesh::bindAttributes() const
+{
+    GLExt::BindBuffer(GL_ARRAY_BUFFER, vbo);
+    GLExt::EnableVertexAttribArray(ATTRIB_POSITION);
+    GLExt::EnableVertexAttribArray(ATTRIB_NORMAL);
+    GLExt::EnableVertexAttribArray(ATTRIB_TEXCOORD);
+    if (packed)
+    {
+        // Posição inteira (a escala vem na modelview), normal normalizada, uv em half.
+        GLExt::VertexAttribPointer(ATTRIB_POSITION, 3, GL_SHORT, GL_FALSE, sizeof(PackedVertex),
+                                   reinterpret_cast<const void *>(offsetof(PackedVertex, px)));
+        GLExt::VertexAttribPointer(ATTRIB_NORMAL, 3, GL_BYTE, GL_TRUE, sizeof(PackedVertex),
+                                   reinterpret_cast<const void *>(offsetof(PackedVertex, nx)));
+        GLExt::VertexAttribPointer(ATTRIB_TEXCOORD, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedVertex),
+                                   reinterpret_cast<const void *>(offsetof(PackedVertex, u)));
+        return;
+    }
+    GLExt::VertexAttribPointer(ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(GpuVertex),
+                               reinterpret_cast<const void *>(offsetof(GpuVertex, px)));
+    GLExt::VertexAttribPointer(ATTRIB_NORMAL, 3, GL_FLOAT, GL_FALSE, sizeof(GpuVertex),
+                               reinterpret_cast<const void *>(offsetof(GpuVertex, nx)));
+    GLExt::VertexAttribPointer(ATTRIB_TEXCOORD, 2, GL_FLOAT, GL_FALSE, sizeof(GpuVertex),
+                               reinterpret_cast<const void *>(offsetof(GpuVertex, u)));
+}
+
+void GpuMesh::unbindAttributes() const
+{
+    GLExt::DisableVertexAttribArray(ATTRIB_POSITION);
+    GLExt::DisableVertexAttribArray(ATTRIB_NORMAL);
+    GLExt::DisableVertexAttribArray(ATTRIB_TEXCOORD);
+    GLExt::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GpuMesh::draw() const
+{
+    if (indexCount == 0)
+        return;
+
+    bind();
+    drawElements();
+    unbind();
+}
+
+void GpuMesh::bind() const
+{
+    if (vao)
+    {
+        GLExt::BindVertexArray(vao);
+        return;
+    }
+
+    bindAttributes();
+    GLExt::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+}
+
+void GpuMesh::drawElements(GLsizei instances) const
+{
+    const void *offset = rangeOffset();
+    if (instances == 1)
+        glDrawElements(primitive, rangeCount, indexType, offset);
+    else if (instances > 1)
+        GLExt::DrawElementsInstanced(primitive, rangeCount, indexType, offset, instances);
+    // Drivers que fazem alias dos atributos genéricos com os fixos (NVIDIA) também
+    // sobrescrevem cor, normal e uv atuais.
+    GLState::forgetCurrent(GLState::CURRENT_ALL);
+}
+
+void GpuMesh::unbind() const
+{
+    if (vao)
+    {
+        GLExt::BindVertexArray(0);
+        return;
+    }
+
+    GLExt::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    unbindAttributes();
+}
+
+void GpuMesh::drawFixedFunction(const GLubyte *colors) const
+{
+    if (indexCount == 0)
+        return;
+
+    // Compacto: a normal precisa ser renormalizada depois da escala da decodificação.
+    bool normalize = packed && !colors && !GLState::isEnabled(GL_NORMALIZE);
+    if (normalize)
+        GLState::enable(GL_NORMALIZE);
+
+    bindFixedFunction(colors);
+    drawFixedElements();
+    unbindFixedFunction(colors);
+
+    if (normalize)
+        GLState::disable(GL_NORMALIZE);
+}
+
+void GpuMesh::bindFixedFunction(const GLubyte *colors) const
+{
+    // Ponteiros do pipeline fixo (glVertexPointer...) como offsets dentro do VBO.
+    GLExt::BindBuffer(GL_ARRAY_BUFFER, vbo);
+    GLExt::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    if (packed)
+    {
+        glVertexPointer(3, GL_SHORT, sizeof(PackedVertex), reinterpret_cast<const void *>(offsetof(PackedVertex, px)));
+        glNormalPointer(GL_BYTE, sizeof(PackedVertex), reinterpret_cast<const void *>(offsetof(PackedVertex, nx)));
+        glTexCoordPointer(2, GL_HALF_FLOAT, sizeof(PackedVertex), reinterpret_cast<const void *>(offsetof(PackedVertex, u)));
+    }
+    else
+    {
+        glVertexPointer(3, GL_FLOAT, sizeof(GpuVertex), reinterpret_cast<const void *>(offsetof(GpuVertex, px)));
+        glNormalPointer(GL_FLOAT, sizeof(GpuVertex), reinterpret_cast<const void *>(offsetof(GpuVertex, nx)));
+        glTexCoordPointer(2, GL_FLOAT, sizeof(GpuVertex), reinterpret_cast<const void *>(offsetof(GpuVertex, u)));
+    }
+    if (colors)
+    {
+        // Cor assada por vértice, lida da memória (fora do VBO).
+        GLExt::BindBuffer(GL_ARRAY_BUFFER, 0);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glColorPointer(4, GL_UNSIGNED_BYTE, 0, colors);
+    }
+    else
+    {
+        glEnableClientState(GL_NORMAL_ARRAY);
+    }
+}
+
+void GpuMesh::drawFixedElements() const
+{
+    if (indexCount == 0)
+        return;
+
+    // A decodificação da posição compacta entra na modelview, à direita da matriz atual.
+    if (packed)
+    {
+        GLState::pushMatrix();
+        GLState::multMatrix(decodeMatrix().m);
+    }
+    glDrawElements(primitive, rangeCount, indexType, rangeOffset());
+    if (packed)
+        GLState::popMatrix();
+}
+
+void GpuMesh::unbindFixedFunction(const GLubyte *colors) const
+{
+    GLState::forgetCurrent(colors ? GLState::CURRENT_COLOR | GLState::CURRENT_TEXCOORD
+                                  : GLState::CURRENT_NORMAL | GLState::CURRENT_TEXCOORD);
+    glDisableClientState(colors ? GL_COLOR_ARRAY : GL_NORMAL_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    GLExt::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    GLExt::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+Mat4 GpuMesh::decodeMatrix() const
+{
+    if (!packed)
+        return Mat4::identity();
+    return Mat4::translation(decode[0], decode[1], decode[2]) * Mat4::scaling(decode[3], decode[3], decode[3]);
+}
+
+void GpuMesh::setDrawRange(size_t firstIndex, size_t count)
+{
+    size_t total = static_cast<size_t>(indexCount);
+    firstIndex = std::min(firstIndex, total);
+    rangeFirst = static_cast<GLsizei>(firstIndex);
+    rangeCount = static_cast<GLsizei>(std::min(count, total - firstIndex));
+}
+
+const void *GpuMesh::rangeOffset() const
+{
+    size_t indexSize = indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+    return reinterpret_cast<const void *>(static_cast<size_t>(rangeFirst) * indexSize);
+}
+
+void GpuMesh::release()
+{
+    if (vao)
+        GLExt::DeleteVertexArrays(1, &vao);
+    if (vbo)
+        GLExt::DeleteBuffers(1, &vbo);
+    if (ibo)
+        GLExt::DeleteBuffers(1, &ibo);
+    vao = vbo = ibo = 0;
+    indexCount = rangeFirst = rangeCount = 0;
+}
+
+void GpuMesh::buildCube(float size, std::vector<GpuVertex> &vertices, std::vector<unsigned int> &indices)
+{
+    const float h = size * 0.5f;
+    const float normals[6][3] = {{0, 0, 1}, {0, 0, -1}, {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}};
+    const float uvs[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+
+    vertices.clear();
+    indices.clear();
+    for (int face = 0; face < 6; ++face)
+    {
+        const float *n = normals[face];
+        // Dois eixos perpendiculares à normal, formando a face no sentido anti-horário.
+        float ax[3] = {n[1] != 0 ? 1.0f : -n[2], 0.0f, n[1] != 0 ? 0.0f : n[0]};
+        float ay[3] = {n[1] * ax[2] - n[2] * ax[1], n[2] * ax[0] - n[0] * ax[2], n[0] * ax[1] - n[1] * ax[0]};
+
+        unsigned int base = static_cast<unsigned int>(vertices.size());
+        for (int corner = 0; corner < 4; ++corner)
+        {
+            float sx = uvs[corner][0] * 2.0f - 1.0f;
+            float sy = uvs[corner][1] * 2.0f - 1.0f;
+            GpuVertex v;
+            v.px = (n[0] + ax[0] * sx + ay[0] * sy) * h;
+            v.py = (n[1] + ax[1] * sx + ay[1] * sy) * h;
+            v.pz = (n[2] + ax[2] * sx + ay[2] * sy) * h;
+            v.nx = n[0];
+            v.ny = n[1];
+            v.nz = n[2];
+            v.u = uvs[corner][0];
+            v.v = uvs[corner][1];
+            vertices.push_back(v);
+        }
+        indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+    }
+}
+
+void GpuMesh::buildSphere(float radius, int slices, int stacks,
+                          std::vector<GpuVertex> &vertices, std::vector<unsigned int> &indices)
+{
+    vertices.clear();
+    indices.clear();
+    for (int i = 0; i <= stacks; ++i)
+    {
+        float rho = static_cast<float>(M_PI) * i / stacks;
+        for (int j = 0; j <= slices; ++j)
+        {
+            float theta = 2.0f * static_cast<float>(M_PI) * j / slices;
+            GpuVertex v;
+            v.nx = std::sin(rho) * std::cos(theta);
+            v.ny = std::sin(rho) * std::sin(theta);
+            v.nz = std::cos(rho);
+            v.px = v.nx * radius;
+            v.py = v.ny * radius;
+            v.pz = v.nz * radius;
+            v.u = static_cast<float>(j) / slices;
+            v.v = 1.0f - static_cast<float>(i) / stacks;
+            vertices.push_back(v);
+        }
+    }
+
+    for (int i = 0; i < stacks; ++i)
+    {
+        for (int j = 0; j < slices; ++j)
+        {
+            unsigned int a = i * (slices + 1) + j;
+            unsigned int b = a + slices + 1;
+            indices.insert(indices.end(), {a, b, a + 1, a + 1, b, b + 1});
+        }
+    }
+}
+
+void GpuMesh::buildTorus(float innerRadius, float outerRadius, int sides, int rings,
+                         std::vector<GpuVertex> &vertices, std::vector<unsigned int> &indices)
+{
+    vertices.clear();
+    indices.clear();
+    for (int i = 0; i <= rings; ++i)
+    {
+        float phi = 2.0f * static_cast<float>(M_PI) * i / rings;
+        float cosPhi = std::cos(phi), sinPhi = std::sin(phi);
+        for (int j = 0; j <= sides; ++j)
+        {
+            float theta = 2.0f * static_cast<float>(M_PI) * j / sides;
+            float cosTheta = std::cos(theta), sinTheta = std::sin(theta);
+            float dist = outerRadius + innerRadius * cosTheta;
+
+            GpuVertex v;
+            v.px = cosPhi * dist;
+            v.py = sinPhi * dist;
+            v.pz = innerRadius * sinTheta;
+            v.nx = cosPhi * cosTheta;
+            v.ny = sinPhi * cosTheta;
+            v.nz = sinTheta;
+            v.u = static_cast<float>(i) / rings;
+            v.v = static_cast<float>(j) / sides;
+            vertices.push_back(v);
+        }
+    }
+
+    for (int i = 0; i < rings; ++i)
+    {
+        for (int j = 0; j < sides; ++j)
+        {
+            unsigned int a = i * (sides + 1) + j;
+            unsigned int b = a + sides + 1;
+            indices.insert(indices.end(), {a, b, a + 1, a + 1, b, b + 1});
+        }
+    }
+}
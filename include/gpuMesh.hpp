@@ -0,0 +1,96 @@
+#ifndef GPU_MESH_HPP
+#define GPU_MESH_HPP
+
+#include <vector>
+#include "glExt.hpp"
+#include "matrix.hpp"
+
+// Locations fixas dos atributos, compartilhadas por todos os shaders.
+enum VertexAttribute : GLuint
+{
+    ATTRIB_POSITION = 0,
+    ATTRIB_NORMAL = 1,
+    ATTRIB_TEXCOORD = 2,
+    ATTRIB_INSTANCE_MODEL = 3, // ocupa 3..6 (uma coluna por location)
+    ATTRIB_INSTANCE_COLOR = 7
+};
+
+struct GpuVertex
+{
+    float px, py, pz;
+    float nx, ny, nz;
+    float u, v;
+};
+
+struct PackedVertex;
+
+// Geometria residente na GPU (VBO intercalado + IBO, e VAO quando disponível).
+class GpuMesh
+{
+public:
+    GpuMesh();
+    ~GpuMesh();
+    GpuMesh(GpuMesh &&other) noexcept;
+    GpuMesh &operator=(GpuMesh &&other) noexcept;
+    GpuMesh(const GpuMesh &) = delete;
+    GpuMesh &operator=(const GpuMesh &) = delete;
+
+    void upload(const std::vector<GpuVertex> &vertices, const std::vector<unsigned int> &indices,
+                GLenum primitive = GL_TRIANGLES);
+    // Mesma coisa lendo direto de memória de outro dono (ex.: cache mapeado em memória).
+    void upload(const GpuVertex *vertices, size_t vertexCount, const unsigned int *indices, size_t indexCount,
+                GLenum primitive = GL_TRIANGLES);
+    // Índices de 16 ou 32 bits (GL_UNSIGNED_SHORT / GL_UNSIGNED_INT); 32 bits que cabem em 16 são convertidos.
+    void upload(const GpuVertex *vertices, size_t vertexCount, const void *indices, size_t indexCount,
+                GLenum indexType, GLenum primitive);
+    // Formato compacto (ver VertexPacking); decode = {centro x, y, z, escala} da posição.
+    void uploadPacked(const PackedVertex *vertices, size_t vertexCount, const float decode[4],
+                      const void *indices, size_t indexCount, GLenum indexType, GLenum primitive);
+    void draw() const;
+    // Para quem precisa configurar atributos extras (ex.: instâncias) entre bind e draw.
+    void bind() const;
+    void drawElements(GLsizei instances = 1) const;
+    void unbind() const;
+    // Uma chamada indexada no pipeline fixo (normal e coordenada de textura, sem shader).
+    // Com colors (RGBA8 por vértice, em memória) usa a cor no lugar da normal.
+    void drawFixedFunction(const GLubyte *colors = nullptr) const;
+    // O mesmo em partes, para vários draws com um bind só (ex.: uma matriz por instância).
+    void bindFixedFunction(const GLubyte *colors = nullptr) const;
+    void drawFixedElements() const;
+    void unbindFixedFunction(const GLubyte *colors = nullptr) const;
+    // Faixa de índices usada pelos draws seguintes (ex.: um LOD); o upload volta para o buffer todo.
+    void setDrawRange(size_t firstIndex, size_t count);
+    void release();
+    bool isEmpty() const { return indexCount == 0; }
+    bool isPacked() const { return packed; }
+    // Leva a posição compacta para o espaço do objeto (identidade em float); vai à direita da modelview.
+    Mat4 decodeMatrix() const;
+
+    // Equivalentes ao glutSolidCube/glutSolidSphere (polos no eixo Z, como o GLU).
+    static void buildCube(float size, std::vector<GpuVertex> &vertices, std::vector<unsigned int> &indices);
+    static void buildSphere(float radius, int slices, int stacks,
+                            std::vector<GpuVertex> &vertices, std::vector<unsigned int> &indices);
+    // Equivalente ao glutSolidTorus (eixo Z).
+    static void buildTorus(float innerRadius, float outerRadius, int sides, int rings,
+                           std::vector<GpuVertex> &vertices, std::vector<unsigned int> &indices);
+
+private:
+    GLuint vao;
+    GLuint vbo;
+    GLuint ibo;
+    GLsizei indexCount;
+    GLsizei rangeFirst;
+    GLsizei rangeCount;
+    GLenum indexType;
+    GLenum primitive;
+    bool packed;
+    float decode[4];
+
+    void uploadBuffers(const void *vertices, size_t vertexBytes, size_t vertexCount, const void *indices,
+                       size_t indexCount, GLenum indexType, GLenum primitive);
+    void bindAttributes() const;
+    const void *rangeOffset() const;
+    void unbindAttributes() const;
+};
+
+#endif
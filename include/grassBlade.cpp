@@ -6,10 +6,10 @@ GrassBlade::GrassBlade(float x, float y, float z)
 }
 
 void GrassBlade::draw() {
-    glPushMatrix();
-    glTranslatef(x, y, z);
+    GLState::pushMatrix();
+    GLState::translate(x, y, z);
     float sway = calculateSway();
-    glRotatef(sway, 0.0f, 0.0f, 1.0f);
+    GLState::rotate(sway, 0.0f, 0.0f, 1.0f);
     setupMaterial();
     glBegin(GL_TRIANGLES);
     for (int i = 0; i < BLADE_SEGMENTS; ++i) {
@@ -17,7 +17,7 @@ void GrassBlade::draw() {
     }
     glEnd();
     
-    glPopMatrix();
+    GLState::popMatrix();
 }
 
 float GrassBlade::calculateSway() const {
@@ -31,11 +31,11 @@ void GrassBlade::setupMaterial() const {
     const GLfloat specular[4] = {0.0f, 0.1f, 0.0f, 1.0f};
     const GLfloat shininess = 1.0f;
     
-    glDisable(GL_COLOR_MATERIAL);
-    glMaterialfv(GL_FRONT, GL_AMBIENT, ambient);
-    glMaterialfv(GL_FRONT, GL_DIFFUSE, diffuse);
-    glMaterialfv(GL_FRONT, GL_SPECULAR, specular);
-    glMaterialf(GL_FRONT, GL_SHININESS, shininess);
+    GLState::disable(GL_COLOR_MATERIAL);
+    GLState::material(GL_AMBIENT, ambient);
+    GLState::material(GL_DIFFUSE, diffuse);
+    GLState::material(GL_SPECULAR, specular);
+    GLState::materialf(GL_SHININESS, shininess);
 }
 
 void GrassBlade::drawBladeSegment(int segmentIndex) const {
@@ -3,6 +3,7 @@
 
 #include "GameObject.hpp" 
 #include <GL/glut.h> 
+#include "glState.hpp"
 #include <cmath>
 
 class GrassBlade : public GameObject {
@@ -0,0 +1,86 @@
+#include "healthBarPass.hpp"
+#include <algorithm>
+
+void HealthBarPass::begin()
+{
+    bars.clear();
+}
+
+void HealthBarPass::add(float x, float y, float z, float width, float height, float healthPercent)
+{
+    bars.push_back({x, y, z, width, height, std::max(0.0f, std::min(1.0f, healthPercent))});
+}
+
+void HealthBarPass::pushQuad(const float center[3], const float right[3], const float up[3],
+                             float left, float bottom, float w, float h,
+                             GLubyte r, GLubyte g, GLubyte b)
+{
+    float corners[4][2] = {{left, bottom}, {left + w, bottom}, {left + w, bottom + h}, {left, bottom + h}};
+    BarVertex quad[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        quad[i].x = center[0] + right[0] * corners[i][0] + up[0] * corners[i][1];
+        quad[i].y = center[1] + right[1] * corners[i][0] + up[1] * corners[i][1];
+        quad[i].z = center[2] + right[2] * corners[i][0] + up[2] * corners[i][1];
+        quad[i].r = r;
+        quad[i].g = g;
+        quad[i].b = b;
+        quad[i].a = 255;
+    }
+    const int order[6] = {0, 1, 2, 0, 2, 3};
+    for (int i : order)
+        vertices.push_back(quad[i]);
+}
+
+void HealthBarPass::draw()
+{
+    if (bars.empty())
+        return;
+
+    // Linhas da view = eixos direita/cima da câmera no mundo.
+    const Mat4 &view = GLState::modelview();
+    const float right[3] = {view.m[0], view.m[4], view.m[8]};
+    const float up[3] = {view.m[1], view.m[5], view.m[9]};
+    Mat4 viewProjection = GLState::projection() * view;
+
+    vertices.clear();
+    vertices.reserve(bars.size() * 18);
+    for (const Bar &bar : bars)
+    {
+        float clip[4];
+        viewProjection.transformPoint(bar.x, bar.y, bar.z, clip);
+        float margin = clip[3] * 1.2f;
+        if (clip[3] <= 0.0f || clip[0] < -margin || clip[0] > margin || clip[1] < -margin || clip[1] > margin)
+            continue;
+
+        const float center[3] = {bar.x, bar.y, bar.z};
+        float half = bar.width * 0.5f;
+        float border = bar.height * 0.15f;
+
+        // Ordem de desenho = ordem dos vértices (sem depth test): borda, fundo, vida.
+        pushQuad(center, right, up, -half - border, -border, bar.width + border * 2.0f, bar.height + border * 2.0f, 0, 0, 0);
+        pushQuad(center, right, up, -half, 0.0f, bar.width, bar.height, 77, 77, 77);
+        pushQuad(center, right, up, -half, 0.0f, bar.width * bar.healthPercent, bar.height,
+                 static_cast<GLubyte>((1.0f - bar.healthPercent) * 255.0f),
+                 static_cast<GLubyte>(bar.healthPercent * 255.0f), 0);
+    }
+
+    if (vertices.empty())
+        return;
+
+    GLState::disable(GL_LIGHTING);
+    GLState::disable(GL_DEPTH_TEST);
+    GLState::disable(GL_TEXTURE_2D);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(BarVertex), &vertices[0].x);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(BarVertex), &vertices[0].r);
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size()));
+    GLState::forgetCurrent(GLState::CURRENT_COLOR);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    GLState::enable(GL_DEPTH_TEST);
+    GLState::enable(GL_LIGHTING);
+}
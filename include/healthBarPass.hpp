@@ -0,0 +1,41 @@
+#ifndef HEALTH_BAR_PASS_HPP
+#define HEALTH_BAR_PASS_HPP
+
+#include <vector>
+#include "glState.hpp"
+
+// Barras de vida de todos os inimigos (e do boss) em uma única passada:
+// os quads voltados para a câmera são montados na CPU em um só vertex array
+// e desenhados com uma chamada, sem leitura de matriz nem troca de estado por inimigo.
+class HealthBarPass
+{
+public:
+    void begin();
+    // (x, y, z): ponto do mundo onde fica a base da barra.
+    void add(float x, float y, float z, float width, float height, float healthPercent);
+    // Usa a câmera atual do GLState (modelview = view) para orientar e descartar.
+    void draw();
+
+private:
+    struct BarVertex
+    {
+        GLfloat x, y, z;
+        GLubyte r, g, b, a;
+    };
+
+    struct Bar
+    {
+        float x, y, z;
+        float width, height;
+        float healthPercent;
+    };
+
+    std::vector<Bar> bars;
+    std::vector<BarVertex> vertices;
+
+    void pushQuad(const float center[3], const float right[3], const float up[3],
+                  float left, float bottom, float w, float h,
+                  GLubyte r, GLubyte g, GLubyte b);
+};
+
+#endif
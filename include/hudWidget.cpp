@@ -0,0 +1,175 @@
+#include "hudWidget.hpp"
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+void HudGeometry::clear()
+{
+    vertices.clear();
+}
+
+void HudGeometry::toBytes(const float c[4], GLubyte out[4])
+{
+    for (int i = 0; i < 4; ++i)
+        out[i] = static_cast<GLubyte>(std::max(0.0f, std::min(1.0f, c[i])) * 255.0f + 0.5f);
+}
+
+void HudGeometry::color(float r, float g, float b, float a)
+{
+    const float c[4] = {r, g, b, a};
+    toBytes(c, current);
+}
+
+void HudGeometry::push(float x, float y, const GLubyte c[4])
+{
+    vertices.push_back({x, y, c[0], c[1], c[2], c[3]});
+}
+
+void HudGeometry::rect(float x0, float y0, float x1, float y1)
+{
+    const float xy[8] = {x0, y0, x1, y0, x1, y1, x0, y1};
+    polygon(xy, 4);
+}
+
+void HudGeometry::rect(float x0, float y0, float x1, float y1,
+                       const float c0[4], const float c1[4], const float c2[4], const float c3[4])
+{
+    GLubyte b[4][4];
+    toBytes(c0, b[0]);
+    toBytes(c1, b[1]);
+    toBytes(c2, b[2]);
+    toBytes(c3, b[3]);
+    push(x0, y0, b[0]);
+    push(x1, y0, b[1]);
+    push(x1, y1, b[2]);
+    push(x0, y0, b[0]);
+    push(x1, y1, b[2]);
+    push(x0, y1, b[3]);
+}
+
+void HudGeometry::polygon(const float *xy, int count)
+{
+    for (int i = 1; i + 1 < count; ++i)
+    {
+        push(xy[0], xy[1], current);
+        push(xy[i * 2], xy[i * 2 + 1], current);
+        push(xy[(i + 1) * 2], xy[(i + 1) * 2 + 1], current);
+    }
+}
+
+const std::vector<float> &HudGeometry::unitCircle(int segments)
+{
+    static std::map<int, std::vector<float>> tables;
+    std::vector<float> &table = tables[segments];
+    if (table.empty())
+    {
+        for (int i = 0; i < segments; ++i)
+        {
+            float theta = 2.0f * M_PI * i / segments;
+            table.push_back(cosf(theta));
+            table.push_back(sinf(theta));
+        }
+    }
+    return table;
+}
+
+void HudGeometry::filledCircle(float x, float y, float radius, int segments)
+{
+    const std::vector<float> &table = unitCircle(segments);
+    std::vector<float> xy(table.size());
+    for (size_t i = 0; i < table.size(); i += 2)
+    {
+        xy[i] = x + radius * table[i];
+        xy[i + 1] = y + radius * table[i + 1];
+    }
+    polygon(xy.data(), segments);
+}
+
+void HudGeometry::line(float x0, float y0, float x1, float y1, float width)
+{
+    pushLine(x0, y0, current, x1, y1, current, width);
+}
+
+void HudGeometry::line(float x0, float y0, const float c0[4], float x1, float y1, const float c1[4], float width)
+{
+    GLubyte a[4], b[4];
+    toBytes(c0, a);
+    toBytes(c1, b);
+    pushLine(x0, y0, a, x1, y1, b, width);
+}
+
+void HudGeometry::pushLine(float x0, float y0, const GLubyte c0[4], float x1, float y1, const GLubyte c1[4], float width)
+{
+    float dx = x1 - x0, dy = y1 - y0;
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length <= 0.0f)
+        return;
+
+    float nx = -dy / length * width * 0.5f;
+    float ny = dx / length * width * 0.5f;
+    push(x0 + nx, y0 + ny, c0);
+    push(x0 - nx, y0 - ny, c0);
+    push(x1 - nx, y1 - ny, c1);
+    push(x0 + nx, y0 + ny, c0);
+    push(x1 - nx, y1 - ny, c1);
+    push(x1 + nx, y1 + ny, c1);
+}
+
+void HudGeometry::rectOutline(float x0, float y0, float x1, float y1, float width)
+{
+    line(x0, y0, x1, y0, width);
+    line(x1, y0, x1, y1, width);
+    line(x1, y1, x0, y1, width);
+    line(x0, y1, x0, y0, width);
+}
+
+void HudGeometry::circle(float x, float y, float radius, int segments, float width)
+{
+    const std::vector<float> &table = unitCircle(segments);
+    for (int i = 0; i < segments; ++i)
+    {
+        int j = (i + 1) % segments;
+        line(x + radius * table[i * 2], y + radius * table[i * 2 + 1],
+             x + radius * table[j * 2], y + radius * table[j * 2 + 1], width);
+    }
+}
+
+void HudGeometry::draw() const
+{
+    if (vertices.empty())
+        return;
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(HudVertex), &vertices[0].x);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(HudVertex), &vertices[0].r);
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size()));
+    GLState::forgetCurrent(GLState::CURRENT_COLOR);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+bool HudWidget::changed(std::initializer_list<float> inputs)
+{
+    if (built && inputs.size() == lastInputs.size() && std::equal(inputs.begin(), inputs.end(), lastInputs.begin()))
+        return false;
+
+    lastInputs.assign(inputs.begin(), inputs.end());
+    built = true;
+    return true;
+}
+
+bool HudWidget::changed(const std::vector<float> &inputs)
+{
+    if (built && inputs == lastInputs)
+        return false;
+
+    lastInputs = inputs;
+    built = true;
+    return true;
+}
+
+void HudWidget::invalidate()
+{
+    built = false;
+}
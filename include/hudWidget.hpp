@@ -0,0 +1,68 @@
+#ifndef HUD_WIDGET_HPP
+#define HUD_WIDGET_HPP
+
+#include <initializer_list>
+#include <vector>
+#include "glState.hpp"
+
+// Geometria 2D do HUD em um único vertex array de triângulos coloridos.
+// Linhas viram quads finos, então a ordem de desenho é a ordem em que as
+// formas foram adicionadas e tudo sai em um glDrawArrays.
+class HudGeometry
+{
+public:
+    void clear();
+    bool isEmpty() const { return vertices.empty(); }
+
+    void color(float r, float g, float b, float a = 1.0f);
+
+    void rect(float x0, float y0, float x1, float y1);
+    // Cores nos cantos (x0,y0), (x1,y0), (x1,y1), (x0,y1).
+    void rect(float x0, float y0, float x1, float y1,
+              const float c0[4], const float c1[4], const float c2[4], const float c3[4]);
+    // Polígono convexo (leque a partir do primeiro ponto), como o GL_POLYGON.
+    void polygon(const float *xy, int count);
+    void filledCircle(float x, float y, float radius, int segments);
+
+    void line(float x0, float y0, float x1, float y1, float width);
+    void line(float x0, float y0, const float c0[4], float x1, float y1, const float c1[4], float width);
+    void rectOutline(float x0, float y0, float x1, float y1, float width);
+    void circle(float x, float y, float radius, int segments, float width);
+
+    void draw() const;
+
+private:
+    struct HudVertex
+    {
+        GLfloat x, y;
+        GLubyte r, g, b, a;
+    };
+
+    std::vector<HudVertex> vertices;
+    GLubyte current[4] = {255, 255, 255, 255};
+
+    void push(float x, float y, const GLubyte c[4]);
+    void pushLine(float x0, float y0, const GLubyte c0[4], float x1, float y1, const GLubyte c1[4], float width);
+    static void toBytes(const float c[4], GLubyte out[4]);
+    // cos/sin de cada segmento, calculados uma vez por quantidade de segmentos.
+    static const std::vector<float> &unitCircle(int segments);
+};
+
+// Elemento retido do HUD: guarda as entradas usadas no último build da geometria
+// e só pede um novo build quando alguma delas muda (vida, hover, janela...).
+class HudWidget
+{
+public:
+    HudGeometry geometry;
+
+    bool changed(std::initializer_list<float> inputs);
+    bool changed(const std::vector<float> &inputs);
+    void invalidate();
+    void draw() const { geometry.draw(); }
+
+private:
+    std::vector<float> lastInputs;
+    bool built = false;
+};
+
+#endif
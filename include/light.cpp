@@ -1,19 +1,19 @@
 #include "light.hpp"
 
+const GLfloat Light::position[4] = {0.0f, 10.0f, 0.0f, 1.0f};
+const GLfloat Light::ambient[4] = {0.5f, 0.5f, 0.5f, 1.0f};
+const GLfloat Light::diffuse[4] = {0.8f, 0.8f, 0.8f, 1.0f};
+const GLfloat Light::specular[4] = {0.9f, 0.9f, 0.9f, 1.0f};
+
 void Light::initLight() {
    
-    GLfloat light_position[] = {0.0f, 10.0f, 0.0f, 1.0f};
-    GLfloat light_ambient[] = {0.5f, 0.5f, 0.5f, 1.0f};
-    GLfloat light_diffuse[] = {0.8f, 0.8f, 0.8f, 1.0f};
-    GLfloat light_specular[] = {0.9f, 0.9f, 0.9f, 1.0f};
-    
-    glLightfv(GL_LIGHT0, GL_POSITION, light_position);
-    glLightfv(GL_LIGHT0, GL_AMBIENT, light_ambient);
-    glLightfv(GL_LIGHT0, GL_DIFFUSE, light_diffuse);
-    glLightfv(GL_LIGHT0, GL_SPECULAR, light_specular);
+    glLightfv(GL_LIGHT0, GL_POSITION, position);
+    glLightfv(GL_LIGHT0, GL_AMBIENT, ambient);
+    glLightfv(GL_LIGHT0, GL_DIFFUSE, diffuse);
+    glLightfv(GL_LIGHT0, GL_SPECULAR, specular);
 
-    glEnable(GL_LIGHTING);
-    glEnable(GL_LIGHT0);
+    GLState::enable(GL_LIGHTING);
+    GLState::enable(GL_LIGHT0);
 }
 
 
@@ -1,10 +1,18 @@
 #ifndef LIGHT_HPP
 #define LIGHT_HPP
 #include <GL/glut.h>
+#include "glState.hpp"
 
 class Light {
 public:
     static void initLight();
+
+    // Valores da GL_LIGHT0, lidos também pelo caminho com shaders.
+    // A posição é definida com a modelview identidade, ou seja, em espaço de câmera.
+    static const GLfloat position[4];
+    static const GLfloat ambient[4];
+    static const GLfloat diffuse[4];
+    static const GLfloat specular[4];
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,126 @@
+#include "lightBaker.hpp"
+#include "light.hpp"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+// A GL_LIGHT0 fica acima da câmera, então no chão ela vem quase sempre de cima.
+const float LightBaker::SUN_DIRECTION[3] = {0.27f, 0.93f, 0.23f};
+
+void LightBaker::parallelFor(size_t count, const std::function<void(size_t, size_t)> &work)
+{
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, std::max<size_t>(1, count / 256));
+    if (threads <= 1)
+    {
+        work(0, count);
+        return;
+    }
+
+    // Faixas contíguas: cada thread escreve só na sua parte da saída.
+    std::vector<std::thread> workers;
+    size_t chunk = (count + threads - 1) / threads;
+    for (size_t begin = 0; begin < count; begin += chunk)
+        workers.emplace_back(work, begin, std::min(count, begin + chunk));
+    for (std::thread &worker : workers)
+        worker.join();
+}
+
+void LightBaker::occlusion(const std::vector<GpuVertex> &vertices, const HeightField &height, std::vector<float> &out)
+{
+    const int DIRECTIONS = 8;
+    const float distances[] = {0.5f, 1.0f, 2.0f, 3.0f, 4.5f};
+
+    out.resize(vertices.size());
+    parallelFor(vertices.size(), [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const GpuVertex &v = vertices[i];
+            float open = 0.0f;
+            for (int d = 0; d < DIRECTIONS; ++d)
+            {
+                float angle = d * 2.0f * M_PI / DIRECTIONS;
+                float dx = std::cos(angle), dz = std::sin(angle);
+
+                // Maior elevação do horizonte nessa direção: seno vira a parte do céu tampada.
+                float horizon = 0.0f;
+                for (float distance : distances)
+                {
+                    float rise = height(v.px + dx * distance, v.pz + dz * distance) - v.py;
+                    horizon = std::max(horizon, rise / std::sqrt(rise * rise + distance * distance));
+                }
+                open += 1.0f - horizon;
+            }
+            out[i] = open / DIRECTIONS;
+        }
+    });
+}
+
+float LightBaker::contactOcclusion(float heightAboveGround)
+{
+    return 0.55f + 0.45f * std::min(1.0f, std::max(0.0f, heightAboveGround / 1.5f));
+}
+
+void LightBaker::shadeOne(const float position[3], const float normal[3], float occlusion, const BakeMaterial &material,
+                          const std::vector<LightManager::StaticLight> &lights, GLubyte out[4])
+{
+    // Mesmo modelo do pipeline fixo, sem especular (depende da câmera).
+    const GLfloat sceneAmbient = 0.2f;
+    float sun = std::max(0.0f, normal[0] * SUN_DIRECTION[0] + normal[1] * SUN_DIRECTION[1] + normal[2] * SUN_DIRECTION[2]);
+
+    float color[3];
+    for (int k = 0; k < 3; ++k)
+        color[k] = material.ambient[k] * (sceneAmbient + Light::ambient[k]) * occlusion +
+                   material.diffuse[k] * Light::diffuse[k] * sun;
+
+    // Luzes fixas com a atenuação que o LightManager configura nas GL_LIGHT1..7.
+    for (const LightManager::StaticLight &light : lights)
+    {
+        float lx = light.x - position[0], ly = light.y - position[1], lz = light.z - position[2];
+        float distanceSq = lx * lx + ly * ly + lz * lz;
+        if (distanceSq >= light.radius * light.radius)
+            continue;
+
+        float distance = std::sqrt(distanceSq);
+        float facing = distance > 0.0f ? (normal[0] * lx + normal[1] * ly + normal[2] * lz) / distance : 1.0f;
+        if (facing <= 0.0f)
+            continue;
+
+        float attenuation = 1.0f / (1.0f + 25.0f * distanceSq / (light.radius * light.radius));
+        color[0] += material.diffuse[0] * light.r * facing * attenuation;
+        color[1] += material.diffuse[1] * light.g * facing * attenuation;
+        color[2] += material.diffuse[2] * light.b * facing * attenuation;
+    }
+
+    for (int k = 0; k < 3; ++k)
+        out[k] = static_cast<GLubyte>(std::min(1.0f, color[k]) * 255.0f + 0.5f);
+    out[3] = 255;
+}
+
+void LightBaker::shade(const std::vector<GpuVertex> &vertices, const std::vector<float> &occlusion,
+                       const BakeMaterial &material, std::vector<GLubyte> &out)
+{
+    std::vector<LightManager::StaticLight> lights;
+    LightManager::staticLights(lights);
+
+    out.resize(vertices.size() * 4);
+    parallelFor(vertices.size(), [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const GpuVertex &v = vertices[i];
+            const float position[3] = {v.px, v.py, v.pz};
+            const float normal[3] = {v.nx, v.ny, v.nz};
+            shadeOne(position, normal, occlusion[i], material, lights, &out[i * 4]);
+        }
+    });
+}
+
+void LightBaker::shadePoint(const float position[3], const float normal[3], float occlusion,
+                            const BakeMaterial &material, GLubyte out[4])
+{
+    std::vector<LightManager::StaticLight> lights;
+    LightManager::staticLights(lights);
+    shadeOne(position, normal, occlusion, material, lights, out);
+}
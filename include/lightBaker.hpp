@@ -0,0 +1,43 @@
+#ifndef LIGHT_BAKER_HPP
+#define LIGHT_BAKER_HPP
+
+#include <functional>
+#include <vector>
+#include "gpuMesh.hpp"
+#include "lightManager.hpp"
+
+// Iluminação assada por vértice para a geometria que não se move (chão e paredes).
+// Sol fixo no mundo com os valores da GL_LIGHT0 + luzes fixas do LightManager,
+// vezes a oclusão ambiente do heightfield. O resultado já inclui o material, então
+// a superfície é desenhada sem iluminação, só cor do vértice x textura.
+struct BakeMaterial
+{
+    float ambient[3];
+    float diffuse[3];
+};
+
+class LightBaker
+{
+public:
+    using HeightField = std::function<float(float, float)>;
+
+    // Oclusão (0 = fechado, 1 = céu aberto) olhando o horizonte do heightfield em 8 direções.
+    static void occlusion(const std::vector<GpuVertex> &vertices, const HeightField &height, std::vector<float> &out);
+    // RGBA por vértice; divide os vértices entre as threads disponíveis.
+    static void shade(const std::vector<GpuVertex> &vertices, const std::vector<float> &occlusion,
+                      const BakeMaterial &material, std::vector<GLubyte> &out);
+    // Um vértice só, para quem assa poucos pontos (paredes).
+    static void shadePoint(const float position[3], const float normal[3], float occlusion,
+                           const BakeMaterial &material, GLubyte out[4]);
+    // Escurece a base de superfícies verticais que encostam no chão.
+    static float contactOcclusion(float heightAboveGround);
+
+private:
+    static const float SUN_DIRECTION[3];
+
+    static void shadeOne(const float position[3], const float normal[3], float occlusion, const BakeMaterial &material,
+                         const std::vector<LightManager::StaticLight> &lights, GLubyte out[4]);
+    static void parallelFor(size_t count, const std::function<void(size_t, size_t)> &work);
+};
+
+#endif
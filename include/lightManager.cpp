@@ -0,0 +1,226 @@
+#include "lightManager.hpp"
+#include <algorithm>
+#include <cmath>
+
+const float LightManager::CELL_SIZE = 4.0f;
+
+LightManager::PointLight LightManager::lights[LightManager::MAX_LIGHTS];
+std::unordered_map<long long, LightManager::Cell> LightManager::cells;
+unsigned int LightManager::layoutVersion = 1;
+unsigned int LightManager::staticLayoutVersion = 1;
+unsigned int LightManager::frame = 1;
+
+int LightManager::active = 0;
+int LightManager::activeIds[LightManager::MAX_ACTIVE];
+GLfloat LightManager::activeEye[LightManager::MAX_ACTIVE][4];
+GLfloat LightManager::activeDiffuse[LightManager::MAX_ACTIVE][4];
+unsigned int LightManager::activeFrame = 0;
+unsigned int LightManager::appliedVersion = 0;
+
+int LightManager::allocate(float x, float y, float z, float r, float g, float b, float radius)
+{
+    for (int id = 0; id < MAX_LIGHTS; ++id)
+    {
+        PointLight &light = lights[id];
+        if (light.used)
+            continue;
+
+        light = {true, x, y, z, r, g, b, radius, 0.0f, 0.0f, {x, y, z, 1.0f}};
+        ++layoutVersion;
+        return id;
+    }
+    return -1;
+}
+
+int LightManager::add(float x, float y, float z, float r, float g, float b, float radius)
+{
+    int id = allocate(x, y, z, r, g, b, radius);
+    if (id >= 0)
+        ++staticLayoutVersion;
+    return id;
+}
+
+void LightManager::remove(int id)
+{
+    if (id < 0 || id >= MAX_LIGHTS || !lights[id].used)
+        return;
+    lights[id].used = false;
+    ++layoutVersion;
+    if (lights[id].maxLife <= 0.0f)
+        ++staticLayoutVersion;
+}
+
+void LightManager::move(int id, float x, float y, float z)
+{
+    if (id < 0 || id >= MAX_LIGHTS || !lights[id].used)
+        return;
+    PointLight &light = lights[id];
+    if (light.x == x && light.y == y && light.z == z)
+        return;
+    light.x = x;
+    light.y = y;
+    light.z = z;
+    ++layoutVersion;
+    if (light.maxLife <= 0.0f)
+        ++staticLayoutVersion;
+}
+
+void LightManager::flash(float x, float y, float z, float r, float g, float b, float radius, float duration)
+{
+    int id = allocate(x, y, z, r, g, b, radius);
+    if (id < 0)
+        return;
+    lights[id].life = duration;
+    lights[id].maxLife = duration;
+}
+
+void LightManager::clear()
+{
+    for (PointLight &light : lights)
+        light.used = false;
+    cells.clear();
+    ++layoutVersion;
+    ++staticLayoutVersion;
+    disableAll();
+}
+
+void LightManager::staticLights(std::vector<StaticLight> &out)
+{
+    out.clear();
+    for (const PointLight &light : lights)
+    {
+        if (light.used && light.maxLife <= 0.0f)
+            out.push_back({light.x, light.y, light.z, light.r, light.g, light.b, light.radius});
+    }
+}
+
+void LightManager::update(float deltaTime)
+{
+    for (PointLight &light : lights)
+    {
+        if (!light.used || light.maxLife <= 0.0f)
+            continue;
+        light.life -= deltaTime;
+        if (light.life <= 0.0f)
+        {
+            light.used = false;
+            ++layoutVersion;
+        }
+    }
+}
+
+void LightManager::beginFrame()
+{
+    ++frame;
+    const Mat4 &view = GLState::modelview();
+    for (PointLight &light : lights)
+    {
+        if (light.used)
+            view.transformPoint(light.x, light.y, light.z, light.eye);
+    }
+}
+
+float LightManager::intensity(const PointLight &light)
+{
+    return light.maxLife > 0.0f ? light.life / light.maxLife : 1.0f;
+}
+
+const LightManager::Cell &LightManager::cellAt(int cx, int cz)
+{
+    Cell &cell = cells[(static_cast<long long>(cx) << 32) ^ static_cast<unsigned int>(cz)];
+    if (cell.version == layoutVersion)
+        return cell;
+
+    // Relevância = brilho que chegaria no ponto da célula mais próximo da luz.
+    float x0 = cx * CELL_SIZE, x1 = x0 + CELL_SIZE;
+    float z0 = cz * CELL_SIZE, z1 = z0 + CELL_SIZE;
+    float scores[MAX_ACTIVE];
+    cell.count = 0;
+    for (int id = 0; id < MAX_LIGHTS; ++id)
+    {
+        const PointLight &light = lights[id];
+        if (!light.used)
+            continue;
+
+        float dx = std::max(0.0f, std::max(x0 - light.x, light.x - x1));
+        float dz = std::max(0.0f, std::max(z0 - light.z, light.z - z1));
+        float distanceSq = dx * dx + dz * dz;
+        if (distanceSq >= light.radius * light.radius)
+            continue;
+
+        float score = std::max(light.r, std::max(light.g, light.b)) / (1.0f + 25.0f * distanceSq / (light.radius * light.radius));
+        int slot = cell.count < MAX_ACTIVE ? cell.count++ : MAX_ACTIVE;
+        while (slot > 0 && scores[slot - 1] < score)
+        {
+            if (slot < MAX_ACTIVE)
+            {
+                scores[slot] = scores[slot - 1];
+                cell.lights[slot] = cell.lights[slot - 1];
+            }
+            --slot;
+        }
+        if (slot < MAX_ACTIVE)
+        {
+            scores[slot] = score;
+            cell.lights[slot] = id;
+        }
+    }
+    cell.version = layoutVersion;
+    return cell;
+}
+
+void LightManager::apply(float x, float z)
+{
+    const Cell &cell = cellAt(static_cast<int>(std::floor(x / CELL_SIZE)), static_cast<int>(std::floor(z / CELL_SIZE)));
+    if (activeFrame == frame && cell.count == active && std::equal(cell.lights, cell.lights + cell.count, activeIds))
+        return;
+
+    // As posições já estão em espaço de câmera: envia com a modelview identidade.
+    GLState::pushMatrix();
+    GLState::loadIdentity();
+    for (int slot = 0; slot < MAX_ACTIVE; ++slot)
+    {
+        GLenum glLight = GL_LIGHT1 + slot;
+        if (slot >= cell.count)
+        {
+            GLState::disable(glLight);
+            continue;
+        }
+
+        const PointLight &light = lights[cell.lights[slot]];
+        float s = intensity(light);
+        float quadratic = 25.0f / (light.radius * light.radius);
+        activeIds[slot] = cell.lights[slot];
+        activeEye[slot][0] = light.eye[0];
+        activeEye[slot][1] = light.eye[1];
+        activeEye[slot][2] = light.eye[2];
+        activeEye[slot][3] = quadratic;
+        activeDiffuse[slot][0] = light.r * s;
+        activeDiffuse[slot][1] = light.g * s;
+        activeDiffuse[slot][2] = light.b * s;
+        activeDiffuse[slot][3] = 1.0f;
+
+        const GLfloat position[4] = {light.eye[0], light.eye[1], light.eye[2], 1.0f};
+        glLightfv(glLight, GL_POSITION, position);
+        glLightfv(glLight, GL_DIFFUSE, activeDiffuse[slot]);
+        glLightfv(glLight, GL_SPECULAR, activeDiffuse[slot]);
+        glLightf(glLight, GL_CONSTANT_ATTENUATION, 1.0f);
+        glLightf(glLight, GL_LINEAR_ATTENUATION, 0.0f);
+        glLightf(glLight, GL_QUADRATIC_ATTENUATION, quadratic);
+        GLState::enable(glLight);
+    }
+    GLState::popMatrix();
+
+    active = cell.count;
+    activeFrame = frame;
+    ++appliedVersion;
+}
+
+void LightManager::disableAll()
+{
+    for (int slot = 0; slot < MAX_ACTIVE; ++slot)
+        GLState::disable(GL_LIGHT1 + slot);
+    active = 0;
+    activeFrame = 0;
+    ++appliedVersion;
+}
@@ -0,0 +1,88 @@
+#ifndef LIGHT_MANAGER_HPP
+#define LIGHT_MANAGER_HPP
+
+#include <unordered_map>
+#include <vector>
+#include "glState.hpp"
+
+// Luzes pontuais da cena (fogueira, portais, clarões de ataque) além da GL_LIGHT0.
+// O mundo é dividido em células no plano xz; cada célula guarda as MAX_ACTIVE
+// luzes mais relevantes e só é recalculada quando uma luz entra, sai ou se move.
+// apply() liga essas luzes nas GL_LIGHT1..7 antes de desenhar um objeto ou trecho.
+class LightManager
+{
+public:
+    static const int MAX_LIGHTS = 64;
+    static const int MAX_ACTIVE = 7; // GL_LIGHT1..GL_LIGHT7, a GL_LIGHT0 continua sendo a principal
+    static const float CELL_SIZE;
+
+    // Retorna o id da luz, ou -1 com o pool cheio.
+    static int add(float x, float y, float z, float r, float g, float b, float radius);
+    static void remove(int id);
+    static void move(int id, float x, float y, float z);
+    // Luz temporária que apaga sozinha em `duration` segundos.
+    static void flash(float x, float y, float z, float r, float g, float b, float radius, float duration);
+    static void clear();
+
+    static void update(float deltaTime);
+    // Chamar depois de aplicar a câmera: converte as posições para espaço de câmera.
+    static void beginFrame();
+    // Liga as luzes da célula que contém (x, z); não faz nada se já estiverem ligadas.
+    static void apply(float x, float z);
+    static void disableAll();
+
+    // Conjunto ligado pelo último apply(), lido pelo caminho com shaders.
+    // Posição em espaço de câmera com w = atenuação quadrática.
+    static int activeCount() { return active; }
+    static const GLfloat *activePosition(int slot) { return activeEye[slot]; }
+    static const GLfloat *activeColor(int slot) { return activeDiffuse[slot]; }
+    static unsigned int activeVersion() { return appliedVersion; }
+
+    // Luzes fixas (sem os clarões), usadas pelo LightBaker. A versão muda quando
+    // alguma entra, sai ou se move, ou seja, quando o que foi assado ficou velho.
+    struct StaticLight
+    {
+        float x, y, z;
+        float r, g, b;
+        float radius;
+    };
+    static void staticLights(std::vector<StaticLight> &out);
+    static unsigned int staticVersion() { return staticLayoutVersion; }
+
+private:
+    struct PointLight
+    {
+        bool used;
+        float x, y, z;
+        float r, g, b;
+        float radius;
+        float life, maxLife; // maxLife <= 0: luz fixa
+        GLfloat eye[4];
+    };
+
+    struct Cell
+    {
+        unsigned int version;
+        int count;
+        int lights[MAX_ACTIVE];
+    };
+
+    static PointLight lights[MAX_LIGHTS];
+    static std::unordered_map<long long, Cell> cells;
+    static unsigned int layoutVersion;
+    static unsigned int staticLayoutVersion;
+    static unsigned int frame;
+
+    static int active;
+    static int activeIds[MAX_ACTIVE];
+    static GLfloat activeEye[MAX_ACTIVE][4];
+    static GLfloat activeDiffuse[MAX_ACTIVE][4];
+    static unsigned int activeFrame;
+    static unsigned int appliedVersion;
+
+    static int allocate(float x, float y, float z, float r, float g, float b, float radius);
+    static const Cell &cellAt(int cx, int cz);
+    static float intensity(const PointLight &light);
+};
+
+#endif
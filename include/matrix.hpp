@@ -0,0 +1,168 @@
+#ifndef MATRIX_HPP
+#define MATRIX_HPP
+
+#include <cmath>
+#include <cstring>
+
+// Matriz 4x4 em ordem de coluna (mesmo layout do OpenGL).
+struct Mat4
+{
+    float m[16];
+
+    static Mat4 identity()
+    {
+        Mat4 r;
+        std::memset(r.m, 0, sizeof(r.m));
+        r.m[0] = r.m[5] = r.m[10] = r.m[15] = 1.0f;
+        return r;
+    }
+
+    static Mat4 fromArray(const float *v)
+    {
+        Mat4 r;
+        std::memcpy(r.m, v, sizeof(r.m));
+        return r;
+    }
+
+    static Mat4 translation(float x, float y, float z)
+    {
+        Mat4 r = identity();
+        r.m[12] = x;
+        r.m[13] = y;
+        r.m[14] = z;
+        return r;
+    }
+
+    static Mat4 scaling(float x, float y, float z)
+    {
+        Mat4 r = identity();
+        r.m[0] = x;
+        r.m[5] = y;
+        r.m[10] = z;
+        return r;
+    }
+
+    // Mesma convenção do glRotatef: ângulo em graus, eixo normalizado internamente.
+    static Mat4 rotation(float angleDeg, float x, float y, float z)
+    {
+        Mat4 r = identity();
+        float len = std::sqrt(x * x + y * y + z * z);
+        if (len <= 0.0f)
+            return r;
+        x /= len;
+        y /= len;
+        z /= len;
+
+        float rad = angleDeg * static_cast<float>(M_PI) / 180.0f;
+        float c = std::cos(rad);
+        float s = std::sin(rad);
+        float t = 1.0f - c;
+
+        r.m[0] = x * x * t + c;
+        r.m[1] = y * x * t + z * s;
+        r.m[2] = x * z * t - y * s;
+        r.m[4] = x * y * t - z * s;
+        r.m[5] = y * y * t + c;
+        r.m[6] = y * z * t + x * s;
+        r.m[8] = x * z * t + y * s;
+        r.m[9] = y * z * t - x * s;
+        r.m[10] = z * z * t + c;
+        return r;
+    }
+
+    static Mat4 perspective(float fovyDeg, float aspect, float zNear, float zFar)
+    {
+        Mat4 r;
+        std::memset(r.m, 0, sizeof(r.m));
+        float f = 1.0f / std::tan(fovyDeg * static_cast<float>(M_PI) / 360.0f);
+        r.m[0] = f / aspect;
+        r.m[5] = f;
+        r.m[10] = (zFar + zNear) / (zNear - zFar);
+        r.m[11] = -1.0f;
+        r.m[14] = (2.0f * zFar * zNear) / (zNear - zFar);
+        return r;
+    }
+
+    static Mat4 ortho(float left, float right, float bottom, float top, float zNear, float zFar)
+    {
+        Mat4 r = identity();
+        r.m[0] = 2.0f / (right - left);
+        r.m[5] = 2.0f / (top - bottom);
+        r.m[10] = -2.0f / (zFar - zNear);
+        r.m[12] = -(right + left) / (right - left);
+        r.m[13] = -(top + bottom) / (top - bottom);
+        r.m[14] = -(zFar + zNear) / (zFar - zNear);
+        return r;
+    }
+
+    static Mat4 lookAt(float eyeX, float eyeY, float eyeZ,
+                       float centerX, float centerY, float centerZ,
+                       float upX, float upY, float upZ)
+    {
+        float fx = centerX - eyeX, fy = centerY - eyeY, fz = centerZ - eyeZ;
+        float fl = std::sqrt(fx * fx + fy * fy + fz * fz);
+        if (fl > 0.0f) { fx /= fl; fy /= fl; fz /= fl; }
+
+        float sx = fy * upZ - fz * upY;
+        float sy = fz * upX - fx * upZ;
+        float sz = fx * upY - fy * upX;
+        float sl = std::sqrt(sx * sx + sy * sy + sz * sz);
+        if (sl > 0.0f) { sx /= sl; sy /= sl; sz /= sl; }
+
+        float ux = sy * fz - sz * fy;
+        float uy = sz * fx - sx * fz;
+        float uz = sx * fy - sy * fx;
+
+        Mat4 r = identity();
+        r.m[0] = sx;  r.m[4] = sy;  r.m[8] = sz;
+        r.m[1] = ux;  r.m[5] = uy;  r.m[9] = uz;
+        r.m[2] = -fx; r.m[6] = -fy; r.m[10] = -fz;
+        return r * translation(-eyeX, -eyeY, -eyeZ);
+    }
+
+    Mat4 operator*(const Mat4 &b) const
+    {
+        Mat4 r;
+        for (int col = 0; col < 4; ++col)
+        {
+            for (int row = 0; row < 4; ++row)
+            {
+                r.m[col * 4 + row] = m[0 * 4 + row] * b.m[col * 4 + 0] +
+                                     m[1 * 4 + row] * b.m[col * 4 + 1] +
+                                     m[2 * 4 + row] * b.m[col * 4 + 2] +
+                                     m[3 * 4 + row] * b.m[col * 4 + 3];
+            }
+        }
+        return r;
+    }
+
+    // Inversa transposta da parte 3x3 (matriz de normais), em ordem de coluna.
+    void normalMatrix(float out[9]) const
+    {
+        float a = m[0], b = m[4], c = m[8];
+        float d = m[1], e = m[5], f = m[9];
+        float g = m[2], h = m[6], i = m[10];
+
+        float A = e * i - f * h, B = -(d * i - f * g), C = d * h - e * g;
+        float D = -(b * i - c * h), E = a * i - c * g, F = -(a * h - b * g);
+        float G = b * f - c * e, H = -(a * f - c * d), I = a * e - b * d;
+
+        float det = a * A + b * B + c * C;
+        float inv = std::fabs(det) > 1e-12f ? 1.0f / det : 0.0f;
+
+        // (M^-1)^T = cofatores / det
+        out[0] = A * inv; out[3] = B * inv; out[6] = C * inv;
+        out[1] = D * inv; out[4] = E * inv; out[7] = F * inv;
+        out[2] = G * inv; out[5] = H * inv; out[8] = I * inv;
+    }
+
+    void transformPoint(float x, float y, float z, float out[4]) const
+    {
+        out[0] = m[0] * x + m[4] * y + m[8] * z + m[12];
+        out[1] = m[1] * x + m[5] * y + m[9] * z + m[13];
+        out[2] = m[2] * x + m[6] * y + m[10] * z + m[14];
+        out[3] = m[3] * x + m[7] * y + m[11] * z + m[15];
+    }
+};
+
+#endif
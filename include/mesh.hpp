@@ -6,207 +6,202 @@
 #include <sstream>
 #include <iostream>
 #include <string>
+#include "glState.hpp"
+#include "renderer.hpp"
 #include <algorithm>
 #include "data.hpp"
-
-struct Vertex
-{
-    float x, y, z;
-};
-
-struct Normal
-{
-    float nx, ny, nz;
-};
-
-struct TexCoord
-{
-    float u, v;
-};
+#include "objParser.hpp"
+#include "meshCache.hpp"
+#include "meshGeometry.hpp"
+#include "gltfParser.hpp"
+#include "qualityManager.hpp"
+#include <cmath>
 
 struct Mesh
 {
-    std::vector<Vertex> vertices;
-    std::vector<Normal> normals;
-    std::vector<TexCoord> texCoords;
-    std::vector<unsigned int> vertexIndices, normalIndices, texCoordIndices;
+    // Vértices soldados + um buffer de índices; vem do OBJ ou do cache mapeado.
+    MeshGeometry geometry;
+    // Modelo glTF/GLB: várias primitivas com material próprio, desenhadas pelos nós da cena.
+    GltfModel gltf;
+    bool uploadAttempted = false;
+    // Falso enquanto o arquivo é lido em segundo plano (AssetLoader): não desenha nada.
+    bool ready = true;
+    // A leitura em segundo plano deu erro: ready nunca vai virar verdadeiro.
+    bool failed = false;
+    // Erro máximo de um LOD na tela, em pixels da cena (já contando a escala de render).
+    static constexpr float LOD_PIXEL_ERROR = 1.0f;
 
     Translation translacao;
     Rotation rotacao;
     Scale escala;
     Color color;
     Material material;
+    GpuMesh gpu;
 
     bool loadOBJ(const char *caminho, const char *mtlPath = nullptr)
     {
-        std::ifstream arquivo(caminho);
-        if (!arquivo.is_open())
+        uploadAttempted = false;
+        MappedFile objFile, mtlFile;
+        if (!objFile.open(caminho))
         {
             std::cerr << "Erro ao abrir o arquivo: " << caminho << std::endl;
             return false;
         }
+        if (mtlPath && !mtlFile.open(mtlPath))
+        {
+            std::cerr << "Erro ao abrir o arquivo MTL: " << mtlPath << std::endl;
+            return false;
+        }
 
-        std::map<std::string, Material> materiais;
-
+        uint64_t sourceHash = MeshCache::hash(objFile.data(), objFile.size());
         if (mtlPath)
+            sourceHash = MeshCache::hash(mtlFile.data(), mtlFile.size(), sourceHash);
+
+        std::string cachePath = MeshCache::pathFor(caminho);
+        MeshCache::Entry cache;
+        if (MeshCache::load(cachePath.c_str(), sourceHash, cache))
         {
-            std::ifstream mtlArquivo(mtlPath);
-            if (!mtlArquivo.is_open())
-            {
-                std::cerr << "Erro ao abrir o arquivo MTL: " << mtlPath << std::endl;
-                return false;
-            }
-
-            std::string linha;
-            Material materialAtual;
-            std::string nomeMaterial;
-
-            while (std::getline(mtlArquivo, linha))
-            {
-                std::istringstream iss(linha);
-                std::string tipo;
-                iss >> tipo;
-                if (tipo == "newmtl")
-                {
-                    iss >> nomeMaterial;
-                    materiais[nomeMaterial] = materialAtual;
-                    materialAtual = Material();
-                }
-                else if (tipo == "Ka")
-                    iss >> materialAtual.ambient.r >> materialAtual.ambient.g >> materialAtual.ambient.b;
-                else if (tipo == "Kd")
-                    iss >> materialAtual.diffuse.r >> materialAtual.diffuse.g >> materialAtual.diffuse.b;
-                else if (tipo == "Ks")
-                    iss >> materialAtual.specular.r >> materialAtual.specular.g >> materialAtual.specular.b;
-                else if (tipo == "Ns")
-                    iss >> materialAtual.shininess;
-            }
+            if (cache.hasMaterial)
+                material = cache.material;
+            geometry.useCache(std::move(cache), caminho);
+            return true;
         }
 
-        std::string linha;
-        std::string materialName = "";
-        while (std::getline(arquivo, linha))
+        std::map<std::string, Material> materiais;
+        if (mtlPath)
+            ObjParser::parseMtl(mtlFile.data(), mtlFile.data() + mtlFile.size(), materiais);
+
+        ObjData obj;
+        if (!ObjParser::parse(objFile.data(), objFile.data() + objFile.size(), obj))
+            return false;
+        geometry.build(obj, caminho);
+
+        const Material *objMaterial = nullptr;
+        if (!obj.material.empty())
         {
-            std::istringstream iss(linha);
-            std::string tipo;
-            iss >> tipo;
-            if (tipo == "v")
-            {
-                Vertex v;
-                iss >> v.x >> v.y >> v.z;
-                vertices.push_back(v);
-            }
-            else if (tipo == "vn")
-            {
-                Normal n;
-                iss >> n.nx >> n.ny >> n.nz;
-                normals.push_back(n);
-            }
-            else if (tipo == "vt")
-            {
-                TexCoord t;
-                iss >> t.u >> t.v;
-                texCoords.push_back(t);
-            }
-            else if (tipo == "f")
-            {
-                std::string vertice_str;
-                std::vector<unsigned int> vi, ti, ni;
-
-                while (iss >> vertice_str)
-                {
-                    std::replace(vertice_str.begin(), vertice_str.end(), '/', ' ');
-                    std::istringstream viss(vertice_str);
-                    unsigned int v, t, n;
-                    viss >> v >> t >> n;
-                    vi.push_back(v - 1);
-                    ti.push_back(t - 1);
-                    ni.push_back(n - 1);
-                }
-
-                if (!materialName.empty())
-                {
-                    material = materiais[materialName];
-                }
-
-                for (size_t i = 1; i < vi.size() - 1; ++i)
-                {
-                    vertexIndices.push_back(vi[0]);
-                    vertexIndices.push_back(vi[i]);
-                    vertexIndices.push_back(vi[i + 1]);
-
-                    texCoordIndices.push_back(ti[0]);
-                    texCoordIndices.push_back(ti[i]);
-                    texCoordIndices.push_back(ti[i + 1]);
-
-                    normalIndices.push_back(ni[0]);
-                    normalIndices.push_back(ni[i]);
-                    normalIndices.push_back(ni[i + 1]);
-                }
-            }
-            else if (tipo == "usemtl")
-            {
-                iss >> materialName;
-            }
+            material = materiais[obj.material];
+            objMaterial = &material;
         }
+        unsigned int indexSize = geometry.indexType() == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+        if (!MeshCache::write(cachePath.c_str(), sourceHash, geometry.vertices(), geometry.vertexCount(),
+                              geometry.indices(), geometry.indexCount(), indexSize,
+                              geometry.lods(), geometry.lodCount(), geometry.boundsMin(), geometry.boundsMax(), objMaterial))
+            std::cerr << "Não foi possível gravar o cache da malha: " << cachePath << std::endl;
         return true;
     }
 
+    bool loadGLTF(const char *caminho)
+    {
+        uploadAttempted = false;
+        return GltfParser::load(caminho, gltf);
+    }
+
+    // Fica com a geometria e o material lidos em outro Mesh (no pool) e sobe para a GPU;
+    // posição, escala e cor continuam as deste.
+    void adoptGeometry(Mesh &&loaded)
+    {
+        geometry = std::move(loaded.geometry);
+        gltf = std::move(loaded.gltf);
+        material = loaded.material;
+        upload();
+        uploadAttempted = true;
+        ready = true;
+    }
+
+    // Tamanho do que vai para a GPU (orçamento de upload por frame); as mesmas malhas do upload().
+    size_t geometryBytes() const
+    {
+        size_t total = gltf.primitives.empty() ? geometry.uploadBytes() : 0;
+        for (const GltfPrimitive &primitive : gltf.primitives)
+            total += primitive.geometry.uploadBytes();
+        return total;
+    }
+
     void draw()
     {
+        if (!ready)
+            return;
+
         GLfloat prevAmbient[4], prevDiffuse[4], prevSpecular[4], prevShininess[1];
-        glGetMaterialfv(GL_FRONT, GL_AMBIENT, prevAmbient);
-        glGetMaterialfv(GL_FRONT, GL_DIFFUSE, prevDiffuse);
-        glGetMaterialfv(GL_FRONT, GL_SPECULAR, prevSpecular);
-        glGetMaterialfv(GL_FRONT, GL_SHININESS, prevShininess);
-
-        if (material.shininess > 0) {
-            GLfloat matAmbient[] = {material.ambient.r, material.ambient.g, material.ambient.b, 1.0f};
-            GLfloat matDiffuse[] = {material.diffuse.r, material.diffuse.g, material.diffuse.b, 1.0f};
-            GLfloat matSpecular[] = {material.specular.r, material.specular.g, material.specular.b, 1.0f};
-            GLfloat matShininess[] = {material.shininess};
-
-            glMaterialfv(GL_FRONT, GL_AMBIENT, matAmbient);
-            glMaterialfv(GL_FRONT, GL_DIFFUSE, matDiffuse);
-            glMaterialfv(GL_FRONT, GL_SPECULAR, matSpecular);
-            glMaterialfv(GL_FRONT, GL_SHININESS, matShininess);
-        }
+        GLState::getMaterial(GL_AMBIENT, prevAmbient);
+        GLState::getMaterial(GL_DIFFUSE, prevDiffuse);
+        GLState::getMaterial(GL_SPECULAR, prevSpecular);
+        GLState::getMaterial(GL_SHININESS, prevShininess);
+
+        applyMaterial(material);
 
-        glPushMatrix();
-        glTranslatef(translacao.x, translacao.y, translacao.z);
-        glRotatef(rotacao.angulo, rotacao.x, rotacao.y, rotacao.z);
-        glScalef(escala.x, escala.y, escala.z);
-        glColor3f(color.r, color.g, color.b);
+        GLState::pushMatrix();
+        GLState::translate(translacao.x, translacao.y, translacao.z);
+        GLState::rotate(rotacao.angulo, rotacao.x, rotacao.y, rotacao.z);
+        GLState::scale(escala.x, escala.y, escala.z);
+        GLState::color(color.r, color.g, color.b);
 
-        glBegin(GL_TRIANGLES);
-        for (size_t i = 0; i < vertexIndices.size(); ++i)
+        // Sobe uma vez (com ou sem shader); sem VBO no driver fica nos arrays da memória.
+        if (!uploadAttempted)
+        {
+            upload();
+            uploadAttempted = true;
+        }
+        if (gltf.instances.empty())
+            drawGeometry(geometry, gpu);
+        for (const GltfInstance &instance : gltf.instances)
         {
-            unsigned int vIndex = vertexIndices[i];
-            unsigned int nIndex = normalIndices.size() > i ? normalIndices[i] : 0;
-            unsigned int tIndex = texCoordIndices.size() > i ? texCoordIndices[i] : 0;
-
-            if (!normals.empty() && nIndex < normals.size()){
-                const Normal &n = normals[nIndex];
-                glNormal3f(n.nx, n.ny, n.nz);
-            }
-
-            if (!texCoords.empty() && tIndex < texCoords.size())
-            {
-                const TexCoord &t = texCoords[tIndex];
-                glTexCoord2f(t.u, t.v);
-            }
-
-            const Vertex &v = vertices[vIndex];
-            glVertex3f(v.x, v.y, v.z);
+            GltfPrimitive &primitive = gltf.primitives[instance.primitive];
+            applyMaterial(primitive.hasMaterial ? primitive.material : material);
+            GLState::pushMatrix();
+            GLState::multMatrix(instance.transform.m);
+            drawGeometry(primitive.geometry, primitive.gpu);
+            GLState::popMatrix();
+        }
+
+        GLState::material(GL_AMBIENT, prevAmbient);
+        GLState::material(GL_DIFFUSE, prevDiffuse);
+        GLState::material(GL_SPECULAR, prevSpecular);
+        GLState::material(GL_SHININESS, prevShininess);
+
+        GLState::popMatrix();
+    }
+
+    void applyMaterial(const Material &mat)
+    {
+        if (mat.shininess > 0) {
+            GLfloat matAmbient[] = {mat.ambient.r, mat.ambient.g, mat.ambient.b, 1.0f};
+            GLfloat matDiffuse[] = {mat.diffuse.r, mat.diffuse.g, mat.diffuse.b, 1.0f};
+            GLfloat matSpecular[] = {mat.specular.r, mat.specular.g, mat.specular.b, 1.0f};
+            GLfloat matShininess[] = {mat.shininess};
+
+            GLState::material(GL_AMBIENT, matAmbient);
+            GLState::material(GL_DIFFUSE, matDiffuse);
+            GLState::material(GL_SPECULAR, matSpecular);
+            GLState::material(GL_SHININESS, matShininess);
         }
-        glEnd();
+    }
 
-        glMaterialfv(GL_FRONT, GL_AMBIENT, prevAmbient);
-        glMaterialfv(GL_FRONT, GL_DIFFUSE, prevDiffuse);
-        glMaterialfv(GL_FRONT, GL_SPECULAR, prevSpecular);
-        glMaterialfv(GL_FRONT, GL_SHININESS, prevShininess);
+    // LOD pela projeção atual e uma chamada indexada (shader ou pipeline fixo).
+    void drawGeometry(const MeshGeometry &geo, GpuMesh &target)
+    {
+        float sceneHeight = glutGet(GLUT_WINDOW_HEIGHT) * QualityManager::settings().renderScale;
+        size_t lod = geo.chooseLod(GLState::modelview(), GLState::projection(), sceneHeight, LOD_PIXEL_ERROR);
+        if (Renderer::isActive())
+        {
+            geo.selectLod(target, lod);
+            Renderer::matchFixedFunction(color.r, color.g, color.b);
+            Renderer::draw(target);
+        }
+        else
+        {
+            geo.drawFixedFunction(target, lod);
+        }
+    }
 
-        glPopMatrix();
+    // Sobe direto dos dados atuais; vindo do cache ou de um GLB, o driver lê do próprio
+    // arquivo mapeado.
+    void upload()
+    {
+        if (gltf.primitives.empty())
+            geometry.upload(gpu);
+        for (GltfPrimitive &primitive : gltf.primitives)
+            primitive.geometry.upload(primitive.gpu);
     }
 
     void setTranslation(float x, float y, float z){
@@ -0,0 +1,158 @@
+#include "meshCache.hpp"
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+static const char MESH_CACHE_MAGIC[4] = {'M', 'S', 'H', 'C'};
+
+static uint64_t alignTo16(uint64_t offset)
+{
+    return (offset + 15) & ~uint64_t(15);
+}
+
+std::string MeshCache::pathFor(const char *sourcePath)
+{
+    return std::string(sourcePath) + ".meshcache";
+}
+
+uint64_t MeshCache::hash(const char *data, size_t size, uint64_t seed)
+{
+    // FNV-1a sobre palavras de 8 bytes (o byte a byte é lento para o modelo de 3 MB).
+    const uint64_t prime = 0x100000001b3ull;
+    uint64_t h = seed ^ size;
+    size_t words = size / 8;
+    for (size_t i = 0; i < words; ++i)
+    {
+        uint64_t word;
+        std::memcpy(&word, data + i * 8, 8);
+        h = (h ^ word) * prime;
+        h ^= h >> 29;
+    }
+    for (size_t i = words * 8; i < size; ++i)
+        h = (h ^ static_cast<unsigned char>(data[i])) * prime;
+    return h;
+}
+
+bool MeshCache::load(const char *cachePath, uint64_t sourceHash, Entry &out)
+{
+    MappedFile file;
+    if (!file.open(cachePath) || file.size() < sizeof(Header))
+        return false;
+
+    Header header;
+    std::memcpy(&header, file.data(), sizeof(Header));
+    if (std::memcmp(header.magic, MESH_CACHE_MAGIC, 4) != 0 || header.version != VERSION ||
+        header.sourceHash != sourceHash || header.vertexStride != sizeof(GpuVertex) ||
+        (header.indexSize != sizeof(uint16_t) && header.indexSize != sizeof(uint32_t)))
+        return false;
+
+    uint64_t vertexEnd = header.vertexOffset + uint64_t(header.vertexCount) * header.vertexStride;
+    uint64_t indexEnd = header.indexOffset + uint64_t(header.indexCount) * header.indexSize;
+    if (header.vertexOffset % 16 || header.indexOffset % 16 || vertexEnd > file.size() || indexEnd > file.size())
+        return false;
+
+    if (header.lodCount == 0 || header.lodCount > uint32_t(MeshOptimizer::MAX_LODS))
+        return false;
+    for (uint32_t i = 0; i < header.lodCount; ++i)
+        if (uint64_t(header.lods[i].firstIndex) + header.lods[i].indexCount > header.indexCount)
+            return false;
+
+    const char *indices = file.data() + header.indexOffset;
+    for (uint32_t i = 0; i < header.indexCount; ++i)
+    {
+        uint32_t index = header.indexSize == sizeof(uint16_t)
+                             ? reinterpret_cast<const uint16_t *>(indices)[i]
+                             : reinterpret_cast<const uint32_t *>(indices)[i];
+        if (index >= header.vertexCount)
+        {
+            std::cerr << "Cache de malha com índice inválido: " << cachePath << std::endl;
+            return false;
+        }
+    }
+
+    out.vertices = reinterpret_cast<const GpuVertex *>(file.data() + header.vertexOffset);
+    out.indices = indices;
+    out.indexSize = header.indexSize;
+
+    out.vertexCount = header.vertexCount;
+    out.indexCount = header.indexCount;
+    for (int k = 0; k < 3; ++k)
+    {
+        out.boundsMin[k] = header.boundsMin[k];
+        out.boundsMax[k] = header.boundsMax[k];
+    }
+    out.lodCount = header.lodCount;
+    for (uint32_t i = 0; i < header.lodCount; ++i)
+        out.lods[i] = header.lods[i];
+    out.hasMaterial = header.hasMaterial != 0;
+    out.material.ambient = {header.ambient[0], header.ambient[1], header.ambient[2]};
+    out.material.diffuse = {header.diffuse[0], header.diffuse[1], header.diffuse[2]};
+    out.material.specular = {header.specular[0], header.specular[1], header.specular[2]};
+    out.material.shininess = header.shininess;
+    out.file = std::move(file);
+    return true;
+}
+
+bool MeshCache::write(const char *cachePath, uint64_t sourceHash,
+                      const GpuVertex *vertices, size_t vertexCount,
+                      const void *indices, size_t indexCount, unsigned int indexSize,
+                      const MeshLod *lods, size_t lodCount,
+                      const float boundsMin[3], const float boundsMax[3],
+                      const Material *material)
+{
+    Header header = {};
+    std::memcpy(header.magic, MESH_CACHE_MAGIC, 4);
+    header.version = VERSION;
+    header.sourceHash = sourceHash;
+    header.vertexCount = static_cast<uint32_t>(vertexCount);
+    header.indexCount = static_cast<uint32_t>(indexCount);
+    header.vertexStride = sizeof(GpuVertex);
+    header.indexSize = indexSize;
+    header.vertexOffset = alignTo16(sizeof(Header));
+    header.indexOffset = alignTo16(header.vertexOffset + vertexCount * sizeof(GpuVertex));
+    header.lodCount = static_cast<uint32_t>(std::min<size_t>(lodCount, MeshOptimizer::MAX_LODS));
+    for (uint32_t i = 0; i < header.lodCount; ++i)
+        header.lods[i] = lods[i];
+    for (int k = 0; k < 3; ++k)
+    {
+        header.boundsMin[k] = boundsMin[k];
+        header.boundsMax[k] = boundsMax[k];
+    }
+    if (material)
+    {
+        header.hasMaterial = 1;
+        const Color *colors[3] = {&material->ambient, &material->diffuse, &material->specular};
+        float *targets[3] = {header.ambient, header.diffuse, header.specular};
+        for (int c = 0; c < 3; ++c)
+        {
+            targets[c][0] = colors[c]->r;
+            targets[c][1] = colors[c]->g;
+            targets[c][2] = colors[c]->b;
+        }
+        header.shininess = material->shininess;
+    }
+
+    // Grava em um temporário e troca no fim: um cache pela metade nunca fica com o nome certo.
+    std::string temporary = std::string(cachePath) + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out)
+            return false;
+        static const char padding[16] = {0};
+        out.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+        out.write(padding, header.vertexOffset - sizeof(Header));
+        out.write(reinterpret_cast<const char *>(vertices), vertexCount * sizeof(GpuVertex));
+        out.write(padding, header.indexOffset - (header.vertexOffset + vertexCount * sizeof(GpuVertex)));
+        out.write(reinterpret_cast<const char *>(indices), indexCount * indexSize);
+        if (!out)
+        {
+            out.close();
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+    std::remove(cachePath);
+    return std::rename(temporary.c_str(), cachePath) == 0;
+}
@@ -0,0 +1,76 @@
+#ifndef MESH_CACHE_HPP
+#define MESH_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "data.hpp"
+#include "gpuMesh.hpp"
+#include "mappedFile.hpp"
+#include "meshOptimizer.hpp"
+
+// Cache binário das malhas importadas, gravado ao lado do OBJ (<arquivo>.meshcache).
+// Layout: Header, bloco de vértices intercalados (GpuVertex, já soldados) e bloco de índices
+// de 16 ou 32 bits (indexSize), os dois alinhados em 16 bytes. Os LODs são faixas do mesmo
+// bloco de índices, descritas no header. O arquivo é mapeado e os ponteiros apontam direto para ele,
+// então o upload para a GPU lê do próprio mapeamento sem cópia intermediária.
+// O hash do conteúdo do OBJ (e do MTL) vai no header: mudou a fonte, o cache é ignorado.
+class MeshCache
+{
+public:
+    static const uint32_t VERSION = 3;
+
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+        uint64_t sourceHash;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint32_t vertexStride;
+        uint32_t indexSize;
+        uint64_t vertexOffset;
+        uint64_t indexOffset;
+        float boundsMin[3];
+        float boundsMax[3];
+        uint32_t hasMaterial;
+        float ambient[3];
+        float diffuse[3];
+        float specular[3];
+        float shininess;
+        uint32_t lodCount;
+        MeshLod lods[MeshOptimizer::MAX_LODS];
+    };
+
+    // Visão de um cache aberto; os ponteiros valem enquanto `file` estiver aberto.
+    struct Entry
+    {
+        MappedFile file;
+        const GpuVertex *vertices = nullptr;
+        const void *indices = nullptr;
+        unsigned int indexSize = sizeof(unsigned int);
+        size_t vertexCount = 0;
+        size_t indexCount = 0;
+        float boundsMin[3] = {0.0f, 0.0f, 0.0f};
+        float boundsMax[3] = {0.0f, 0.0f, 0.0f};
+        bool hasMaterial = false;
+        Material material = Material();
+        size_t lodCount = 0;
+        MeshLod lods[MeshOptimizer::MAX_LODS] = {};
+    };
+
+    static std::string pathFor(const char *sourcePath);
+    // Hash de conteúdo (64 bits); encadeia vários arquivos passando o anterior como seed.
+    static uint64_t hash(const char *data, size_t size, uint64_t seed = 0xcbf29ce484222325ull);
+
+    // false se não existe, está corrompido, é de outra versão ou de outra fonte.
+    static bool load(const char *cachePath, uint64_t sourceHash, Entry &out);
+    static bool write(const char *cachePath, uint64_t sourceHash,
+                      const GpuVertex *vertices, size_t vertexCount,
+                      const void *indices, size_t indexCount, unsigned int indexSize,
+                      const MeshLod *lods, size_t lodCount,
+                      const float boundsMin[3], const float boundsMax[3],
+                      const Material *material);
+};
+
+#endif
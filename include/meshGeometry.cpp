@@ -0,0 +1,267 @@
+#include "meshGeometry.hpp"
+#include "glState.hpp"
+#include "vertexPacking.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    inline size_t hashVertex(const GpuVertex &v)
+    {
+        uint32_t words[8];
+        std::memcpy(words, &v, sizeof(words));
+        uint64_t h = 0xcbf29ce484222325ull;
+        for (uint32_t w : words)
+            h = (h ^ w) * 0x100000001b3ull;
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+}
+
+void MeshGeometry::build(const ObjData &obj, const char *name)
+{
+    size_t corners = obj.vertexIndices.size() / 3 * 3;
+    vertexStorage.clear();
+    indexStorage32.clear();
+    indexStorage16.clear();
+    cache = MeshCache::Entry();
+    label = name;
+    vertexStorage.reserve(corners / 2 + 1);
+    indexStorage32.reserve(corners);
+
+    // Tabela aberta (potência de 2, sondagem linear) com índice + 1 do vértice; 0 é vazio.
+    // Compara o vértice inteiro: além das triplas v/t/n repetidas, junta também os cantos
+    // com normal de face de triângulos coplanares (quads do leque).
+    size_t tableSize = 16;
+    while (tableSize < corners * 2)
+        tableSize <<= 1;
+    std::vector<unsigned int> table(tableSize, 0);
+
+    for (size_t i = 0; i < corners; i += 3)
+    {
+        const Vertex *p[3];
+        for (int k = 0; k < 3; ++k)
+            p[k] = &obj.vertices[obj.vertexIndices[i + k]];
+        float ex = p[1]->x - p[0]->x, ey = p[1]->y - p[0]->y, ez = p[1]->z - p[0]->z;
+        float fx = p[2]->x - p[0]->x, fy = p[2]->y - p[0]->y, fz = p[2]->z - p[0]->z;
+        float face[3] = {ey * fz - ez * fy, ez * fx - ex * fz, ex * fy - ey * fx};
+        float length = std::sqrt(face[0] * face[0] + face[1] * face[1] + face[2] * face[2]);
+        if (length > 0.0f)
+            for (float &c : face)
+                c /= length;
+
+        for (int k = 0; k < 3; ++k)
+        {
+            unsigned int nIndex = obj.normalIndices[i + k];
+            unsigned int tIndex = obj.texCoordIndices[i + k];
+
+            GpuVertex gv = {};
+            gv.px = p[k]->x;
+            gv.py = p[k]->y;
+            gv.pz = p[k]->z;
+            if (nIndex < obj.normals.size())
+            {
+                gv.nx = obj.normals[nIndex].nx;
+                gv.ny = obj.normals[nIndex].ny;
+                gv.nz = obj.normals[nIndex].nz;
+            }
+            else
+            {
+                gv.nx = face[0];
+                gv.ny = face[1];
+                gv.nz = face[2];
+            }
+            if (tIndex < obj.texCoords.size())
+            {
+                gv.u = obj.texCoords[tIndex].u;
+                gv.v = obj.texCoords[tIndex].v;
+            }
+
+            size_t slot = hashVertex(gv) & (tableSize - 1);
+            while (table[slot] && std::memcmp(&vertexStorage[table[slot] - 1], &gv, sizeof(GpuVertex)) != 0)
+                slot = (slot + 1) & (tableSize - 1);
+            if (!table[slot])
+            {
+                vertexStorage.push_back(gv);
+                table[slot] = static_cast<unsigned int>(vertexStorage.size());
+            }
+            indexStorage32.push_back(table[slot] - 1);
+        }
+    }
+
+    MeshOptimizer::optimize(vertexStorage, indexStorage32, lodList, name);
+
+    vertexData = vertexStorage.data();
+    vertexTotal = vertexStorage.size();
+    indexTotal = indexStorage32.size();
+    if (vertexTotal <= 0xFFFF)
+    {
+        indexStorage16.assign(indexStorage32.begin(), indexStorage32.end());
+        std::vector<unsigned int>().swap(indexStorage32);
+        indexData = indexStorage16.data();
+        type = GL_UNSIGNED_SHORT;
+    }
+    else
+    {
+        indexData = indexStorage32.data();
+        type = GL_UNSIGNED_INT;
+    }
+    computeBounds();
+    VertexPacking::plan(vertexData, vertexTotal, packing);
+}
+
+void MeshGeometry::useCache(MeshCache::Entry &&entry, const char *name)
+{
+    label = name;
+    vertexStorage.clear();
+    indexStorage32.clear();
+    indexStorage16.clear();
+    cache = std::move(entry);
+    vertexData = cache.vertices;
+    indexData = cache.indices;
+    vertexTotal = cache.vertexCount;
+    indexTotal = cache.indexCount;
+    type = cache.indexSize == sizeof(GLushort) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    lodList.assign(cache.lods, cache.lods + cache.lodCount);
+    for (int c = 0; c < 3; ++c)
+    {
+        lo[c] = cache.boundsMin[c];
+        hi[c] = cache.boundsMax[c];
+    }
+    VertexPacking::plan(vertexData, vertexTotal, packing);
+}
+
+void MeshGeometry::useExternal(const GpuVertex *vertices, size_t vertexCount, const void *indices, size_t indexCount,
+                               GLenum indexType, const char *name)
+{
+    label = name;
+    vertexStorage.clear();
+    indexStorage32.clear();
+    indexStorage16.clear();
+    cache = MeshCache::Entry();
+    lodList.clear();
+    vertexData = vertices;
+    indexData = indices;
+    vertexTotal = vertexCount;
+    indexTotal = indexCount;
+    type = indexType;
+    computeBounds();
+    VertexPacking::plan(vertexData, vertexTotal, packing);
+}
+
+unsigned int MeshGeometry::index(size_t i) const
+{
+    if (type == GL_UNSIGNED_SHORT)
+        return static_cast<const GLushort *>(indexData)[i];
+    return static_cast<const unsigned int *>(indexData)[i];
+}
+
+void MeshGeometry::computeBounds()
+{
+    for (int c = 0; c < 3; ++c)
+        lo[c] = hi[c] = 0.0f;
+    for (size_t i = 0; i < vertexTotal; ++i)
+    {
+        const float position[3] = {vertexData[i].px, vertexData[i].py, vertexData[i].pz};
+        for (int c = 0; c < 3; ++c)
+        {
+            lo[c] = i == 0 ? position[c] : std::min(lo[c], position[c]);
+            hi[c] = i == 0 ? position[c] : std::max(hi[c], position[c]);
+        }
+    }
+}
+
+void MeshGeometry::upload(GpuMesh &gpu)
+{
+    if (packing.decided)
+        VertexPacking::upload(gpu, vertexData, vertexTotal, packing, indexData, indexTotal, type, label.c_str());
+    else
+        VertexPacking::upload(gpu, vertexData, vertexTotal, indexData, indexTotal, type, label.c_str());
+    packing = VertexPacking::Plan();
+}
+
+size_t MeshGeometry::uploadBytes() const
+{
+    size_t indexSize = type == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+    return vertexTotal * packing.stride() + indexTotal * indexSize;
+}
+
+size_t MeshGeometry::chooseLod(const Mat4 &modelView, const Mat4 &projection, float viewportHeight,
+                               float maxPixelError) const
+{
+    if (lodList.size() < 2)
+        return 0;
+
+    // Esfera da caixa: centro para o espaço da câmera, raio pela maior escala da modelview.
+    float center[3], radius = 0.0f;
+    for (int c = 0; c < 3; ++c)
+    {
+        center[c] = 0.5f * (lo[c] + hi[c]);
+        radius += 0.25f * (hi[c] - lo[c]) * (hi[c] - lo[c]);
+    }
+    radius = std::sqrt(radius);
+    const float *m = modelView.m;
+    float scale = 0.0f;
+    for (int column = 0; column < 3; ++column)
+        scale = std::max(scale, std::sqrt(m[column * 4] * m[column * 4] + m[column * 4 + 1] * m[column * 4 + 1] +
+                                          m[column * 4 + 2] * m[column * 4 + 2]));
+    float viewZ = m[2] * center[0] + m[6] * center[1] + m[10] * center[2] + m[14];
+
+    // Perspectiva: tamanho cai com a profundidade; ortográfica (mapa): constante.
+    float pixelsPerUnit = 0.5f * viewportHeight * projection.m[5];
+    if (projection.m[11] != 0.0f)
+    {
+        float depth = -viewZ - radius * scale;
+        if (depth <= 0.0f)
+            return 0;
+        pixelsPerUnit /= depth;
+    }
+    float radiusPixels = radius * scale * pixelsPerUnit;
+
+    size_t chosen = 0;
+    for (size_t i = 1; i < lodList.size(); ++i)
+        if (lodList[i].error * radiusPixels <= maxPixelError)
+            chosen = i;
+    return chosen;
+}
+
+MeshLod MeshGeometry::lodRange(size_t lod) const
+{
+    if (lodList.empty())
+        return {0, static_cast<uint32_t>(indexTotal), 0.0f};
+    return lodList[std::min(lod, lodList.size() - 1)];
+}
+
+void MeshGeometry::selectLod(GpuMesh &gpu, size_t lod) const
+{
+    MeshLod range = lodRange(lod);
+    gpu.setDrawRange(range.firstIndex, range.indexCount);
+}
+
+void MeshGeometry::drawFixedFunction(GpuMesh &gpu, size_t lod) const
+{
+    MeshLod range = lodRange(lod);
+    if (!gpu.isEmpty())
+    {
+        gpu.setDrawRange(range.firstIndex, range.indexCount);
+        gpu.drawFixedFunction();
+        return;
+    }
+    if (range.indexCount == 0)
+        return;
+
+    // Sem VBO (driver 1.1): os mesmos arrays direto da memória, ainda uma chamada só.
+    size_t indexSize = type == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(GpuVertex), &vertexData->px);
+    glNormalPointer(GL_FLOAT, sizeof(GpuVertex), &vertexData->nx);
+    glTexCoordPointer(2, GL_FLOAT, sizeof(GpuVertex), &vertexData->u);
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(range.indexCount), type,
+                   static_cast<const char *>(indexData) + range.firstIndex * indexSize);
+    GLState::forgetCurrent(GLState::CURRENT_NORMAL | GLState::CURRENT_TEXCOORD);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
@@ -0,0 +1,79 @@
+#ifndef MESH_GEOMETRY_HPP
+#define MESH_GEOMETRY_HPP
+
+#include <string>
+#include <vector>
+#include "gpuMesh.hpp"
+#include "matrix.hpp"
+#include "meshCache.hpp"
+#include "meshOptimizer.hpp"
+#include "objParser.hpp"
+#include "vertexPacking.hpp"
+
+// Geometria de um modelo importado: um vetor intercalado de vértices únicos
+// (posição, normal, uv) e um único buffer de índices, de 16 bits quando cabe.
+// Os dados ficam nos vetores próprios (vindos do OBJ), no cache mapeado ou num buffer
+// externo (glTF). Os LODs são faixas do mesmo buffer de índices sobre os mesmos vértices.
+class MeshGeometry
+{
+public:
+    // Solda cantos com o mesmo vértice final (posição, normal, uv); canto sem normal usa a da face.
+    // Em seguida passa pelo MeshOptimizer (ordem de cache, overdraw, LODs); name só vai no relatório.
+    void build(const ObjData &obj, const char *name);
+    // Passa a apontar para o cache aberto (fica com o mapeamento).
+    void useCache(MeshCache::Entry &&entry, const char *name);
+    // Aponta para vértices/índices já prontos (glTF); a memória é de quem chama e tem que
+    // viver tanto quanto a geometria. Sem LODs: o arquivo já vem como o artista exportou.
+    void useExternal(const GpuVertex *vertices, size_t vertexCount, const void *indices, size_t indexCount,
+                     GLenum indexType, const char *name);
+
+    // Sobe uma vez para VBO/IBO, no formato compacto quando dá (VertexPacking); sem buffers
+    // no driver fica vazio e o draw usa os arrays da memória. O pack já vem feito de
+    // build/useCache/useExternal e é liberado aqui.
+    void upload(GpuMesh &gpu);
+    // Bytes que o upload manda: stride do formato escolhido e índices de 16 ou 32 bits.
+    size_t uploadBytes() const;
+    // Faixa do LOD nos draws seguintes do GpuMesh (caminho com shader).
+    void selectLod(GpuMesh &gpu, size_t lod) const;
+    // Uma chamada indexada do LOD, pelo VBO quando existe.
+    void drawFixedFunction(GpuMesh &gpu, size_t lod) const;
+
+    // LOD mais simples cujo erro projetado fica abaixo de maxPixelError, com a matriz
+    // modelview/projeção atuais e a altura da viewport em pixels.
+    size_t chooseLod(const Mat4 &modelView, const Mat4 &projection, float viewportHeight,
+                     float maxPixelError) const;
+    const MeshLod *lods() const { return lodList.data(); }
+    size_t lodCount() const { return lodList.size(); }
+
+    const GpuVertex *vertices() const { return vertexData; }
+    const void *indices() const { return indexData; }
+    size_t vertexCount() const { return vertexTotal; }
+    size_t indexCount() const { return indexTotal; }
+    GLenum indexType() const { return type; }
+    unsigned int index(size_t i) const;
+    const float *boundsMin() const { return lo; }
+    const float *boundsMax() const { return hi; }
+    const MeshCache::Entry &cacheEntry() const { return cache; }
+
+private:
+    std::vector<GpuVertex> vertexStorage;
+    std::vector<unsigned int> indexStorage32;
+    std::vector<GLushort> indexStorage16;
+    MeshCache::Entry cache;
+    std::vector<MeshLod> lodList;
+    std::string label;
+    VertexPacking::Plan packing;
+
+    const GpuVertex *vertexData = nullptr;
+    const void *indexData = nullptr;
+    size_t vertexTotal = 0;
+    size_t indexTotal = 0;
+    GLenum type = GL_UNSIGNED_INT;
+    float lo[3] = {0.0f, 0.0f, 0.0f};
+    float hi[3] = {0.0f, 0.0f, 0.0f};
+
+    void computeBounds();
+    MeshLod lodRange(size_t lod) const;
+};
+
+#endif
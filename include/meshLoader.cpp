@@ -1,8 +1,11 @@
 #include "meshLoader.hpp"
 #include "mesh.hpp"
 #include "data.hpp"
+#include "assetLoader.hpp"
+#include <memory>
+#include <string>
 
-bool MeshLoader::loadModel(const char *caminhoObj, const char *caminhoMtl, 
+int MeshLoader::loadModel(const char *caminhoObj, const char *caminhoMtl, 
                            Translation trans, Rotation rot, Scale esc,
                            Color modeloColor, Color ambientColor, Color diffuseColor,
                            Color specularColor, float shininess, ModelType tipoArquivo)
@@ -21,35 +24,52 @@ bool MeshLoader::loadModel(const char *caminhoObj, const char *caminhoMtl,
 
     modelo.setMaterial(material);
 
-    bool carregado = false;
-
-    switch (tipoArquivo)
-    {
-    case ModelType::OBJ:
-        if (caminhoObj != nullptr) {
-            carregado = modelo.loadOBJ(caminhoObj, caminhoMtl);
-        }else{
-            std::cerr << "Caminho do arquivo OBJ não fornecido!" << std::endl;
-            return false;
-        }
-        break;
-    case ModelType::GLB:
-        break;
-    case ModelType::GLTF:
-        break;
-    case ModelType::CUSTOM:
-        break;
-    default:
+    if (tipoArquivo != ModelType::OBJ && tipoArquivo != ModelType::GLB && tipoArquivo != ModelType::GLTF) {
         std::cerr << "Tipo de arquivo não suportado!" << std::endl;
-        return false;
+        return -1;
     }
-
-    if (carregado){
-        modelos.push_back(std::move(modelo));
-        return true;
+    if (caminhoObj == nullptr) {
+        std::cerr << (tipoArquivo == ModelType::OBJ ? "Caminho do arquivo OBJ não fornecido!"
+                                                    : "Caminho do arquivo glTF não fornecido!") << std::endl;
+        return -1;
     }
 
-    return false;
+    // O id já fica reservado (os update*ById continuam valendo); a leitura vai para o pool
+    // e o modelo aparece no frame em que a geometria sobe.
+    size_t id = modelos.size();
+    modelo.ready = false;
+    modelos.push_back(std::move(modelo));
+
+    std::string caminho(caminhoObj);
+    std::string mtl(caminhoMtl ? caminhoMtl : "");
+    AssetLoader::enqueue([this, id, caminho, mtl, material, tipoArquivo]() {
+        std::shared_ptr<Mesh> lido = std::make_shared<Mesh>();
+        lido->setMaterial(material);
+        bool carregado = tipoArquivo == ModelType::OBJ
+                             ? lido->loadOBJ(caminho.c_str(), mtl.empty() ? nullptr : mtl.c_str())
+                             : lido->loadGLTF(caminho.c_str());
+        if (!carregado)
+        {
+            // O slot é do thread principal: a marca de falha vai pela mesma fila do upload.
+            std::cerr << "Falha ao carregar o modelo: " << caminho << std::endl;
+            AssetLoader::upload(0, [this, id]() { modelos[id].failed = true; });
+            return;
+        }
+        AssetLoader::upload(lido->geometryBytes(), [this, id, lido]() {
+            modelos[id].adoptGeometry(std::move(*lido));
+        });
+    });
+    return static_cast<int>(id);
+}
+
+bool MeshLoader::isLoading(int id) const
+{
+    return id >= 0 && id < static_cast<int>(modelos.size()) && !modelos[id].ready && !modelos[id].failed;
+}
+
+bool MeshLoader::hasFailed(int id) const
+{
+    return id >= 0 && id < static_cast<int>(modelos.size()) && modelos[id].failed;
 }
 void MeshLoader::drawAll(){
     for (auto &modelo : modelos){
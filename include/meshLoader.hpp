@@ -9,7 +9,11 @@ class MeshLoader
 public:
     std::vector<Mesh> modelos;
 
-    bool loadModel(const char *caminhoObj, const char *caminhoMtl, Translation trans, Rotation rot, Scale esc, Color modeloColor, Color ambientColor, Color diffuseColor, Color specularColor, float shininess, ModelType tipoArquivo);
+    // Reserva o modelo e lê o arquivo em segundo plano. Devolve o id (para os *ById e
+    // isLoading/hasFailed) ou -1 quando o pedido é recusado antes de ler qualquer coisa.
+    int loadModel(const char *caminhoObj, const char *caminhoMtl, Translation trans, Rotation rot, Scale esc, Color modeloColor, Color ambientColor, Color diffuseColor, Color specularColor, float shininess, ModelType tipoArquivo);
+    bool isLoading(int id) const;
+    bool hasFailed(int id) const;
     void drawAll();
     void drawForId(int id);
     void updateModelTranslationXById(int id, float x);
@@ -0,0 +1,663 @@
+#include "meshOptimizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+const float MeshOptimizer::MAX_LOD_ERROR = 0.05f;
+
+namespace
+{
+    struct Vec3d
+    {
+        double x, y, z;
+    };
+
+    inline Vec3d toVec3(const GpuVertex &v) { return {v.px, v.py, v.pz}; }
+    inline Vec3d sub(const Vec3d &a, const Vec3d &b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+    inline double dot(const Vec3d &a, const Vec3d &b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    inline Vec3d cross(const Vec3d &a, const Vec3d &b)
+    {
+        return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+    }
+
+    // Quádrica simétrica (A, b, c) da soma dos planos, com o peso (área) acumulado.
+    struct Quadric
+    {
+        double a00, a01, a02, a11, a12, a22;
+        double b0, b1, b2;
+        double c;
+        double weight;
+
+        void addPlane(const Vec3d &n, double d, double w)
+        {
+            a00 += w * n.x * n.x;
+            a01 += w * n.x * n.y;
+            a02 += w * n.x * n.z;
+            a11 += w * n.y * n.y;
+            a12 += w * n.y * n.z;
+            a22 += w * n.z * n.z;
+            b0 += w * n.x * d;
+            b1 += w * n.y * d;
+            b2 += w * n.z * d;
+            c += w * d * d;
+            weight += w;
+        }
+
+        void add(const Quadric &o)
+        {
+            a00 += o.a00; a01 += o.a01; a02 += o.a02;
+            a11 += o.a11; a12 += o.a12; a22 += o.a22;
+            b0 += o.b0; b1 += o.b1; b2 += o.b2;
+            c += o.c;
+            weight += o.weight;
+        }
+
+        // Distância quadrática média aos planos.
+        double error(const Vec3d &p) const
+        {
+            if (weight <= 0.0)
+                return 0.0;
+            double q = a00 * p.x * p.x + a11 * p.y * p.y + a22 * p.z * p.z +
+                       2.0 * (a01 * p.x * p.y + a02 * p.x * p.z + a12 * p.y * p.z) +
+                       2.0 * (b0 * p.x + b1 * p.y + b2 * p.z) + c;
+            return std::max(0.0, q / weight);
+        }
+    };
+
+    // Posições iguais viram um id só (vértices soldados ainda se repetem nas costuras de uv/normal).
+    size_t weldPositions(const GpuVertex *vertices, size_t vertexCount, std::vector<unsigned int> &positionOf)
+    {
+        size_t tableSize = 16;
+        while (tableSize < vertexCount * 2)
+            tableSize <<= 1;
+        std::vector<unsigned int> table(tableSize, 0);
+        positionOf.assign(vertexCount, 0);
+        size_t count = 0;
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            uint32_t words[3];
+            std::memcpy(words, &vertices[i].px, sizeof(words));
+            uint64_t h = 0xcbf29ce484222325ull;
+            for (uint32_t w : words)
+                h = (h ^ w) * 0x100000001b3ull;
+            size_t slot = static_cast<size_t>(h ^ (h >> 32)) & (tableSize - 1);
+            while (table[slot] && std::memcmp(&vertices[table[slot] - 1].px, &vertices[i].px, sizeof(words)) != 0)
+                slot = (slot + 1) & (tableSize - 1);
+            if (table[slot])
+            {
+                positionOf[i] = positionOf[table[slot] - 1];
+                continue;
+            }
+            table[slot] = static_cast<unsigned int>(i + 1);
+            positionOf[i] = static_cast<unsigned int>(count++);
+        }
+        return count;
+    }
+}
+
+MeshOptimizer::Stats MeshOptimizer::analyze(const unsigned int *indices, size_t indexCount, size_t vertexCount,
+                                            unsigned int cacheSize)
+{
+    // FIFO: o vértice está no cache se entrou há menos de cacheSize faltas.
+    std::vector<unsigned int> stamp(vertexCount, 0);
+    unsigned int clock = cacheSize + 1;
+    size_t misses = 0, unique = 0;
+    for (size_t i = 0; i < indexCount; ++i)
+    {
+        unsigned int v = indices[i];
+        if (stamp[v] == 0)
+            ++unique;
+        if (clock - stamp[v] > cacheSize)
+        {
+            stamp[v] = clock++;
+            ++misses;
+        }
+    }
+    Stats stats;
+    stats.triangles = indexCount / 3;
+    stats.acmr = stats.triangles ? static_cast<float>(misses) / stats.triangles : 0.0f;
+    stats.atvr = unique ? static_cast<float>(misses) / unique : 0.0f;
+    return stats;
+}
+
+void MeshOptimizer::optimizeVertexCache(unsigned int *indices, size_t indexCount, size_t vertexCount)
+{
+    size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0)
+        return;
+
+    // Pontuação de Forsyth: posição no cache LRU + bônus para vértice com poucos triângulos restantes.
+    const int CACHE = FORSYTH_CACHE;
+    const int MAX_VALENCE = 32;
+    float cacheScore[CACHE];
+    for (int i = 0; i < CACHE; ++i)
+        cacheScore[i] = i < 3 ? 0.75f : std::pow(1.0f - float(i - 3) / (CACHE - 3), 1.5f);
+    float valenceScore[MAX_VALENCE + 1];
+    valenceScore[0] = 0.0f;
+    for (int i = 1; i <= MAX_VALENCE; ++i)
+        valenceScore[i] = 2.0f / std::sqrt(float(i));
+    auto score = [&](int cachePosition, unsigned int valence) {
+        if (valence == 0)
+            return -1.0f;
+        float s = cachePosition >= 0 ? cacheScore[cachePosition] : 0.0f;
+        return s + valenceScore[std::min<unsigned int>(valence, MAX_VALENCE)];
+    };
+
+    // Triângulos de cada vértice (CSR); live[v] conta os ainda não emitidos no começo da faixa.
+    std::vector<unsigned int> offsets(vertexCount + 1, 0), live(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i)
+        ++live[indices[i]];
+    for (size_t v = 0; v < vertexCount; ++v)
+        offsets[v + 1] = offsets[v] + live[v];
+    std::vector<unsigned int> adjacency(offsets[vertexCount]);
+    {
+        std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t)
+            for (int k = 0; k < 3; ++k)
+                adjacency[fill[indices[t * 3 + k]]++] = static_cast<unsigned int>(t);
+    }
+
+    std::vector<float> vertexScore(vertexCount), triangleScore(triangleCount, 0.0f);
+    for (size_t v = 0; v < vertexCount; ++v)
+        vertexScore[v] = score(-1, live[v]);
+    for (size_t t = 0; t < triangleCount; ++t)
+        for (int k = 0; k < 3; ++k)
+            triangleScore[t] += vertexScore[indices[t * 3 + k]];
+
+    std::vector<unsigned int> source(indices, indices + triangleCount * 3);
+    std::vector<char> emitted(triangleCount, 0);
+    std::vector<unsigned int> cache, nextCache;
+    cache.reserve(CACHE + 3);
+    nextCache.reserve(CACHE + 3);
+
+    size_t best = 0;
+    for (size_t t = 1; t < triangleCount; ++t)
+        if (triangleScore[t] > triangleScore[best])
+            best = t;
+    size_t scan = 0;
+
+    for (size_t out = 0; out < triangleCount; ++out)
+    {
+        if (best == triangleCount)
+        {
+            // Nada adjacente ao cache: segue para o próximo triângulo ainda não emitido.
+            while (emitted[scan])
+                ++scan;
+            best = scan;
+        }
+
+        const unsigned int *tri = &source[best * 3];
+        emitted[best] = 1;
+        for (int k = 0; k < 3; ++k)
+        {
+            unsigned int v = tri[k];
+            indices[out * 3 + k] = v;
+            unsigned int *list = &adjacency[offsets[v]];
+            for (unsigned int i = 0; i < live[v]; ++i)
+            {
+                if (list[i] == best)
+                {
+                    list[i] = list[live[v] - 1];
+                    --live[v];
+                    break;
+                }
+            }
+        }
+
+        nextCache.assign(tri, tri + 3);
+        for (unsigned int v : cache)
+            if (v != tri[0] && v != tri[1] && v != tri[2])
+                nextCache.push_back(v);
+
+        best = triangleCount;
+        float bestScore = -1.0f;
+        for (size_t i = 0; i < nextCache.size(); ++i)
+        {
+            unsigned int v = nextCache[i];
+            int position = i < size_t(CACHE) ? static_cast<int>(i) : -1;
+            float updated = score(position, live[v]);
+            float delta = updated - vertexScore[v];
+            vertexScore[v] = updated;
+            const unsigned int *list = &adjacency[offsets[v]];
+            for (unsigned int j = 0; j < live[v]; ++j)
+            {
+                float &s = triangleScore[list[j]];
+                s += delta;
+                if (s > bestScore)
+                {
+                    bestScore = s;
+                    best = list[j];
+                }
+            }
+        }
+        if (nextCache.size() > size_t(CACHE))
+            nextCache.resize(CACHE);
+        cache.swap(nextCache);
+    }
+}
+
+void MeshOptimizer::optimizeOverdraw(unsigned int *indices, size_t indexCount, const GpuVertex *vertices,
+                                     size_t vertexCount, float threshold)
+{
+    size_t triangleCount = indexCount / 3;
+    if (triangleCount < 2)
+        return;
+
+    // Grupos começam onde o cache FIFO perde os três vértices: reordenar grupos inteiros
+    // quase não muda o ACMR. Cada grupo é ordenado pelo quanto olha para fora da malha
+    // (centro e normal médios), assim as faces externas desenham antes e escondem as de dentro.
+    Stats before = analyze(indices, indexCount, vertexCount);
+    std::vector<unsigned int> stamp(vertexCount, 0);
+    unsigned int clock = FIFO_SIZE + 1;
+    std::vector<size_t> clusterStart;
+    for (size_t t = 0; t < triangleCount; ++t)
+    {
+        int misses = 0;
+        for (int k = 0; k < 3; ++k)
+        {
+            unsigned int v = indices[t * 3 + k];
+            if (clock - stamp[v] > FIFO_SIZE)
+            {
+                stamp[v] = clock++;
+                ++misses;
+            }
+        }
+        if (t == 0 || misses == 3)
+            clusterStart.push_back(t);
+    }
+    clusterStart.push_back(triangleCount);
+    size_t clusterCount = clusterStart.size() - 1;
+    if (clusterCount < 2)
+        return;
+
+    Vec3d meshCenter = {0.0, 0.0, 0.0};
+    double meshArea = 0.0;
+    std::vector<Vec3d> clusterCenter(clusterCount), clusterNormal(clusterCount);
+    for (size_t c = 0; c < clusterCount; ++c)
+    {
+        Vec3d center = {0.0, 0.0, 0.0}, normal = {0.0, 0.0, 0.0};
+        double area = 0.0;
+        for (size_t t = clusterStart[c]; t < clusterStart[c + 1]; ++t)
+        {
+            Vec3d a = toVec3(vertices[indices[t * 3]]);
+            Vec3d b = toVec3(vertices[indices[t * 3 + 1]]);
+            Vec3d d = toVec3(vertices[indices[t * 3 + 2]]);
+            Vec3d n = cross(sub(b, a), sub(d, a));
+            double w = std::sqrt(dot(n, n)) * 0.5;
+            center.x += (a.x + b.x + d.x) * w / 3.0;
+            center.y += (a.y + b.y + d.y) * w / 3.0;
+            center.z += (a.z + b.z + d.z) * w / 3.0;
+            normal.x += n.x;
+            normal.y += n.y;
+            normal.z += n.z;
+            area += w;
+        }
+        meshCenter.x += center.x;
+        meshCenter.y += center.y;
+        meshCenter.z += center.z;
+        meshArea += area;
+        if (area > 0.0)
+            center = {center.x / area, center.y / area, center.z / area};
+        clusterCenter[c] = center;
+        clusterNormal[c] = normal;
+    }
+    if (meshArea <= 0.0)
+        return;
+    meshCenter = {meshCenter.x / meshArea, meshCenter.y / meshArea, meshCenter.z / meshArea};
+
+    std::vector<double> sortKey(clusterCount);
+    std::vector<size_t> order(clusterCount);
+    for (size_t c = 0; c < clusterCount; ++c)
+    {
+        double length = std::sqrt(dot(clusterNormal[c], clusterNormal[c]));
+        sortKey[c] = length > 0.0 ? dot(sub(clusterCenter[c], meshCenter), clusterNormal[c]) / length : 0.0;
+        order[c] = c;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sortKey[a] > sortKey[b]; });
+
+    std::vector<unsigned int> sorted;
+    sorted.reserve(triangleCount * 3);
+    for (size_t c : order)
+        sorted.insert(sorted.end(), indices + clusterStart[c] * 3, indices + clusterStart[c + 1] * 3);
+
+    Stats after = analyze(sorted.data(), sorted.size(), vertexCount);
+    if (after.acmr <= before.acmr * threshold)
+        std::copy(sorted.begin(), sorted.end(), indices);
+}
+
+void MeshOptimizer::optimizeVertexFetch(std::vector<GpuVertex> &vertices, std::vector<unsigned int> &indices)
+{
+    // Vértices na ordem em que os índices os pedem: leitura sequencial do VBO.
+    const unsigned int UNUSED = 0xFFFFFFFFu;
+    std::vector<unsigned int> remap(vertices.size(), UNUSED);
+    std::vector<GpuVertex> reordered;
+    reordered.reserve(vertices.size());
+    for (unsigned int &index : indices)
+    {
+        if (remap[index] == UNUSED)
+        {
+            remap[index] = static_cast<unsigned int>(reordered.size());
+            reordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices.swap(reordered);
+}
+
+std::vector<unsigned int> MeshOptimizer::simplify(const unsigned int *indices, size_t indexCount,
+                                                  const GpuVertex *vertices, size_t vertexCount,
+                                                  size_t targetIndexCount, float maxError, float *resultError)
+{
+    size_t triangleCount = indexCount / 3;
+    std::vector<unsigned int> tris(indices, indices + triangleCount * 3);
+    if (resultError)
+        *resultError = 0.0f;
+
+    // A topologia é por posição; os índices dos triângulos continuam sendo os vértices com atributos.
+    std::vector<unsigned int> positionOf;
+    size_t positionCount = weldPositions(vertices, vertexCount, positionOf);
+    std::vector<Vec3d> position(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v)
+        position[positionOf[v]] = toVec3(vertices[v]);
+    auto pos = [&](unsigned int wedge) -> const Vec3d & { return position[positionOf[wedge]]; };
+
+    Vec3d lo = pos(tris.empty() ? 0 : tris[0]), hi = lo;
+    for (unsigned int w : tris)
+    {
+        const Vec3d &p = pos(w);
+        lo = {std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z)};
+        hi = {std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z)};
+    }
+    Vec3d diagonal = sub(hi, lo);
+    double radius = 0.5 * std::sqrt(dot(diagonal, diagonal));
+    if (triangleCount == 0 || radius <= 0.0)
+        return tris;
+    double maxCost = (maxError * radius) * (maxError * radius);
+
+    std::vector<std::vector<unsigned int>> adjacency(positionCount);
+    std::vector<Quadric> quadrics(positionCount, Quadric());
+    std::vector<char> alive(triangleCount, 1);
+    for (size_t t = 0; t < triangleCount; ++t)
+    {
+        const Vec3d &a = pos(tris[t * 3]), &b = pos(tris[t * 3 + 1]), &c = pos(tris[t * 3 + 2]);
+        Vec3d n = cross(sub(b, a), sub(c, a));
+        double length = std::sqrt(dot(n, n));
+        if (length > 0.0)
+        {
+            n = {n.x / length, n.y / length, n.z / length};
+            for (int k = 0; k < 3; ++k)
+                quadrics[positionOf[tris[t * 3 + k]]].addPlane(n, -dot(n, a), length * 0.5);
+        }
+        for (int k = 0; k < 3; ++k)
+            adjacency[positionOf[tris[t * 3 + k]]].push_back(static_cast<unsigned int>(t));
+    }
+
+    // Bordas (aresta com um triângulo) só andam ao longo da própria borda, com um plano
+    // perpendicular na quádrica para não encolher o contorno; aresta com mais de dois
+    // triângulos trava as pontas.
+    std::vector<char> border(positionCount, 0), locked(positionCount, 0);
+    {
+        std::vector<std::pair<uint64_t, unsigned int>> edges;
+        edges.reserve(triangleCount * 3);
+        for (size_t t = 0; t < triangleCount; ++t)
+            for (int k = 0; k < 3; ++k)
+            {
+                uint64_t a = positionOf[tris[t * 3 + k]], b = positionOf[tris[t * 3 + (k + 1) % 3]];
+                edges.push_back({std::min(a, b) << 32 | std::max(a, b), static_cast<unsigned int>(t * 3 + k)});
+            }
+        std::sort(edges.begin(), edges.end());
+        for (size_t i = 0; i < edges.size();)
+        {
+            size_t j = i;
+            while (j < edges.size() && edges[j].first == edges[i].first)
+                ++j;
+            unsigned int a = static_cast<unsigned int>(edges[i].first >> 32);
+            unsigned int b = static_cast<unsigned int>(edges[i].first & 0xFFFFFFFFu);
+            if (j - i == 1 && a != b)
+            {
+                border[a] = border[b] = 1;
+                size_t corner = edges[i].second, t = corner / 3;
+                const Vec3d &pa = pos(tris[corner]), &pb = pos(tris[t * 3 + (corner % 3 + 1) % 3]);
+                const Vec3d &pc = pos(tris[t * 3 + (corner % 3 + 2) % 3]);
+                Vec3d edge = sub(pb, pa);
+                Vec3d n = cross(edge, cross(edge, sub(pc, pa)));
+                double length = std::sqrt(dot(n, n));
+                if (length > 0.0)
+                {
+                    n = {n.x / length, n.y / length, n.z / length};
+                    double w = dot(edge, edge);
+                    quadrics[a].addPlane(n, -dot(n, pa), w);
+                    quadrics[b].addPlane(n, -dot(n, pa), w);
+                }
+            }
+            else if (j - i > 2)
+            {
+                locked[a] = locked[b] = 1;
+            }
+            i = j;
+        }
+    }
+
+    struct Candidate
+    {
+        double cost;
+        unsigned int from, to;
+        bool operator<(const Candidate &o) const { return cost < o.cost; }
+    };
+    std::vector<Candidate> candidates;
+    std::vector<char> touched(positionCount, 0), removed(positionCount, 0);
+    std::vector<unsigned int> aroundFrom, aroundTo, ringMark(positionCount, 0);
+    std::vector<std::pair<unsigned int, unsigned int>> wedgeMap;
+    unsigned int ringStamp = 0;
+    size_t liveTriangles = triangleCount;
+    double appliedCost = 0.0;
+    size_t targetTriangles = targetIndexCount / 3;
+
+    auto liveAround = [&](unsigned int p, std::vector<unsigned int> &out) {
+        std::vector<unsigned int> &list = adjacency[p];
+        size_t kept = 0;
+        for (unsigned int t : list)
+            if (alive[t])
+                list[kept++] = t;
+        list.resize(kept);
+        out = list;
+    };
+    auto contains = [&](size_t t, unsigned int p) {
+        return positionOf[tris[t * 3]] == p || positionOf[tris[t * 3 + 1]] == p || positionOf[tris[t * 3 + 2]] == p;
+    };
+
+    while (liveTriangles > targetTriangles)
+    {
+        candidates.clear();
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            if (!alive[t])
+                continue;
+            for (int k = 0; k < 3; ++k)
+            {
+                unsigned int from = positionOf[tris[t * 3 + k]], to = positionOf[tris[t * 3 + (k + 1) % 3]];
+                for (int dir = 0; dir < 2; ++dir, std::swap(from, to))
+                {
+                    if (locked[from] || (border[from] && !border[to]))
+                        continue;
+                    double cost = quadrics[from].error(position[to]);
+                    if (cost <= maxCost)
+                        candidates.push_back({cost, from, to});
+                }
+            }
+        }
+        if (candidates.empty())
+            break;
+        std::sort(candidates.begin(), candidates.end());
+
+        // Cada colapso tira cerca de dois triângulos; por passada só vértices ainda não mexidos.
+        size_t wanted = std::max<size_t>(1, (liveTriangles - targetTriangles + 1) / 2);
+        size_t collapses = 0;
+        std::fill(touched.begin(), touched.end(), 0);
+        for (const Candidate &candidate : candidates)
+        {
+            if (collapses >= wanted)
+                break;
+            unsigned int from = candidate.from, to = candidate.to;
+            if (touched[from] || touched[to] || removed[from] || removed[to])
+                continue;
+
+            liveAround(from, aroundFrom);
+            liveAround(to, aroundTo);
+            size_t shared = 0;
+            for (unsigned int t : aroundFrom)
+                shared += contains(t, to);
+            if (shared != (border[from] ? 1u : 2u))
+                continue;
+
+            // Anel em comum só pode ser o dos triângulos da aresta (senão a malha dobra).
+            ++ringStamp;
+            size_t common = 0;
+            for (unsigned int t : aroundFrom)
+                for (int k = 0; k < 3; ++k)
+                    ringMark[positionOf[tris[t * 3 + k]]] = ringStamp;
+            for (unsigned int t : aroundTo)
+                for (int k = 0; k < 3; ++k)
+                {
+                    unsigned int p = positionOf[tris[t * 3 + k]];
+                    if (p != from && p != to && ringMark[p] == ringStamp)
+                    {
+                        ringMark[p] = 0;
+                        ++common;
+                    }
+                }
+            if (common != shared)
+                continue;
+
+            // Cada vértice (com atributos) de `from` precisa de um único par em `to`:
+            // é assim que as costuras de uv/normal continuam fechadas.
+            wedgeMap.clear();
+            bool valid = true;
+            for (unsigned int t : aroundFrom)
+            {
+                if (!contains(t, to))
+                    continue;
+                unsigned int wedgeFrom = 0, wedgeTo = 0;
+                for (int k = 0; k < 3; ++k)
+                {
+                    unsigned int w = tris[t * 3 + k];
+                    if (positionOf[w] == from)
+                        wedgeFrom = w;
+                    else if (positionOf[w] == to)
+                        wedgeTo = w;
+                }
+                for (const auto &pair : wedgeMap)
+                    if (pair.first == wedgeFrom && pair.second != wedgeTo)
+                        valid = false;
+                wedgeMap.push_back({wedgeFrom, wedgeTo});
+            }
+            for (size_t i = 0; valid && i < aroundFrom.size(); ++i)
+            {
+                size_t t = aroundFrom[i];
+                if (contains(t, to))
+                    continue;
+                Vec3d before[3], after[3];
+                bool mapped = false;
+                for (int k = 0; k < 3; ++k)
+                {
+                    unsigned int w = tris[t * 3 + k];
+                    before[k] = after[k] = pos(w);
+                    if (positionOf[w] == from)
+                    {
+                        after[k] = position[to];
+                        for (const auto &pair : wedgeMap)
+                            mapped = mapped || pair.first == w;
+                    }
+                }
+                Vec3d n0 = cross(sub(before[1], before[0]), sub(before[2], before[0]));
+                Vec3d n1 = cross(sub(after[1], after[0]), sub(after[2], after[0]));
+                valid = mapped && dot(n0, n1) > 0.0;
+            }
+            if (!valid)
+                continue;
+
+            for (unsigned int t : aroundFrom)
+            {
+                if (contains(t, to))
+                {
+                    alive[t] = 0;
+                    --liveTriangles;
+                    continue;
+                }
+                for (int k = 0; k < 3; ++k)
+                {
+                    unsigned int &w = tris[t * 3 + k];
+                    if (positionOf[w] == from)
+                        for (const auto &pair : wedgeMap)
+                            if (pair.first == w)
+                            {
+                                w = pair.second;
+                                break;
+                            }
+                }
+                adjacency[to].push_back(t);
+            }
+            adjacency[from].clear();
+            quadrics[to].add(quadrics[from]);
+            removed[from] = 1;
+            touched[from] = touched[to] = 1;
+            appliedCost = std::max(appliedCost, candidate.cost);
+            ++collapses;
+        }
+        if (collapses == 0)
+            break;
+    }
+
+    std::vector<unsigned int> result;
+    result.reserve(liveTriangles * 3);
+    for (size_t t = 0; t < triangleCount; ++t)
+        if (alive[t])
+            result.insert(result.end(), &tris[t * 3], &tris[t * 3] + 3);
+    if (resultError)
+        *resultError = static_cast<float>(std::sqrt(appliedCost) / radius);
+    return result;
+}
+
+void MeshOptimizer::optimize(std::vector<GpuVertex> &vertices, std::vector<unsigned int> &indices,
+                             std::vector<MeshLod> &lods, const char *name)
+{
+    lods.clear();
+    size_t baseCount = indices.size() / 3 * 3;
+    indices.resize(baseCount);
+    if (baseCount == 0)
+        return;
+
+    Stats source = analyze(indices.data(), baseCount, vertices.size());
+    optimizeVertexCache(indices.data(), baseCount, vertices.size());
+    optimizeOverdraw(indices.data(), baseCount, vertices.data(), vertices.size());
+    Stats optimized = analyze(indices.data(), baseCount, vertices.size());
+    lods.push_back({0, static_cast<uint32_t>(baseCount), 0.0f});
+
+    // Cada nível sai do completo (o erro medido é sempre contra o original), com metade do anterior.
+    std::vector<unsigned int> base(indices);
+    size_t previous = baseCount;
+    while (lods.size() < size_t(MAX_LODS) && previous / 3 >= MIN_LOD_TRIANGLES * 2)
+    {
+        float error = 0.0f;
+        std::vector<unsigned int> level = simplify(base.data(), base.size(), vertices.data(), vertices.size(),
+                                                   previous / 2, MAX_LOD_ERROR, &error);
+        // Ganho pequeno não compensa outro nível.
+        if (level.size() * 5 > previous * 4)
+            break;
+        optimizeVertexCache(level.data(), level.size(), vertices.size());
+        lods.push_back({static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(level.size()), error});
+        indices.insert(indices.end(), level.begin(), level.end());
+        previous = level.size();
+    }
+    optimizeVertexFetch(vertices, indices);
+
+    std::cout << "Malha " << name << ": " << source.triangles << " triângulos, ACMR " << std::fixed
+              << std::setprecision(2) << source.acmr << " -> " << optimized.acmr << " (ATVR " << source.atvr
+              << " -> " << optimized.atvr << ")";
+    for (size_t i = 1; i < lods.size(); ++i)
+        std::cout << ", LOD" << i << " " << lods[i].indexCount / 3 << " (erro " << std::setprecision(3)
+                  << lods[i].error * 100.0f << "%)";
+    std::cout << std::defaultfloat << std::endl;
+}
@@ -0,0 +1,61 @@
+#ifndef MESH_OPTIMIZER_HPP
+#define MESH_OPTIMIZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "gpuMesh.hpp"
+
+// Faixa de um nível de detalhe dentro do buffer de índices da malha.
+// error: desvio geométrico relativo ao raio da malha (0 no nível completo).
+struct MeshLod
+{
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    float error;
+};
+
+// Otimizações feitas uma vez na importação (o resultado vai para o cache da malha):
+// ordem dos triângulos para o cache pós-transformação (Forsyth), ordem dos grupos de
+// triângulos contra overdraw, ordem dos vértices pela primeira leitura e a cadeia de
+// LODs por colapso de arestas com quádricas. Todos os LODs usam o mesmo vetor de vértices.
+class MeshOptimizer
+{
+public:
+    static const int MAX_LODS = 4;
+
+    struct Stats
+    {
+        size_t triangles;
+        float acmr; // vértices transformados por triângulo (cache FIFO)
+        float atvr; // vértices transformados por vértice único
+    };
+
+    static Stats analyze(const unsigned int *indices, size_t indexCount, size_t vertexCount,
+                         unsigned int cacheSize = FIFO_SIZE);
+
+    static void optimizeVertexCache(unsigned int *indices, size_t indexCount, size_t vertexCount);
+    // Reordena grupos de triângulos de fora para dentro; desfaz se o ACMR piorar além de threshold.
+    static void optimizeOverdraw(unsigned int *indices, size_t indexCount, const GpuVertex *vertices,
+                                 size_t vertexCount, float threshold = 1.05f);
+    static void optimizeVertexFetch(std::vector<GpuVertex> &vertices, std::vector<unsigned int> &indices);
+
+    // Colapsa arestas (o vértice removido vai para a posição do vizinho) até targetIndexCount
+    // ou até o erro passar de maxError (relativo ao raio). Costuras de atributo e bordas são
+    // preservadas. Em resultError volta o maior erro aceito.
+    static std::vector<unsigned int> simplify(const unsigned int *indices, size_t indexCount,
+                                              const GpuVertex *vertices, size_t vertexCount,
+                                              size_t targetIndexCount, float maxError, float *resultError);
+
+    // Pipeline completo; lods recebe as faixas (LOD 0 primeiro) dentro de indices.
+    static void optimize(std::vector<GpuVertex> &vertices, std::vector<unsigned int> &indices,
+                         std::vector<MeshLod> &lods, const char *name);
+
+private:
+    static const unsigned int FIFO_SIZE = 16;
+    static const int FORSYTH_CACHE = 32;
+    static const size_t MIN_LOD_TRIANGLES = 128;
+    static const float MAX_LOD_ERROR;
+};
+
+#endif
@@ -0,0 +1,231 @@
+#include "minimap.hpp"
+#include "glExt.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+const float Minimap::EXTENT = 32.0f;
+
+Minimap::~Minimap()
+{
+    // No fim do programa o contexto pode já ter ido embora: só libera se ainda houver janela.
+    if (!texture || !glutGetWindow())
+        return;
+    glDeleteTextures(1, &texture);
+    if (framebuffer)
+        GLExt::DeleteFramebuffers(1, &framebuffer);
+    if (depthBuffer)
+        GLExt::DeleteRenderbuffers(1, &depthBuffer);
+}
+
+void Minimap::createTexture(int textureSize)
+{
+    size = textureSize;
+    glGenTextures(1, &texture);
+    GLState::bindTexture(texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, size, size, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+}
+
+bool Minimap::createFramebuffer()
+{
+    createTexture(1024);
+
+    GLExt::GenFramebuffers(1, &framebuffer);
+    GLExt::BindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    GLExt::FramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    GLExt::GenRenderbuffers(1, &depthBuffer);
+    GLExt::BindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    GLExt::RenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size, size);
+    GLExt::FramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    GLExt::BindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    bool complete = GLExt::CheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    GLExt::BindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (complete)
+        return true;
+
+    std::cerr << "Minimapa: framebuffer incompleto, usando cópia do back buffer" << std::endl;
+    GLExt::DeleteFramebuffers(1, &framebuffer);
+    GLExt::DeleteRenderbuffers(1, &depthBuffer);
+    glDeleteTextures(1, &texture);
+    framebuffer = depthBuffer = texture = 0;
+    GLState::bindTexture(0);
+    return false;
+}
+
+void Minimap::createTarget()
+{
+    useFramebuffer = GLExt::loadFramebuffers() && createFramebuffer();
+    if (useFramebuffer)
+        return;
+
+    // Sem FBO a captura sai do back buffer: a textura não pode passar da janela.
+    int limit = std::min(glutGet(GLUT_WINDOW_WIDTH), glutGet(GLUT_WINDOW_HEIGHT));
+    int textureSize = 64;
+    while (textureSize * 2 <= limit && textureSize < 1024)
+        textureSize *= 2;
+    createTexture(textureSize);
+}
+
+void Minimap::beginCapture(const GLfloat clearColor[3])
+{
+    if (!texture)
+        createTarget();
+
+    glGetIntegerv(GL_VIEWPORT, savedViewport);
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, savedClearColor);
+    if (useFramebuffer)
+        GLExt::BindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+    glViewport(0, 0, size, size);
+    glClearColor(clearColor[0], clearColor[1], clearColor[2], 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    GLState::pushAttrib();
+    GLState::enable(GL_DEPTH_TEST);
+
+    // De cima, com -z para cima na textura (mesma orientação da câmera do modo mapa).
+    GLState::matrixMode(GL_PROJECTION);
+    GLState::pushMatrix();
+    GLState::loadIdentity();
+    GLState::ortho(-EXTENT, EXTENT, -EXTENT, EXTENT, 1.0f, 200.0f);
+    GLState::matrixMode(GL_MODELVIEW);
+    GLState::pushMatrix();
+    GLState::loadIdentity();
+    GLState::lookAt(0.0f, 100.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, -1.0f);
+}
+
+void Minimap::endCapture()
+{
+    GLState::matrixMode(GL_PROJECTION);
+    GLState::popMatrix();
+    GLState::matrixMode(GL_MODELVIEW);
+    GLState::popMatrix();
+    GLState::popAttrib();
+
+    if (useFramebuffer)
+    {
+        GLExt::BindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+    else
+    {
+        GLState::bindTexture(texture);
+        glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, size, size);
+    }
+
+    glViewport(savedViewport[0], savedViewport[1], savedViewport[2], savedViewport[3]);
+    glClearColor(savedClearColor[0], savedClearColor[1], savedClearColor[2], savedClearColor[3]);
+    dirty = false;
+}
+
+void Minimap::beginMarkers()
+{
+    markers.clear();
+}
+
+void Minimap::addMarker(Icon icon, float x, float z, float pixels, GLubyte r, GLubyte g, GLubyte b, float angle)
+{
+    markers.push_back({icon, x, z, pixels, r, g, b, angle});
+}
+
+void Minimap::pushTriangle(float ax, float ay, float bx, float by, float cx, float cy, const GLubyte color[3])
+{
+    vertices.push_back({ax, ay, color[0], color[1], color[2], 255});
+    vertices.push_back({bx, by, color[0], color[1], color[2], 255});
+    vertices.push_back({cx, cy, color[0], color[1], color[2], 255});
+}
+
+void Minimap::draw(float centerX, float centerZ, float halfHeight, int windowWidth, int windowHeight)
+{
+    if (!texture)
+        return;
+
+    float halfWidth = halfHeight * windowWidth / static_cast<float>(windowHeight);
+    float worldPerPixel = 2.0f * halfHeight / windowHeight;
+
+    GLState::pushAttrib();
+    GLState::disable(GL_LIGHTING);
+    GLState::disable(GL_DEPTH_TEST);
+    GLState::disable(GL_BLEND);
+    GLState::enable(GL_TEXTURE_2D);
+
+    // Plano do mapa: x do mundo para a direita e -z para cima.
+    GLState::matrixMode(GL_PROJECTION);
+    GLState::pushMatrix();
+    GLState::loadIdentity();
+    GLState::ortho(centerX - halfWidth, centerX + halfWidth, -centerZ - halfHeight, -centerZ + halfHeight, -1.0f, 1.0f);
+    GLState::matrixMode(GL_MODELVIEW);
+    GLState::pushMatrix();
+    GLState::loadIdentity();
+
+    GLState::bindTexture(texture);
+    GLState::texEnvMode(GL_REPLACE);
+    glBegin(GL_QUADS);
+    GLState::texCoord(0.0f, 0.0f);
+    glVertex2f(-EXTENT, -EXTENT);
+    GLState::texCoord(1.0f, 0.0f);
+    glVertex2f(EXTENT, -EXTENT);
+    GLState::texCoord(1.0f, 1.0f);
+    glVertex2f(EXTENT, EXTENT);
+    GLState::texCoord(0.0f, 1.0f);
+    glVertex2f(-EXTENT, EXTENT);
+    glEnd();
+    GLState::disable(GL_TEXTURE_2D);
+
+    // Ícones com contorno escuro, todos em um vertex array.
+    vertices.clear();
+    const GLubyte outline[3] = {20, 20, 20};
+    for (const Marker &marker : markers)
+    {
+        float mx = marker.x, my = -marker.z;
+        const GLubyte color[3] = {marker.r, marker.g, marker.b};
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            const GLubyte *c = pass == 0 ? outline : color;
+            float s = (pass == 0 ? marker.pixels + 3.0f : marker.pixels) * worldPerPixel * 0.5f;
+            switch (marker.icon)
+            {
+            case SQUARE:
+                pushTriangle(mx - s, my - s, mx + s, my - s, mx + s, my + s, c);
+                pushTriangle(mx - s, my - s, mx + s, my + s, mx - s, my + s, c);
+                break;
+            case DIAMOND:
+                pushTriangle(mx, my - s, mx + s, my, mx, my + s, c);
+                pushTriangle(mx, my - s, mx, my + s, mx - s, my, c);
+                break;
+            case ARROW:
+            {
+                float angle = marker.angle * static_cast<float>(M_PI) / 180.0f;
+                float fx = std::sin(angle), fy = -std::cos(angle);
+                float rx = -fy, ry = fx;
+                pushTriangle(mx + fx * s * 1.2f, my + fy * s * 1.2f,
+                             mx - fx * s * 0.8f + rx * s * 0.8f, my - fy * s * 0.8f + ry * s * 0.8f,
+                             mx - fx * s * 0.8f - rx * s * 0.8f, my - fy * s * 0.8f - ry * s * 0.8f, c);
+                break;
+            }
+            }
+        }
+    }
+
+    if (!vertices.empty())
+    {
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glVertexPointer(2, GL_FLOAT, sizeof(MarkerVertex), &vertices[0].x);
+        glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(MarkerVertex), &vertices[0].r);
+        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size()));
+        GLState::forgetCurrent(GLState::CURRENT_COLOR);
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+    }
+
+    GLState::matrixMode(GL_PROJECTION);
+    GLState::popMatrix();
+    GLState::matrixMode(GL_MODELVIEW);
+    GLState::popMatrix();
+    GLState::popAttrib();
+}
@@ -0,0 +1,76 @@
+#ifndef MINIMAP_HPP
+#define MINIMAP_HPP
+
+#include <vector>
+#include "glState.hpp"
+
+// Mapa visto de cima (modo TOP_VIEW_MAP).
+// A parte fixa do mapa (chão, lagos, árvores, casas...) é desenhada uma vez, com câmera
+// ortográfica, em uma textura; depois cada frame só desenha essa textura em um quad e
+// os marcadores do que se mexe (jogador, inimigos, portais, itens) como ícones.
+// Usa FBO quando existe; senão desenha no back buffer e copia para a textura.
+class Minimap
+{
+public:
+    // Metade do lado da área coberta, em unidades do mundo (centrada na origem).
+    static const float EXTENT;
+
+    enum Icon
+    {
+        SQUARE,
+        DIAMOND,
+        ARROW
+    };
+
+    ~Minimap();
+
+    void invalidate() { dirty = true; }
+    bool needsCapture() const { return dirty; }
+
+    // Entre os dois o chamador desenha a parte fixa: alvo, viewport e câmera de cima já prontos.
+    void beginCapture(const GLfloat clearColor[3]);
+    void endCapture();
+
+    void beginMarkers();
+    // pixels: tamanho do ícone na tela, independente do zoom. angle (graus) só vale para ARROW.
+    void addMarker(Icon icon, float x, float z, float pixels, GLubyte r, GLubyte g, GLubyte b, float angle = 0.0f);
+
+    // (centerX, centerZ): ponto do mundo no centro da tela; halfHeight: metade da altura visível em unidades do mundo.
+    void draw(float centerX, float centerZ, float halfHeight, int windowWidth, int windowHeight);
+
+private:
+    struct Marker
+    {
+        Icon icon;
+        float x, z;
+        float pixels;
+        GLubyte r, g, b;
+        float angle;
+    };
+
+    struct MarkerVertex
+    {
+        GLfloat x, y;
+        GLubyte r, g, b, a;
+    };
+
+    GLuint texture = 0;
+    GLuint framebuffer = 0;
+    GLuint depthBuffer = 0;
+    int size = 0;
+    bool useFramebuffer = false;
+    bool dirty = true;
+
+    GLint savedViewport[4];
+    GLfloat savedClearColor[4];
+
+    std::vector<Marker> markers;
+    std::vector<MarkerVertex> vertices;
+
+    void createTarget();
+    void createTexture(int textureSize);
+    bool createFramebuffer();
+    void pushTriangle(float ax, float ay, float bx, float by, float cx, float cy, const GLubyte color[3]);
+};
+
+#endif
@@ -0,0 +1,126 @@
+#include "objBenchmark.hpp"
+#include "mappedFile.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    const char *const SHIPPED_OBJS[] = {"./src/objs/modelo.obj", "./src/objs/Knife.obj", "./src/objs/espada.obj",
+                                        "./src/objs/cat_meme.obj", "./src/objs/Tree low.obj"};
+
+    // Melhor tempo (ms) de ObjBenchmark::RUNS execuções; false se alguma falhou.
+    bool bestOf(const std::function<bool(ObjData &)> &load, double &best, ObjData &last)
+    {
+        best = 1e30;
+        for (int run = 0; run < ObjBenchmark::RUNS; ++run)
+        {
+            ObjData data;
+            auto start = std::chrono::steady_clock::now();
+            if (!load(data))
+                return false;
+            auto end = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+            last = std::move(data);
+        }
+        return true;
+    }
+}
+
+bool ObjBenchmark::loadWithStreams(const char *path, ObjData &out)
+{
+    // Cópia do leitor que o Mesh::loadOBJ usava antes do ObjParser (sem o MTL).
+    std::ifstream arquivo(path);
+    if (!arquivo.is_open())
+        return false;
+
+    std::string linha;
+    while (std::getline(arquivo, linha))
+    {
+        std::istringstream iss(linha);
+        std::string tipo;
+        iss >> tipo;
+        if (tipo == "v")
+        {
+            Vertex v;
+            iss >> v.x >> v.y >> v.z;
+            out.vertices.push_back(v);
+        }
+        else if (tipo == "vn")
+        {
+            Normal n;
+            iss >> n.nx >> n.ny >> n.nz;
+            out.normals.push_back(n);
+        }
+        else if (tipo == "vt")
+        {
+            TexCoord t;
+            iss >> t.u >> t.v;
+            out.texCoords.push_back(t);
+        }
+        else if (tipo == "f")
+        {
+            std::string vertice_str;
+            std::vector<unsigned int> vi, ti, ni;
+            while (iss >> vertice_str)
+            {
+                std::replace(vertice_str.begin(), vertice_str.end(), '/', ' ');
+                std::istringstream viss(vertice_str);
+                unsigned int v, t, n;
+                viss >> v >> t >> n;
+                vi.push_back(v - 1);
+                ti.push_back(t - 1);
+                ni.push_back(n - 1);
+            }
+            for (size_t i = 1; i + 1 < vi.size(); ++i)
+            {
+                out.vertexIndices.insert(out.vertexIndices.end(), {vi[0], vi[i], vi[i + 1]});
+                out.texCoordIndices.insert(out.texCoordIndices.end(), {ti[0], ti[i], ti[i + 1]});
+                out.normalIndices.insert(out.normalIndices.end(), {ni[0], ni[i], ni[i + 1]});
+            }
+        }
+        else if (tipo == "usemtl")
+        {
+            iss >> out.material;
+        }
+    }
+    return true;
+}
+
+int ObjBenchmark::run()
+{
+    std::printf("Leitura de OBJ, melhor de %d (ms)\n", RUNS);
+    std::printf("%-28s %10s %12s %12s  %s\n", "arquivo", "antigo", "novo 1 thr", "novo", "triângulos");
+    int failures = 0;
+    for (const char *path : SHIPPED_OBJS)
+    {
+        double streams = 0.0, single = 0.0, threaded = 0.0;
+        ObjData old, one, many;
+        bool ok = bestOf([&](ObjData &out) { return loadWithStreams(path, out); }, streams, old) &&
+                  bestOf([&](ObjData &out) {
+                      MappedFile file;
+                      return file.open(path) && ObjParser::parse(file.data(), file.data() + file.size(), out, 1);
+                  }, single, one) &&
+                  bestOf([&](ObjData &out) { return ObjParser::load(path, out); }, threaded, many);
+        if (!ok)
+        {
+            std::printf("%-28s não foi possível ler\n", path);
+            ++failures;
+            continue;
+        }
+
+        // O leitor antigo erra texcoord/normal em v//n; vértices e faces têm que bater.
+        bool same = old.vertices.size() == many.vertices.size() &&
+                    old.vertexIndices.size() == many.vertexIndices.size() &&
+                    one.vertexIndices == many.vertexIndices;
+        std::printf("%-28s %10.2f %12.2f %12.2f  %zu%s\n", path, streams, single, threaded,
+                    many.vertexIndices.size() / 3, same ? "" : "  (resultado diferente!)");
+        if (!same)
+            ++failures;
+    }
+    return failures ? 1 : 0;
+}
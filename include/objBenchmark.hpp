@@ -0,0 +1,20 @@
+#ifndef OBJ_BENCHMARK_HPP
+#define OBJ_BENCHMARK_HPP
+
+#include "objParser.hpp"
+
+// Compara o ObjParser com o leitor antigo (ifstream + istringstream por linha, como o
+// Mesh::loadOBJ fazia) nos OBJs do jogo. Roda sem janela: `--bench-obj` na linha de comando.
+class ObjBenchmark
+{
+public:
+    static const int RUNS = 5;
+
+    // Melhor de RUNS leituras de cada arquivo, nos dois leitores; retorna o código de saída.
+    static int run();
+
+private:
+    static bool loadWithStreams(const char *path, ObjData &out);
+};
+
+#endif
@@ -0,0 +1,345 @@
+#include "objParser.hpp"
+#include "mappedFile.hpp"
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <thread>
+
+namespace
+{
+    inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+    inline const char *skipBlanks(const char *p, const char *end)
+    {
+        while (p < end && isBlank(*p))
+            ++p;
+        return p;
+    }
+
+    inline const char *lineEnd(const char *p, const char *end)
+    {
+        while (p < end && *p != '\n')
+            ++p;
+        return p;
+    }
+
+    inline const char *tokenEnd(const char *p, const char *end)
+    {
+        while (p < end && !isBlank(*p) && *p != '\n')
+            ++p;
+        return p;
+    }
+
+    inline bool keyword(const char *p, const char *tokenEnd, const char *word)
+    {
+        for (; p < tokenEnd && *word; ++p, ++word)
+            if (*p != *word)
+                return false;
+        return p == tokenEnd && !*word;
+    }
+
+    // Lê um float pulando brancos antes; sem número deixa o valor como está.
+    inline const char *readFloat(const char *p, const char *end, float &value)
+    {
+        p = skipBlanks(p, end);
+        if (p < end && *p == '+')
+            ++p;
+        std::from_chars_result result = std::from_chars(p, end, value);
+        return result.ec == std::errc() ? result.ptr : p;
+    }
+
+    inline const char *readInt(const char *p, const char *end, int &value, bool &found)
+    {
+        std::from_chars_result result = std::from_chars(p, end, value);
+        found = result.ec == std::errc();
+        return found ? result.ptr : p;
+    }
+
+    // Resto da linha sem os brancos das pontas (nomes de material podem ter espaço).
+    inline std::string restOfLine(const char *p, const char *end)
+    {
+        p = skipBlanks(p, end);
+        while (end > p && isBlank(end[-1]))
+            --end;
+        return std::string(p, end);
+    }
+}
+
+void ObjParser::parseChunk(const char *p, const char *end, Chunk &chunk)
+{
+    std::string material;
+    std::vector<Corner> face;
+    std::vector<unsigned char> faceRelative;
+
+    while (p < end)
+    {
+        const char *eol = lineEnd(p, end);
+        const char *word = skipBlanks(p, eol);
+        const char *wordEnd = tokenEnd(word, eol);
+        p = eol < end ? eol + 1 : end;
+        if (word == wordEnd || *word == '#')
+            continue;
+
+        if (keyword(word, wordEnd, "v"))
+        {
+            Vertex v = {0.0f, 0.0f, 0.0f};
+            const char *q = readFloat(wordEnd, eol, v.x);
+            q = readFloat(q, eol, v.y);
+            readFloat(q, eol, v.z);
+            chunk.vertices.push_back(v);
+        }
+        else if (keyword(word, wordEnd, "vn"))
+        {
+            Normal n = {0.0f, 0.0f, 0.0f};
+            const char *q = readFloat(wordEnd, eol, n.nx);
+            q = readFloat(q, eol, n.ny);
+            readFloat(q, eol, n.nz);
+            chunk.normals.push_back(n);
+        }
+        else if (keyword(word, wordEnd, "vt"))
+        {
+            TexCoord t = {0.0f, 0.0f};
+            const char *q = readFloat(wordEnd, eol, t.u);
+            readFloat(q, eol, t.v);
+            chunk.texCoords.push_back(t);
+        }
+        else if (keyword(word, wordEnd, "f"))
+        {
+            face.clear();
+            faceRelative.clear();
+            const char *q = skipBlanks(wordEnd, eol);
+            bool valid = true;
+            while (q < eol && valid)
+            {
+                // v, v/t, v//n ou v/t/n; 0 marca ausente, negativo conta a partir do fim.
+                int index[3] = {0, 0, 0};
+                bool found;
+                q = readInt(q, eol, index[0], found);
+                valid = found && index[0] != 0;
+                if (valid && q < eol && *q == '/')
+                {
+                    ++q;
+                    if (q < eol && *q != '/')
+                        q = readInt(q, eol, index[1], found);
+                    if (q < eol && *q == '/')
+                    {
+                        ++q;
+                        q = readInt(q, eol, index[2], found);
+                    }
+                }
+                if (q < eol && !isBlank(*q))
+                    valid = false;
+
+                const int counts[3] = {static_cast<int>(chunk.vertices.size()),
+                                       static_cast<int>(chunk.texCoords.size()),
+                                       static_cast<int>(chunk.normals.size())};
+                int resolved[3];
+                unsigned char relative = 0;
+                for (int k = 0; k < 3; ++k)
+                {
+                    if (index[k] > 0)
+                        resolved[k] = index[k] - 1;
+                    else if (index[k] < 0)
+                    {
+                        resolved[k] = counts[k] + index[k];
+                        relative |= 1 << k;
+                    }
+                    else
+                        resolved[k] = -1;
+                }
+                face.push_back({resolved[0], resolved[1], resolved[2]});
+                faceRelative.push_back(relative);
+                q = skipBlanks(q, eol);
+            }
+            if (!valid || face.size() < 3)
+                continue;
+
+            for (size_t i = 1; i + 1 < face.size(); ++i)
+            {
+                const size_t fan[3] = {0, i, i + 1};
+                for (size_t k : fan)
+                {
+                    chunk.corners.push_back(face[k]);
+                    chunk.relative.push_back(faceRelative[k]);
+                }
+            }
+            if (chunk.hasMaterial)
+            {
+                chunk.facesAfterMaterial = true;
+                chunk.lastFaceMaterial = material;
+            }
+            else
+            {
+                chunk.facesBeforeMaterial = true;
+            }
+        }
+        else if (keyword(word, wordEnd, "usemtl"))
+        {
+            material = restOfLine(wordEnd, eol);
+            chunk.hasMaterial = true;
+            chunk.endMaterial = material;
+        }
+    }
+}
+
+bool ObjParser::parse(const char *begin, const char *end, ObjData &out, unsigned int chunkCount)
+{
+    size_t size = static_cast<size_t>(end - begin);
+    if (chunkCount == 0)
+    {
+        unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+        chunkCount = static_cast<unsigned int>(std::min<size_t>(threads, std::max<size_t>(1, size / MIN_CHUNK_BYTES)));
+    }
+
+    // Cortes em quebras de linha; um pedaço pode ficar vazio se as linhas forem enormes.
+    std::vector<const char *> cuts(chunkCount + 1, end);
+    cuts[0] = begin;
+    for (unsigned int i = 1; i < chunkCount; ++i)
+    {
+        const char *cut = std::max(cuts[i - 1], begin + size * i / chunkCount);
+        cut = lineEnd(cut, end);
+        cuts[i] = cut < end ? cut + 1 : end;
+    }
+
+    std::vector<Chunk> chunks(chunkCount);
+    std::vector<std::thread> workers;
+    for (unsigned int i = 1; i < chunkCount; ++i)
+        workers.emplace_back(parseChunk, cuts[i], cuts[i + 1], std::ref(chunks[i]));
+    parseChunk(cuts[0], cuts[1], chunks[0]);
+    for (std::thread &worker : workers)
+        worker.join();
+
+    size_t vertexCount = 0, texCoordCount = 0, normalCount = 0, cornerCount = 0;
+    for (const Chunk &chunk : chunks)
+    {
+        vertexCount += chunk.vertices.size();
+        texCoordCount += chunk.texCoords.size();
+        normalCount += chunk.normals.size();
+        cornerCount += chunk.corners.size();
+    }
+    out.vertices.reserve(out.vertices.size() + vertexCount);
+    out.texCoords.reserve(out.texCoords.size() + texCoordCount);
+    out.normals.reserve(out.normals.size() + normalCount);
+    out.vertexIndices.reserve(out.vertexIndices.size() + cornerCount);
+    out.texCoordIndices.reserve(out.texCoordIndices.size() + cornerCount);
+    out.normalIndices.reserve(out.normalIndices.size() + cornerCount);
+
+    std::string active;
+    for (const Chunk &chunk : chunks)
+    {
+        const long long base[3] = {static_cast<long long>(out.vertices.size()),
+                                   static_cast<long long>(out.texCoords.size()),
+                                   static_cast<long long>(out.normals.size())};
+        out.vertices.insert(out.vertices.end(), chunk.vertices.begin(), chunk.vertices.end());
+        out.texCoords.insert(out.texCoords.end(), chunk.texCoords.begin(), chunk.texCoords.end());
+        out.normals.insert(out.normals.end(), chunk.normals.begin(), chunk.normals.end());
+
+        // Índices positivos já são absolutos; só é possível validar contra o total no fim.
+        for (size_t i = 0; i < chunk.corners.size(); ++i)
+        {
+            const Corner &corner = chunk.corners[i];
+            const int raw[3] = {corner.v, corner.t, corner.n};
+            unsigned int resolved[3];
+            for (int k = 0; k < 3; ++k)
+            {
+                long long index = raw[k];
+                if (chunk.relative[i] & (1 << k))
+                    index += base[k];
+                else if (raw[k] < 0)
+                    index = -1;
+                resolved[k] = index < 0 ? NO_INDEX : static_cast<unsigned int>(index);
+            }
+            out.vertexIndices.push_back(resolved[0]);
+            out.texCoordIndices.push_back(resolved[1]);
+            out.normalIndices.push_back(resolved[2]);
+        }
+
+        if (chunk.facesBeforeMaterial && !active.empty())
+            out.material = active;
+        if (chunk.facesAfterMaterial && !chunk.lastFaceMaterial.empty())
+            out.material = chunk.lastFaceMaterial;
+        if (chunk.hasMaterial)
+            active = chunk.endMaterial;
+    }
+
+    for (size_t i = 0; i < out.vertexIndices.size(); ++i)
+    {
+        if (out.vertexIndices[i] >= out.vertices.size())
+        {
+            std::cerr << "OBJ: face com índice de vértice fora do intervalo" << std::endl;
+            return false;
+        }
+        if (out.texCoordIndices[i] != NO_INDEX && out.texCoordIndices[i] >= out.texCoords.size())
+            out.texCoordIndices[i] = NO_INDEX;
+        if (out.normalIndices[i] != NO_INDEX && out.normalIndices[i] >= out.normals.size())
+            out.normalIndices[i] = NO_INDEX;
+    }
+    return true;
+}
+
+bool ObjParser::load(const char *path, ObjData &out)
+{
+    MappedFile file;
+    if (!file.open(path))
+    {
+        std::cerr << "Erro ao abrir o arquivo: " << path << std::endl;
+        return false;
+    }
+    return parse(file.data(), file.data() + file.size(), out);
+}
+
+void ObjParser::parseMtl(const char *p, const char *end, std::map<std::string, Material> &out)
+{
+    Material current = Material();
+    std::string name;
+    bool open = false;
+
+    while (p < end)
+    {
+        const char *eol = lineEnd(p, end);
+        const char *word = skipBlanks(p, eol);
+        const char *wordEnd = tokenEnd(word, eol);
+        p = eol < end ? eol + 1 : end;
+        if (word == wordEnd || *word == '#')
+            continue;
+
+        Color *color = nullptr;
+        if (keyword(word, wordEnd, "newmtl"))
+        {
+            if (open)
+                out[name] = current;
+            name = restOfLine(wordEnd, eol);
+            current = Material();
+            open = true;
+        }
+        else if (keyword(word, wordEnd, "Ka"))
+            color = &current.ambient;
+        else if (keyword(word, wordEnd, "Kd"))
+            color = &current.diffuse;
+        else if (keyword(word, wordEnd, "Ks"))
+            color = &current.specular;
+        else if (keyword(word, wordEnd, "Ns"))
+            readFloat(wordEnd, eol, current.shininess);
+
+        if (color)
+        {
+            const char *q = readFloat(wordEnd, eol, color->r);
+            q = readFloat(q, eol, color->g);
+            readFloat(q, eol, color->b);
+        }
+    }
+    if (open)
+        out[name] = current;
+}
+
+bool ObjParser::loadMtl(const char *path, std::map<std::string, Material> &out)
+{
+    MappedFile file;
+    if (!file.open(path))
+    {
+        std::cerr << "Erro ao abrir o arquivo MTL: " << path << std::endl;
+        return false;
+    }
+    parseMtl(file.data(), file.data() + file.size(), out);
+    return true;
+}
@@ -0,0 +1,80 @@
+#ifndef OBJ_PARSER_HPP
+#define OBJ_PARSER_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include "data.hpp"
+
+struct Vertex
+{
+    float x, y, z;
+};
+
+struct Normal
+{
+    float nx, ny, nz;
+};
+
+struct TexCoord
+{
+    float u, v;
+};
+
+// Conteúdo de um OBJ já triangulado (leque por face), com os três índices por canto.
+struct ObjData
+{
+    std::vector<Vertex> vertices;
+    std::vector<Normal> normals;
+    std::vector<TexCoord> texCoords;
+    std::vector<unsigned int> vertexIndices, normalIndices, texCoordIndices;
+    // usemtl ativo na última face que tinha um (vazio se nenhuma tinha).
+    std::string material;
+};
+
+// Leitor de OBJ/MTL sobre o arquivo mapeado: varre os bytes com ponteiros e converte
+// números com std::from_chars, sem string nem stream por linha. Aceita v, v/t, v//n
+// e v/t/n, com índices negativos. Arquivos grandes são cortados em pedaços (em quebras
+// de linha) lidos em threads separadas e juntados em ordem no final.
+class ObjParser
+{
+public:
+    // Índice de texCoord/normal ausente no canto (fica fora do intervalo de propósito).
+    static const unsigned int NO_INDEX = 0xFFFFFFFFu;
+
+    static bool load(const char *path, ObjData &out);
+    static bool loadMtl(const char *path, std::map<std::string, Material> &out);
+
+    // Mesmo trabalho sobre bytes em memória; chunks = 0 escolhe pelo tamanho.
+    static bool parse(const char *begin, const char *end, ObjData &out, unsigned int chunks = 0);
+    static void parseMtl(const char *begin, const char *end, std::map<std::string, Material> &out);
+
+private:
+    static const size_t MIN_CHUNK_BYTES = 256 * 1024;
+
+    struct Corner
+    {
+        int v, t, n;
+    };
+
+    // Resultado de um pedaço. Índices negativos são guardados relativos ao início do pedaço
+    // (ainda sem saber quantos vértices vieram antes) e corrigidos na junção.
+    struct Chunk
+    {
+        std::vector<Vertex> vertices;
+        std::vector<Normal> normals;
+        std::vector<TexCoord> texCoords;
+        std::vector<Corner> corners; // três por triângulo
+        std::vector<unsigned char> relative; // bits 1/2/4: v/t/n do canto são relativos
+        // Para achar o material da última face sem saber o usemtl ativo no começo do pedaço.
+        bool facesBeforeMaterial = false;
+        bool facesAfterMaterial = false;
+        bool hasMaterial = false;
+        std::string lastFaceMaterial; // usemtl da última face depois do primeiro usemtl do pedaço
+        std::string endMaterial;      // último usemtl do pedaço
+    };
+
+    static void parseChunk(const char *begin, const char *end, Chunk &chunk);
+};
+
+#endif
@@ -0,0 +1,353 @@
+#include "occlusionCuller.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OCCLUSION_SSE 1
+#endif
+
+namespace
+{
+    // Plano de corte em w (igual ao zNear do render): nada atrás dele é rasterizado.
+    const float NEAR_W = 0.1f;
+}
+
+OcclusionCuller::~OcclusionCuller()
+{
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    if (worker.joinable())
+        worker.join();
+}
+
+void OcclusionCuller::begin(const Mat4 &viewProjection)
+{
+    invalidate();
+    this->viewProjection = viewProjection;
+    occluders.clear();
+}
+
+void OcclusionCuller::addOccluder(const Box &box)
+{
+    occluders.push_back(box);
+}
+
+int OcclusionCuller::addOccludee(const Box &box)
+{
+    occludees.push_back(box);
+    return static_cast<int>(occludees.size()) - 1;
+}
+
+void OcclusionCuller::setTerrain(const std::vector<float> &positions, const std::vector<unsigned int> &indices)
+{
+    wait();
+    terrainPositions = positions;
+    terrainIndices = indices;
+}
+
+void OcclusionCuller::launch()
+{
+    wait();
+    ready = false;
+    if (!worker.joinable())
+        worker = std::thread(&OcclusionCuller::workerLoop, this);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = true;
+    }
+    launched = true;
+    wake.notify_one();
+}
+
+void OcclusionCuller::wait()
+{
+    if (!launched)
+        return;
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return !pending; });
+    launched = false;
+    ready = true;
+}
+
+void OcclusionCuller::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;)
+    {
+        wake.wait(lock, [this] { return stopping || pending; });
+        if (stopping)
+            return;
+        lock.unlock();
+        run();
+        lock.lock();
+        pending = false;
+        done.notify_one();
+    }
+}
+
+void OcclusionCuller::wait(const Mat4 &camera)
+{
+    wait();
+    for (int i = 0; i < 16 && ready; ++i)
+        if (camera.m[i] != viewProjection.m[i])
+            ready = false;
+}
+
+void OcclusionCuller::invalidate()
+{
+    wait();
+    ready = false;
+    occludees.clear();
+}
+
+bool OcclusionCuller::isVisible(int index) const
+{
+    if (!ready || index < 0 || index >= static_cast<int>(visible.size()))
+        return true;
+    return visible[index] != 0;
+}
+
+void OcclusionCuller::run()
+{
+    clearDepth();
+
+    for (size_t i = 0; i + 2 < terrainIndices.size(); i += 3)
+    {
+        float a[3], b[3], c[3];
+        transform(&terrainPositions[terrainIndices[i] * 3], a);
+        transform(&terrainPositions[terrainIndices[i + 1] * 3], b);
+        transform(&terrainPositions[terrainIndices[i + 2] * 3], c);
+        drawClipTriangle(a, b, c);
+    }
+    for (const Box &box : occluders)
+        drawBox(box);
+
+    visible.resize(occludees.size());
+    for (size_t i = 0; i < occludees.size(); ++i)
+        visible[i] = testBox(occludees[i]) ? 1 : 0;
+}
+
+void OcclusionCuller::clearDepth()
+{
+    std::fill(depth, depth + WIDTH * HEIGHT, 0.0f);
+}
+
+// Só x, y e w do espaço de clip: a profundidade usada é 1/w.
+void OcclusionCuller::transform(const float p[3], float out[3]) const
+{
+    const float *m = viewProjection.m;
+    out[0] = m[0] * p[0] + m[4] * p[1] + m[8] * p[2] + m[12];
+    out[1] = m[1] * p[0] + m[5] * p[1] + m[9] * p[2] + m[13];
+    out[2] = m[3] * p[0] + m[7] * p[1] + m[11] * p[2] + m[15];
+}
+
+void OcclusionCuller::drawClipTriangle(const float a[3], const float b[3], const float c[3])
+{
+    const float *in[3] = {a, b, c};
+    float clipped[4][3];
+    int count = 0;
+
+    // Corta contra w = NEAR_W (Sutherland-Hodgman com um plano só: no máximo 4 vértices).
+    for (int i = 0; i < 3; ++i)
+    {
+        const float *p = in[i];
+        const float *q = in[(i + 1) % 3];
+        bool pIn = p[2] >= NEAR_W, qIn = q[2] >= NEAR_W;
+        if (pIn)
+        {
+            std::copy(p, p + 3, clipped[count++]);
+        }
+        if (pIn != qIn)
+        {
+            float t = (NEAR_W - p[2]) / (q[2] - p[2]);
+            for (int k = 0; k < 3; ++k)
+                clipped[count][k] = p[k] + (q[k] - p[k]) * t;
+            ++count;
+        }
+    }
+    if (count < 3)
+        return;
+
+    float screen[4][3];
+    for (int i = 0; i < count; ++i)
+    {
+        float invW = 1.0f / clipped[i][2];
+        screen[i][0] = (clipped[i][0] * invW * 0.5f + 0.5f) * WIDTH;
+        screen[i][1] = (clipped[i][1] * invW * 0.5f + 0.5f) * HEIGHT;
+        screen[i][2] = invW;
+    }
+    rasterize(screen[0], screen[1], screen[2]);
+    if (count == 4)
+        rasterize(screen[0], screen[2], screen[3]);
+}
+
+void OcclusionCuller::rasterize(const float a[3], const float b[3], const float c[3])
+{
+    float area = (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+    if (area < 0.0f)
+    {
+        std::swap(b, c);
+        area = -area;
+    }
+    if (area < 1e-6f)
+        return;
+
+    // Funções de aresta e = A * x + B * y + C, positivas dentro do triângulo.
+    const float *v[3] = {a, b, c};
+    float A[3], B[3], C[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        const float *p = v[i];
+        const float *q = v[(i + 1) % 3];
+        A[i] = p[1] - q[1];
+        B[i] = q[0] - p[0];
+        C[i] = -A[i] * p[0] - B[i] * p[1];
+    }
+
+    // 1/w é linear na tela: plano a partir dos pesos baricêntricos (aresta oposta a cada vértice).
+    float invArea = 1.0f / area;
+    float ZA = (A[1] * a[2] + A[2] * b[2] + A[0] * c[2]) * invArea;
+    float ZB = (B[1] * a[2] + B[2] * b[2] + B[0] * c[2]) * invArea;
+    float ZC = (C[1] * a[2] + C[2] * b[2] + C[0] * c[2]) * invArea;
+
+    int minX = std::max(0, static_cast<int>(std::floor(std::min({a[0], b[0], c[0]}))));
+    int maxX = std::min(WIDTH - 1, static_cast<int>(std::ceil(std::max({a[0], b[0], c[0]}))));
+    int minY = std::max(0, static_cast<int>(std::floor(std::min({a[1], b[1], c[1]}))));
+    int maxY = std::min(HEIGHT - 1, static_cast<int>(std::ceil(std::max({a[1], b[1], c[1]}))));
+    if (minX > maxX || minY > maxY)
+        return;
+    minX &= ~3;
+
+#ifdef OCCLUSION_SSE
+    const __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128 a0 = _mm_set1_ps(A[0]), a1 = _mm_set1_ps(A[1]), a2 = _mm_set1_ps(A[2]);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 za = _mm_set1_ps(ZA);
+    for (int y = minY; y <= maxY; ++y)
+    {
+        float fy = y + 0.5f;
+        __m128 r0 = _mm_set1_ps(B[0] * fy + C[0]);
+        __m128 r1 = _mm_set1_ps(B[1] * fy + C[1]);
+        __m128 r2 = _mm_set1_ps(B[2] * fy + C[2]);
+        __m128 rz = _mm_set1_ps(ZB * fy + ZC);
+        float *row = depth + y * WIDTH;
+        for (int x = minX; x <= maxX; x += 4)
+        {
+            __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), offsets);
+            __m128 inside = _mm_and_ps(_mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a0, px), r0), zero),
+                                       _mm_and_ps(_mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a1, px), r1), zero),
+                                                  _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a2, px), r2), zero)));
+            if (_mm_movemask_ps(inside) == 0)
+                continue;
+            __m128 z = _mm_add_ps(_mm_mul_ps(za, px), rz);
+            __m128 old = _mm_load_ps(row + x);
+            __m128 nearest = _mm_max_ps(old, z);
+            _mm_store_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, old)));
+        }
+    }
+#else
+    for (int y = minY; y <= maxY; ++y)
+    {
+        float fy = y + 0.5f;
+        float *row = depth + y * WIDTH;
+        for (int x = minX; x <= maxX; ++x)
+        {
+            float fx = x + 0.5f;
+            if (A[0] * fx + B[0] * fy + C[0] < 0.0f ||
+                A[1] * fx + B[1] * fy + C[1] < 0.0f ||
+                A[2] * fx + B[2] * fy + C[2] < 0.0f)
+                continue;
+            row[x] = std::max(row[x], ZA * fx + ZB * fy + ZC);
+        }
+    }
+#endif
+}
+
+void OcclusionCuller::drawBox(const Box &box)
+{
+    // Cantos indexados por bits (x, y, z) e as 12 faces triangulares da caixa.
+    static const int faces[12][3] = {
+        {0, 1, 3}, {0, 3, 2}, {4, 6, 7}, {4, 7, 5}, // -x, +x
+        {0, 4, 5}, {0, 5, 1}, {2, 3, 7}, {2, 7, 6}, // -y, +y
+        {0, 2, 6}, {0, 6, 4}, {1, 5, 7}, {1, 7, 3}, // -z, +z
+    };
+
+    float corners[8][3];
+    for (int i = 0; i < 8; ++i)
+    {
+        const float p[3] = {(i & 4) ? box.max[0] : box.min[0],
+                            (i & 2) ? box.max[1] : box.min[1],
+                            (i & 1) ? box.max[2] : box.min[2]};
+        transform(p, corners[i]);
+    }
+    for (const int *face : faces)
+        drawClipTriangle(corners[face[0]], corners[face[1]], corners[face[2]]);
+}
+
+bool OcclusionCuller::testBox(const Box &box) const
+{
+    float minX = INFINITY, maxX = -INFINITY, minY = INFINITY, maxY = -INFINITY;
+    float nearest = 0.0f;
+    for (int i = 0; i < 8; ++i)
+    {
+        const float p[3] = {(i & 4) ? box.max[0] : box.min[0],
+                            (i & 2) ? box.max[1] : box.min[1],
+                            (i & 1) ? box.max[2] : box.min[2]};
+        float clip[3];
+        transform(p, clip);
+        // Atravessa o plano da câmera: não dá para projetar, considera visível.
+        if (clip[2] < NEAR_W)
+            return true;
+
+        float invW = 1.0f / clip[2];
+        float sx = (clip[0] * invW * 0.5f + 0.5f) * WIDTH;
+        float sy = (clip[1] * invW * 0.5f + 0.5f) * HEIGHT;
+        minX = std::min(minX, sx);
+        maxX = std::max(maxX, sx);
+        minY = std::min(minY, sy);
+        maxY = std::max(maxY, sy);
+        nearest = std::max(nearest, invW);
+    }
+
+    // Fora da tela fica para o recorte do próprio OpenGL.
+    if (maxX < 0.0f || minX >= WIDTH || maxY < 0.0f || minY >= HEIGHT)
+        return true;
+    // Um pixel a mais de cada lado: o oclusor amostra no centro, então a borda dele
+    // pode marcar um pixel que só cobre em parte.
+    int x0 = std::max(0, static_cast<int>(std::floor(minX)) - 1);
+    int x1 = std::min(WIDTH - 1, static_cast<int>(std::floor(maxX)) + 1);
+    int y0 = std::max(0, static_cast<int>(std::floor(minY)) - 1);
+    int y1 = std::min(HEIGHT - 1, static_cast<int>(std::floor(maxY)) + 1);
+
+    // Visível se algum pixel do retângulo tem oclusor mais longe que o ponto mais próximo da caixa.
+#ifdef OCCLUSION_SSE
+    const __m128 boxDepth = _mm_set1_ps(nearest);
+    const __m128i lane = _mm_setr_epi32(0, 1, 2, 3);
+    for (int y = y0; y <= y1; ++y)
+    {
+        const float *row = depth + y * WIDTH;
+        for (int x = x0 & ~3; x <= x1; x += 4)
+        {
+            __m128i column = _mm_add_epi32(_mm_set1_epi32(x), lane);
+            __m128 inRect = _mm_castsi128_ps(_mm_and_si128(_mm_cmpgt_epi32(column, _mm_set1_epi32(x0 - 1)),
+                                                           _mm_cmplt_epi32(column, _mm_set1_epi32(x1 + 1))));
+            if (_mm_movemask_ps(_mm_and_ps(inRect, _mm_cmplt_ps(_mm_load_ps(row + x), boxDepth))) != 0)
+                return true;
+        }
+    }
+#else
+    for (int y = y0; y <= y1; ++y)
+    {
+        const float *row = depth + y * WIDTH;
+        for (int x = x0; x <= x1; ++x)
+            if (row[x] < nearest)
+                return true;
+    }
+#endif
+    return false;
+}
@@ -0,0 +1,82 @@
+#ifndef OCCLUSION_CULLER_HPP
+#define OCCLUSION_CULLER_HPP
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "matrix.hpp"
+
+// Oclusão por software para o mapa aberto.
+// Alguns oclusores simplificados (caixas dentro das casas e pedras grandes, relevo do
+// terreno) são rasterizados em um depth buffer pequeno; depois a caixa de cada objeto
+// é testada contra ele. Tudo roda em uma thread própria, criada uma vez e acordada a cada
+// launch(), enquanto o update simula o frame; o render espera o resultado antes de montar
+// a lista de desenho.
+//
+// Os oclusores ficam dentro da geometria real e o retângulo testado ganha um pixel de
+// folga em volta, então o erro é sempre para o lado de desenhar a mais.
+class OcclusionCuller
+{
+public:
+    static const int WIDTH = 160;
+    static const int HEIGHT = 96;
+
+    struct Box
+    {
+        float min[3];
+        float max[3];
+    };
+
+    ~OcclusionCuller();
+
+    // Montagem do trabalho, no thread principal.
+    void begin(const Mat4 &viewProjection);
+    void addOccluder(const Box &box);
+    // Retorna o índice para consultar isVisible depois do wait().
+    int addOccludee(const Box &box);
+    // Malha fixa do terreno (x, y, z por vértice), usada até ser trocada.
+    void setTerrain(const std::vector<float> &positions, const std::vector<unsigned int> &indices);
+
+    void launch();
+    void wait();
+    // Espera e só fica com o resultado se a câmera do render é a mesma que foi rasterizada:
+    // mouse e reshape mudam a câmera entre o update e o display.
+    void wait(const Mat4 &viewProjection);
+    // Descarta o resultado pendente (mapa trocado, objetos recriados).
+    void invalidate();
+
+    bool isReady() const { return ready; }
+    // Sem resultado válido tudo é visível.
+    bool isVisible(int index) const;
+
+private:
+    alignas(16) float depth[WIDTH * HEIGHT]; // 1/w: maior = mais perto, 0 = nada desenhado
+
+    Mat4 viewProjection;
+    std::vector<Box> occluders;
+    std::vector<Box> occludees;
+    std::vector<float> terrainPositions;
+    std::vector<unsigned int> terrainIndices;
+    std::vector<unsigned char> visible;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    bool pending = false;  // trabalho entregue e ainda não terminado (protegido pelo mutex)
+    bool stopping = false; // idem
+    bool launched = false; // só no thread principal: launch() sem wait() correspondente
+    bool ready = false;
+
+    void workerLoop();
+    void run();
+    void clearDepth();
+    void transform(const float p[3], float out[3]) const;
+    void drawClipTriangle(const float a[3], const float b[3], const float c[3]);
+    void rasterize(const float a[3], const float b[3], const float c[3]);
+    void drawBox(const Box &box);
+    bool testBox(const Box &box) const;
+};
+
+#endif
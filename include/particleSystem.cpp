@@ -0,0 +1,296 @@
+#include "particleSystem.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Cores iguais às esferas que o takeDamage desenhava para cada tipo de ataque.
+const ParticleSystem::Preset ParticleSystem::presets[ParticleSystem::EFFECT_COUNT] = {
+    // r     g     b     speed upward gravity life  size
+    {1.0f, 0.0f, 0.0f, 2.5f, 1.0f, -6.0f, 0.45f, 0.12f}, // HIT_PHYSICAL
+    {1.0f, 0.5f, 0.0f, 1.5f, 1.5f, 1.0f, 0.60f, 0.16f},  // HIT_FIRE
+    {0.0f, 0.7f, 1.0f, 2.0f, 0.5f, -4.0f, 0.70f, 0.10f}, // HIT_ICE
+    {0.0f, 1.0f, 0.0f, 0.8f, 0.6f, -0.5f, 1.00f, 0.18f}, // HIT_POISON
+    {0.5f, 0.0f, 0.5f, 1.8f, 0.8f, 0.0f, 0.80f, 0.14f},  // HIT_MAGIC
+    {1.0f, 0.6f, 0.1f, 0.15f, 0.9f, 0.3f, 1.20f, 0.05f}, // BONFIRE
+    {0.6f, 0.3f, 1.0f, 1.2f, 0.4f, 0.0f, 1.00f, 0.08f},  // PORTAL
+};
+
+float ParticleSystem::px[ParticleSystem::MAX_PARTICLES];
+float ParticleSystem::py[ParticleSystem::MAX_PARTICLES];
+float ParticleSystem::pz[ParticleSystem::MAX_PARTICLES];
+float ParticleSystem::vx[ParticleSystem::MAX_PARTICLES];
+float ParticleSystem::vy[ParticleSystem::MAX_PARTICLES];
+float ParticleSystem::vz[ParticleSystem::MAX_PARTICLES];
+float ParticleSystem::gravity[ParticleSystem::MAX_PARTICLES];
+float ParticleSystem::life[ParticleSystem::MAX_PARTICLES];
+float ParticleSystem::invMaxLife[ParticleSystem::MAX_PARTICLES];
+float ParticleSystem::size[ParticleSystem::MAX_PARTICLES];
+GLubyte ParticleSystem::color[ParticleSystem::MAX_PARTICLES][3];
+int ParticleSystem::alive = 0;
+
+ParticleSystem::ParticleVertex ParticleSystem::vertices[ParticleSystem::MAX_PARTICLES * 4];
+GLuint ParticleSystem::spriteTexture = 0;
+unsigned int ParticleSystem::seed = 2463534242u;
+
+float ParticleSystem::random01()
+{
+    // xorshift32: barato e sem mexer na sequência do rand() usada na geração dos mapas.
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return (seed >> 8) * (1.0f / 16777216.0f);
+}
+
+float ParticleSystem::randomRange(float lo, float hi)
+{
+    return lo + (hi - lo) * random01();
+}
+
+int ParticleSystem::spawnCount(float rate, float deltaTime)
+{
+    float amount = rate * deltaTime;
+    int whole = static_cast<int>(amount);
+    if (random01() < amount - whole)
+        ++whole;
+    return whole;
+}
+
+int ParticleSystem::spawn(Effect effect, float x, float y, float z, float velX, float velY, float velZ, float scale)
+{
+    // Pool cheio: a partícula nova é descartada, nunca realoca.
+    if (alive >= MAX_PARTICLES)
+        return -1;
+
+    const Preset &preset = presets[effect];
+    int i = alive++;
+    px[i] = x;
+    py[i] = y;
+    pz[i] = z;
+    vx[i] = velX;
+    vy[i] = velY;
+    vz[i] = velZ;
+    gravity[i] = preset.gravity;
+    life[i] = preset.life * randomRange(0.7f, 1.0f);
+    invMaxLife[i] = 1.0f / life[i];
+    size[i] = preset.size * scale * randomRange(0.7f, 1.2f);
+
+    float shade = randomRange(0.8f, 1.0f);
+    color[i][0] = static_cast<GLubyte>(preset.r * shade * 255.0f);
+    color[i][1] = static_cast<GLubyte>(preset.g * shade * 255.0f);
+    color[i][2] = static_cast<GLubyte>(preset.b * shade * 255.0f);
+    return i;
+}
+
+void ParticleSystem::burst(Effect effect, int amount, float x, float y, float z, float scale)
+{
+    const Preset &preset = presets[effect];
+    for (int n = 0; n < amount; ++n)
+    {
+        float dx = randomRange(-1.0f, 1.0f);
+        float dy = randomRange(-1.0f, 1.0f);
+        float dz = randomRange(-1.0f, 1.0f);
+        float speed = preset.speed * scale * randomRange(0.5f, 1.0f);
+        if (spawn(effect, x + dx * 0.1f * scale, y + dy * 0.1f * scale, z + dz * 0.1f * scale,
+                  dx * speed, dy * speed + preset.upward * scale, dz * speed, scale) < 0)
+            return;
+    }
+}
+
+void ParticleSystem::emitHit(float x, float y, float z, AttackType attack, float scale)
+{
+    Effect effect;
+    switch (attack)
+    {
+    case AttackType::PHYSICAL:
+        effect = HIT_PHYSICAL;
+        break;
+    case AttackType::FIRE:
+        effect = HIT_FIRE;
+        break;
+    case AttackType::ICE:
+        effect = HIT_ICE;
+        break;
+    case AttackType::POISON:
+        effect = HIT_POISON;
+        break;
+    case AttackType::MAGIC:
+        effect = HIT_MAGIC;
+        break;
+    default:
+        return;
+    }
+    burst(effect, static_cast<int>(24 * scale), x, y, z, scale);
+
+    // Fogo e magia também iluminam o entorno por um instante.
+    if (effect == HIT_FIRE || effect == HIT_MAGIC)
+    {
+        const Preset &preset = presets[effect];
+        LightManager::flash(x, y + 0.3f, z, preset.r, preset.g, preset.b, 4.0f * scale, 0.4f);
+    }
+}
+
+void ParticleSystem::emitBonfire(float x, float y, float z, float size, float deltaTime)
+{
+    const Preset &preset = presets[BONFIRE];
+    int amount = spawnCount(30.0f, deltaTime);
+    for (int n = 0; n < amount; ++n)
+    {
+        spawn(BONFIRE,
+              x + randomRange(-0.15f, 0.15f), y + size * 0.3f + 0.1f, z + randomRange(-0.15f, 0.15f),
+              randomRange(-preset.speed, preset.speed), preset.upward * randomRange(0.6f, 1.2f),
+              randomRange(-preset.speed, preset.speed), 1.0f);
+    }
+}
+
+void ParticleSystem::emitPortal(float x, float y, float z, float size, float deltaTime)
+{
+    const Preset &preset = presets[PORTAL];
+    int amount = spawnCount(40.0f, deltaTime);
+    for (int n = 0; n < amount; ++n)
+    {
+        // Nasce na borda do disco girando no sentido dos anéis e puxada para o centro.
+        float angle = random01() * 2.0f * M_PI;
+        float c = cosf(angle), s = sinf(angle);
+        float radius = size * randomRange(0.8f, 1.1f);
+        spawn(PORTAL,
+              x + c * radius, y + randomRange(0.0f, 0.1f), z + s * radius,
+              (-s - c * 0.4f) * preset.speed, preset.upward * randomRange(0.5f, 1.0f), (c - s * 0.4f) * preset.speed, 1.0f);
+    }
+}
+
+void ParticleSystem::update(float deltaTime)
+{
+    const int n = alive;
+
+    // Laço sem desvios sobre arrays contíguos: o compilador vetoriza.
+    for (int i = 0; i < n; ++i)
+    {
+        vy[i] += gravity[i] * deltaTime;
+        px[i] += vx[i] * deltaTime;
+        py[i] += vy[i] * deltaTime;
+        pz[i] += vz[i] * deltaTime;
+        life[i] -= deltaTime;
+    }
+
+    int i = 0;
+    while (i < alive)
+    {
+        if (life[i] > 0.0f)
+        {
+            ++i;
+            continue;
+        }
+
+        int last = --alive;
+        px[i] = px[last];
+        py[i] = py[last];
+        pz[i] = pz[last];
+        vx[i] = vx[last];
+        vy[i] = vy[last];
+        vz[i] = vz[last];
+        gravity[i] = gravity[last];
+        life[i] = life[last];
+        invMaxLife[i] = invMaxLife[last];
+        size[i] = size[last];
+        color[i][0] = color[last][0];
+        color[i][1] = color[last][1];
+        color[i][2] = color[last][2];
+    }
+}
+
+void ParticleSystem::clear()
+{
+    alive = 0;
+}
+
+void ParticleSystem::createSpriteTexture()
+{
+    // Disco com borda suave, usado como alfa de todas as partículas.
+    const int SPRITE_SIZE = 32;
+    std::vector<GLubyte> pixels(SPRITE_SIZE * SPRITE_SIZE);
+    for (int y = 0; y < SPRITE_SIZE; ++y)
+    {
+        for (int x = 0; x < SPRITE_SIZE; ++x)
+        {
+            float dx = (x + 0.5f) / SPRITE_SIZE * 2.0f - 1.0f;
+            float dy = (y + 0.5f) / SPRITE_SIZE * 2.0f - 1.0f;
+            float falloff = std::max(0.0f, 1.0f - std::sqrt(dx * dx + dy * dy));
+            pixels[y * SPRITE_SIZE + x] = static_cast<GLubyte>(falloff * falloff * 255.0f);
+        }
+    }
+
+    GLuint previous = GLState::boundTexture();
+    glGenTextures(1, &spriteTexture);
+    GLState::bindTexture(spriteTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, SPRITE_SIZE, SPRITE_SIZE, 0, GL_ALPHA, GL_UNSIGNED_BYTE, pixels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    GLState::bindTexture(previous);
+}
+
+void ParticleSystem::draw()
+{
+    if (alive == 0)
+        return;
+    if (!spriteTexture)
+        createSpriteTexture();
+
+    // Linhas da view = eixos direita/cima da câmera no mundo.
+    const Mat4 &view = GLState::modelview();
+    const float right[3] = {view.m[0], view.m[4], view.m[8]};
+    const float up[3] = {view.m[1], view.m[5], view.m[9]};
+    const float corners[4][4] = {{-1.0f, -1.0f, 0.0f, 0.0f}, {1.0f, -1.0f, 1.0f, 0.0f}, {1.0f, 1.0f, 1.0f, 1.0f}, {-1.0f, 1.0f, 0.0f, 1.0f}};
+
+    for (int i = 0; i < alive; ++i)
+    {
+        // Encolhe e apaga conforme a vida acaba.
+        float t = std::max(0.0f, life[i] * invMaxLife[i]);
+        float half = size[i] * (0.5f + 0.5f * t);
+        GLubyte a = static_cast<GLubyte>(t * 255.0f);
+
+        ParticleVertex *quad = &vertices[i * 4];
+        for (int k = 0; k < 4; ++k)
+        {
+            float cx = corners[k][0] * half;
+            float cy = corners[k][1] * half;
+            quad[k].x = px[i] + right[0] * cx + up[0] * cy;
+            quad[k].y = py[i] + right[1] * cx + up[1] * cy;
+            quad[k].z = pz[i] + right[2] * cx + up[2] * cy;
+            quad[k].u = corners[k][2];
+            quad[k].v = corners[k][3];
+            quad[k].r = color[i][0];
+            quad[k].g = color[i][1];
+            quad[k].b = color[i][2];
+            quad[k].a = a;
+        }
+    }
+
+    GLState::pushAttrib();
+    GLState::disable(GL_LIGHTING);
+    GLState::enable(GL_TEXTURE_2D);
+    GLState::bindTexture(spriteTexture);
+    GLState::texEnvMode(GL_MODULATE);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE);
+    // Testa contra a cena mas não escreve profundidade, então a ordem entre partículas não importa.
+    glDepthMask(GL_FALSE);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(ParticleVertex), &vertices[0].x);
+    glTexCoordPointer(2, GL_FLOAT, sizeof(ParticleVertex), &vertices[0].u);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(ParticleVertex), &vertices[0].r);
+    glDrawArrays(GL_QUADS, 0, alive * 4);
+    GLState::forgetCurrent(GLState::CURRENT_COLOR | GLState::CURRENT_TEXCOORD);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    glDepthMask(GL_TRUE);
+    GLState::popAttrib();
+}
@@ -0,0 +1,81 @@
+#ifndef PARTICLE_SYSTEM_HPP
+#define PARTICLE_SYSTEM_HPP
+
+#include "glState.hpp"
+#include "data.hpp"
+#include "lightManager.hpp"
+
+// Partículas de efeito (golpes, fogueira, portal) em um pool fixo.
+// Os atributos ficam em arrays separados (struct-of-arrays) para o laço de
+// integração ser linear e vetorizável; mortas saem por troca com a última.
+// A lógica só emite, o desenho acontece uma vez por frame no render.
+class ParticleSystem
+{
+public:
+    static const int MAX_PARTICLES = 4096;
+
+    enum Effect
+    {
+        HIT_PHYSICAL,
+        HIT_FIRE,
+        HIT_ICE,
+        HIT_POISON,
+        HIT_MAGIC,
+        BONFIRE,
+        PORTAL,
+        EFFECT_COUNT
+    };
+
+    // scale: tamanho do alvo (inimigo comum = 1, boss maior).
+    static void emitHit(float x, float y, float z, AttackType attack, float scale = 1.0f);
+    // Emissores contínuos, chamados no update do objeto com o deltaTime do frame.
+    static void emitBonfire(float x, float y, float z, float size, float deltaTime);
+    static void emitPortal(float x, float y, float z, float size, float deltaTime);
+
+    static void update(float deltaTime);
+    // Quads voltados para a câmera atual do GLState, em uma chamada, com blend aditivo.
+    static void draw();
+    static void clear();
+    static int count() { return alive; }
+
+private:
+    struct Preset
+    {
+        float r, g, b;
+        float speed, upward;
+        float gravity;
+        float life;
+        float size;
+    };
+
+    struct ParticleVertex
+    {
+        GLfloat x, y, z;
+        GLfloat u, v;
+        GLubyte r, g, b, a;
+    };
+
+    static const Preset presets[EFFECT_COUNT];
+
+    static float px[MAX_PARTICLES], py[MAX_PARTICLES], pz[MAX_PARTICLES];
+    static float vx[MAX_PARTICLES], vy[MAX_PARTICLES], vz[MAX_PARTICLES];
+    static float gravity[MAX_PARTICLES];
+    static float life[MAX_PARTICLES], invMaxLife[MAX_PARTICLES];
+    static float size[MAX_PARTICLES];
+    static GLubyte color[MAX_PARTICLES][3];
+    static int alive;
+
+    static ParticleVertex vertices[MAX_PARTICLES * 4];
+    static GLuint spriteTexture;
+    static unsigned int seed;
+
+    static float random01();
+    static float randomRange(float lo, float hi);
+    // Número de partículas de um emissor contínuo neste frame (parte fracionária sorteada).
+    static int spawnCount(float rate, float deltaTime);
+    static int spawn(Effect effect, float x, float y, float z, float vx, float vy, float vz, float scale);
+    static void burst(Effect effect, int amount, float x, float y, float z, float scale);
+    static void createSpriteTexture();
+};
+
+#endif
@@ -48,95 +48,116 @@ void Player::handleMovement(){
 
 void Player::draw()
 {
-    glPushMatrix();
-    glTranslatef(x, y, z);
-    glRotatef(rotY, 0.0f, 1.0f, 0.0f);
+    GLState::pushMatrix();
+    GLState::translate(x, y, z);
+    GLState::rotate(rotY, 0.0f, 1.0f, 0.0f);
 
-    glEnable(GL_LIGHTING);
-    glEnable(GL_TEXTURE_2D);
-    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    GLState::enable(GL_LIGHTING);
+    GLState::enable(GL_TEXTURE_2D);
+    GLState::texEnvMode(GL_MODULATE);
 
-    glBindTexture(GL_TEXTURE_2D, texturaJogador);
+    GLState::bindTexture(texturaJogador);
 
     GLfloat bodyAmbient[] = {0.4f, 0.4f, 0.4f, 1.0f};
     GLfloat bodyDiffuse[] = {1.0f, 1.0f, 1.0f, 1.0f};
     GLfloat bodySpecular[] = {0.2f, 0.2f, 0.2f, 1.0f};
     GLfloat bodyShininess = 10.0f;
 
-    glMaterialfv(GL_FRONT, GL_AMBIENT, bodyAmbient);
-    glMaterialfv(GL_FRONT, GL_DIFFUSE, bodyDiffuse);
-    glMaterialfv(GL_FRONT, GL_SPECULAR, bodySpecular);
-    glMaterialf(GL_FRONT, GL_SHININESS, bodyShininess);
+    GLState::material(GL_AMBIENT, bodyAmbient);
+    GLState::material(GL_DIFFUSE, bodyDiffuse);
+    GLState::material(GL_SPECULAR, bodySpecular);
+    GLState::materialf(GL_SHININESS, bodyShininess);
 
     float size = 0.3f;
 
-    glBegin(GL_QUADS);
+    if (Renderer::isActive())
+    {
+        Renderer::matchFixedFunction(1.0f, 1.0f, 1.0f);
+        GLState::pushMatrix();
+        GLState::scale(size * 2.0f, size * 2.0f, size * 2.0f);
+        Renderer::draw(Renderer::unitCube());
+        GLState::popMatrix();
+    }
+    else
+    {
+        glBegin(GL_QUADS);
     
-    glNormal3f(0.0f, 0.0f, 1.0f); 
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(-size, -size,  size);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f( size, -size,  size);
-    glTexCoord2f(1.0f, 1.0f); glVertex3f( size,  size,  size);
-    glTexCoord2f(0.0f, 1.0f); glVertex3f(-size,  size,  size);
-
-    glNormal3f(0.0f, 0.0f, -1.0f); 
-    glTexCoord2f(0.0f, 1.0f); glVertex3f( size, -size, -size);
-    glTexCoord2f(1.0f, 1.0f); glVertex3f(-size, -size, -size);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f(-size,  size, -size);
-    glTexCoord2f(0.0f, 0.0f); glVertex3f( size,  size, -size);
-
-    glNormal3f(1.0f, 0.0f, 0.0f); 
-    glTexCoord2f(0.0f, 0.0f); glVertex3f( size, -size,  size);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f( size, -size, -size);
-    glTexCoord2f(1.0f, 1.0f); glVertex3f( size,  size, -size);
-    glTexCoord2f(0.0f, 1.0f); glVertex3f( size,  size,  size);
-
-    glNormal3f(-1.0f, 0.0f, 0.0f);  
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(-size, -size, -size);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f(-size, -size,  size);
-    glTexCoord2f(1.0f, 1.0f); glVertex3f(-size,  size,  size);
-    glTexCoord2f(0.0f, 1.0f); glVertex3f(-size,  size, -size);
+        GLState::normal(0.0f, 0.0f, 1.0f); 
+        GLState::texCoord(0.0f, 0.0f); glVertex3f(-size, -size,  size);
+        GLState::texCoord(1.0f, 0.0f); glVertex3f( size, -size,  size);
+        GLState::texCoord(1.0f, 1.0f); glVertex3f( size,  size,  size);
+        GLState::texCoord(0.0f, 1.0f); glVertex3f(-size,  size,  size);
+
+        GLState::normal(0.0f, 0.0f, -1.0f); 
+        GLState::texCoord(0.0f, 1.0f); glVertex3f( size, -size, -size);
+        GLState::texCoord(1.0f, 1.0f); glVertex3f(-size, -size, -size);
+        GLState::texCoord(1.0f, 0.0f); glVertex3f(-size,  size, -size);
+        GLState::texCoord(0.0f, 0.0f); glVertex3f( size,  size, -size);
+
+        GLState::normal(1.0f, 0.0f, 0.0f); 
+        GLState::texCoord(0.0f, 0.0f); glVertex3f( size, -size,  size);
+        GLState::texCoord(1.0f, 0.0f); glVertex3f( size, -size, -size);
+        GLState::texCoord(1.0f, 1.0f); glVertex3f( size,  size, -size);
+        GLState::texCoord(0.0f, 1.0f); glVertex3f( size,  size,  size);
+
+        GLState::normal(-1.0f, 0.0f, 0.0f);  
+        GLState::texCoord(0.0f, 0.0f); glVertex3f(-size, -size, -size);
+        GLState::texCoord(1.0f, 0.0f); glVertex3f(-size, -size,  size);
+        GLState::texCoord(1.0f, 1.0f); glVertex3f(-size,  size,  size);
+        GLState::texCoord(0.0f, 1.0f); glVertex3f(-size,  size, -size);
     
-    glNormal3f(0.0f, 1.0f, 0.0f);  
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(-size,  size,  size);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f( size,  size,  size);
-    glTexCoord2f(1.0f, 1.0f); glVertex3f( size,  size, -size);
-    glTexCoord2f(0.0f, 1.0f); glVertex3f(-size,  size, -size);
-
-    glNormal3f(0.0f, -1.0f, 0.0f); 
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(-size, -size, -size);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f( size, -size, -size);
-    glTexCoord2f(1.0f, 1.0f); glVertex3f( size, -size,  size);
-    glTexCoord2f(0.0f, 1.0f); glVertex3f(-size, -size,  size);
+        GLState::normal(0.0f, 1.0f, 0.0f);  
+        GLState::texCoord(0.0f, 0.0f); glVertex3f(-size,  size,  size);
+        GLState::texCoord(1.0f, 0.0f); glVertex3f( size,  size,  size);
+        GLState::texCoord(1.0f, 1.0f); glVertex3f( size,  size, -size);
+        GLState::texCoord(0.0f, 1.0f); glVertex3f(-size,  size, -size);
+
+        GLState::normal(0.0f, -1.0f, 0.0f); 
+        GLState::texCoord(0.0f, 0.0f); glVertex3f(-size, -size, -size);
+        GLState::texCoord(1.0f, 0.0f); glVertex3f( size, -size, -size);
+        GLState::texCoord(1.0f, 1.0f); glVertex3f( size, -size,  size);
+        GLState::texCoord(0.0f, 1.0f); glVertex3f(-size, -size,  size);
     
-    glEnd();
+        glEnd();
+    }
 
-    glBindTexture(GL_TEXTURE_2D, texturaJogadorCabeca);
+    GLState::bindTexture(texturaJogadorCabeca);
 
     GLfloat headAmbient[] = {0.3f, 0.3f, 0.4f, 1.0f};
     GLfloat headDiffuse[] = {1.0f, 1.0f, 1.0f, 1.0f};
     GLfloat headSpecular[] = {0.5f, 0.5f, 0.5f, 1.0f};
     GLfloat headShininess = 30.0f;
 
-    glMaterialfv(GL_FRONT, GL_AMBIENT, headAmbient);
-    glMaterialfv(GL_FRONT, GL_DIFFUSE, headDiffuse);
-    glMaterialfv(GL_FRONT, GL_SPECULAR, headSpecular);
-    glMaterialf(GL_FRONT, GL_SHININESS, headShininess);
+    GLState::material(GL_AMBIENT, headAmbient);
+    GLState::material(GL_DIFFUSE, headDiffuse);
+    GLState::material(GL_SPECULAR, headSpecular);
+    GLState::materialf(GL_SHININESS, headShininess);
 
-    glPushMatrix();
-    glTranslatef(0.0f, size + 0.2f, 0.0f); 
-    glRotatef(115.0f, 0.0f, 0.0f, 1.0f);
-    glRotatef(75.0f, 0.0f, 1.0f, 0.0f);
+    GLState::pushMatrix();
+    GLState::translate(0.0f, size + 0.2f, 0.0f); 
+    GLState::rotate(115.0f, 0.0f, 0.0f, 1.0f);
+    GLState::rotate(75.0f, 0.0f, 1.0f, 0.0f);
     
-    GLUquadric* headQuad = gluNewQuadric();
-    gluQuadricTexture(headQuad, GL_TRUE);
-    gluQuadricNormals(headQuad, GLU_SMOOTH);
-    gluSphere(headQuad, 0.3f, 24, 24);
-    gluDeleteQuadric(headQuad);
+    if (Renderer::isActive())
+    {
+        Renderer::matchFixedFunction(1.0f, 1.0f, 1.0f);
+        GLState::scale(0.3f, 0.3f, 0.3f);
+        Renderer::draw(Renderer::unitSphere());
+    }
+    else
+    {
+        GLUquadric* headQuad = gluNewQuadric();
+        gluQuadricTexture(headQuad, GL_TRUE);
+        gluQuadricNormals(headQuad, GLU_SMOOTH);
+        gluSphere(headQuad, 0.3f, 24, 24);
+        GLState::forgetCurrent(GLState::CURRENT_NORMAL | GLState::CURRENT_TEXCOORD);
+        gluDeleteQuadric(headQuad);
+    }
     
-    glPopMatrix();
+    GLState::popMatrix();
 
-    glDisable(GL_TEXTURE_2D);
-    glPopMatrix();
+    GLState::disable(GL_TEXTURE_2D);
+    GLState::popMatrix();
 }
 
 void Player::moveForward(){
@@ -182,60 +203,7 @@ void Player::takeDamage(float amount, const AttackType &attack){
     health -= amount;
     if (health < 0) health = 0;
 
-    glPushAttrib(GL_LIGHTING_BIT | GL_CURRENT_BIT);
-    
-    glEnable(GL_COLOR_MATERIAL);
-    
-    switch (attack){
-    case AttackType::PHYSICAL:
-        std::cout << "Displaying physical effect: impact!" << std::endl;
-        glColor3f(1.0f, 0.0f, 0.0f);
-        glPushMatrix();
-        glTranslatef(x, y, z); 
-        glutSolidSphere(0.4f, 16, 16);  
-        glPopMatrix();
-        break;
-
-    case AttackType::FIRE:
-        std::cout << "Displaying fire effect: flame burst!" << std::endl;
-        glColor3f(1.0f, 0.5f, 0.0f);
-        glPushMatrix();
-        glTranslatef(x, y, z);
-        glutSolidSphere(0.3f, 16, 16); 
-        glPopMatrix();
-        break;
-
-    case AttackType::ICE:
-        std::cout << "Displaying ice effect: freezing!" << std::endl;
-        glColor3f(0.0f, 0.7f, 1.0f);
-        glPushMatrix();
-        glTranslatef(x, y, z);
-        glutSolidSphere(0.4f, 16, 16); 
-        glPopMatrix();
-        break;
-
-    case AttackType::POISON:
-        std::cout << "Displaying poison effect: toxic pools!" << std::endl;
-        glColor3f(0.0f, 1.0f, 0.0f);
-        glPushMatrix();
-        glTranslatef(x, y, z); 
-        glutSolidSphere(0.35f, 16, 16); 
-        glPopMatrix();
-        break;
-
-    case AttackType::MAGIC:
-        std::cout << "Displaying magic effect: magic glow!" << std::endl;
-        glColor3f(0.5f, 0.0f, 0.5f);
-        glPushMatrix();
-        glTranslatef(x, y, z); 
-        glutSolidSphere(0.45f, 16, 16);
-        glPopMatrix();
-        break;
-
-    default:
-        std::cout << "Unknown effect type!" << std::endl;
-    }
-    glPopAttrib();
+    ParticleSystem::emitHit(x, y, z, attack);
 }
 
 void Player::heal(float amount)
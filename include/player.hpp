@@ -6,6 +6,9 @@
 #include <iostream>
 #include <cmath>
 #include <GL/glut.h>
+#include "glState.hpp"
+#include "renderer.hpp"
+#include "particleSystem.hpp"
 #include <GL/gl.h>
 
 class Player : public GameObject
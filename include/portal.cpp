@@ -4,14 +4,27 @@ extern unsigned int texturaPortal;
 
 Portal::Portal(float x, float y, float z, float size, float destX, float destZ, MapType destMap)
     : GameObject(x, y, z, size, ObjectType::PORTAL),
-      destinationX(destX), destinationZ(destZ), destinationMap(destMap) {}
+      destinationX(destX), destinationZ(destZ), destinationMap(destMap)
+{
+    lightId = LightManager::add(x, y + 0.5f, z, 0.6f, 0.3f, 1.0f, 5.0f);
+}
+
+Portal::~Portal()
+{
+    LightManager::remove(lightId);
+}
+
+void Portal::update(float deltaTime)
+{
+    ParticleSystem::emitPortal(x, y, z, size, deltaTime);
+}
 
 void Portal::draw()
 {
     float time = glutGet(GLUT_ELAPSED_TIME) / 1000.0f;
 
-    glPushMatrix();
-    glTranslatef(x, y, z);
+    GLState::pushMatrix();
+    GLState::translate(x, y, z);
 
     // Pulsação
     float scale = 1.0f + 0.1f * sin(time * 3.0f);
@@ -20,31 +33,31 @@ void Portal::draw()
     float b = 1.0f;
 
     // Salvar estado atual
-    glPushAttrib(GL_ALL_ATTRIB_BITS);
+    GLState::pushAttrib();
     
     // Configuração para blending (transparência)
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     // Desabilitar iluminação temporariamente para desenhar o centro do portal
-    glDisable(GL_LIGHTING);
+    GLState::disable(GL_LIGHTING);
     
     // Textura para o centro do portal (disco)
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, texturaPortal); // Você precisa ter essa textura carregada
+    GLState::enable(GL_TEXTURE_2D);
+    GLState::bindTexture(texturaPortal); // Você precisa ter essa textura carregada
     
     // Configurar modo da textura para DECAL (substituir a cor sem iluminação)
-    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_DECAL);
+    GLState::texEnvMode(GL_DECAL);
     
     // Desenhar o disco central com textura
-    glPushMatrix();
-    glScalef(scale, 1.0f, scale);
-    glRotatef(90.0f, 1.0f, 0.0f, 0.0f); // Rotacionar para ficar no plano xz
+    GLState::pushMatrix();
+    GLState::scale(scale, 1.0f, scale);
+    GLState::rotate(90.0f, 1.0f, 0.0f, 0.0f); // Rotacionar para ficar no plano xz
     
     // Desenhar o disco com coordenadas de textura
     glBegin(GL_TRIANGLE_FAN);
-    glColor4f(r, g, b, 0.8f);
-    glTexCoord2f(0.5f, 0.5f);
+    GLState::color(r, g, b, 0.8f);
+    GLState::texCoord(0.5f, 0.5f);
     glVertex3f(0.0f, 0.0f, 0.0f); // Centro do disco
     
     // Vértices do disco com coordenadas de textura
@@ -56,23 +69,23 @@ void Portal::draw()
         float x = size * cos(angle);
         float z = size * sin(angle);
         
-        glTexCoord2f(texX, texY);
+        GLState::texCoord(texX, texY);
         glVertex3f(x, 0.0f, z);
     }
     glEnd();
-    glPopMatrix();
+    GLState::popMatrix();
     
     // Rotação de textura para efeito de vórtex
-    glMatrixMode(GL_TEXTURE);
-    glPushMatrix();
-    glLoadIdentity();
-    glTranslatef(0.5f, 0.5f, 0.0f); // Mover para o centro da textura
-    glRotatef(time * 30.0f, 0.0f, 0.0f, 1.0f); // Rotacionar a textura
-    glTranslatef(-0.5f, -0.5f, 0.0f); // Voltar da origem
-    glMatrixMode(GL_MODELVIEW);
+    GLState::matrixMode(GL_TEXTURE);
+    GLState::pushMatrix();
+    GLState::loadIdentity();
+    GLState::translate(0.5f, 0.5f, 0.0f); // Mover para o centro da textura
+    GLState::rotate(time * 30.0f, 0.0f, 0.0f, 1.0f); // Rotacionar a textura
+    GLState::translate(-0.5f, -0.5f, 0.0f); // Voltar da origem
+    GLState::matrixMode(GL_MODELVIEW);
     
     // Desabilitar textura para os anéis
-    glDisable(GL_TEXTURE_2D);
+    GLState::disable(GL_TEXTURE_2D);
     
     // Efeito de material brilhante para os anéis
     GLfloat materialAmbient[] = {r * 0.3f, g * 0.3f, b * 0.3f, 0.7f};
@@ -81,32 +94,33 @@ void Portal::draw()
     GLfloat materialShininess = 50.0f;
     
     // Reativar iluminação para os anéis
-    glEnable(GL_LIGHTING);
-    glMaterialfv(GL_FRONT, GL_AMBIENT, materialAmbient);
-    glMaterialfv(GL_FRONT, GL_DIFFUSE, materialDiffuse);
-    glMaterialfv(GL_FRONT, GL_SPECULAR, materialSpecular);
-    glMaterialf(GL_FRONT, GL_SHININESS, materialShininess);
+    GLState::enable(GL_LIGHTING);
+    GLState::material(GL_AMBIENT, materialAmbient);
+    GLState::material(GL_DIFFUSE, materialDiffuse);
+    GLState::material(GL_SPECULAR, materialSpecular);
+    GLState::materialf(GL_SHININESS, materialShininess);
     
     // Anéis giratórios com iluminação
     for (int i = 0; i < 3; i++)
     {
-        glPushMatrix();
+        GLState::pushMatrix();
         float ringAngle = time * 60.0f + i * 120;
-        glRotatef(ringAngle, 0.0f, 1.0f, 0.0f);
-        glScalef(scale, 1.0f, scale);
+        GLState::rotate(ringAngle, 0.0f, 1.0f, 0.0f);
+        GLState::scale(scale, 1.0f, scale);
         glutSolidTorus(0.05, size + 0.1f * i, 10, 20);
-        glPopMatrix();
+        GLState::forgetCurrent(GLState::CURRENT_NORMAL);
+        GLState::popMatrix();
     }
     
     // Restaurar a matriz de textura
-    glMatrixMode(GL_TEXTURE);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
+    GLState::matrixMode(GL_TEXTURE);
+    GLState::popMatrix();
+    GLState::matrixMode(GL_MODELVIEW);
     
     // Restaurar todos os atributos
-    glPopAttrib();
+    GLState::popAttrib();
     
-    glPopMatrix();
+    GLState::popMatrix();
 }
 
 
@@ -6,16 +6,22 @@
 #include "game.hpp"
 #include "player.hpp"
 #include <GL/glut.h>
+#include "glState.hpp"
+#include "particleSystem.hpp"
+#include "lightManager.hpp"
 #include <cmath>
 
 class Portal : public GameObject {
 private:
     float destinationX, destinationZ;
     MapType destinationMap;
+    int lightId;
 
 public:
     Portal(float x, float y, float z, float size, float destX, float destZ, MapType destMap);
+    ~Portal() override;
 
+    void update(float deltaTime) override;
     void draw() override;
     bool playerIsNearby(const Player& player) const;
     void teleport(Player &player, Game &game);
@@ -0,0 +1,430 @@
+#include "qualityManager.hpp"
+#include "glExt.hpp"
+#include "textRenderer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+// ULTRA mantém o visual de antes: resolução cheia, far plane 100, toda a grama e o LOD
+// começando só no far plane (tudo que aparece sai no detalhe cheio).
+const QualityManager::Settings QualityManager::TIERS[QualityManager::TIER_COUNT] = {
+    {0.5f, 40.0f, 0.25f, 10.0f, 6.0f},
+    {0.7f, 60.0f, 0.5f, 18.0f, 12.0f},
+    {0.85f, 80.0f, 0.8f, 28.0f, 20.0f},
+    {1.0f, 100.0f, 1.0f, 100.0f, 100.0f},
+};
+
+// Folga para swap e driver dentro dos 16 ms do glutTimerFunc.
+const float QualityManager::DEFAULT_BUDGET_MS = 14.0f;
+
+QualityManager::Settings QualityManager::current = QualityManager::TIERS[QualityManager::ULTRA];
+float QualityManager::cpuLevel = static_cast<float>(QualityManager::ULTRA);
+float QualityManager::gpuLevel = static_cast<float>(QualityManager::ULTRA);
+bool QualityManager::automatic = true;
+float QualityManager::budgetMs = QualityManager::DEFAULT_BUDGET_MS;
+float QualityManager::averageCpu = 0.0f;
+float QualityManager::averageGpu = 0.0f;
+double QualityManager::workMs = 0.0;
+double QualityManager::workStart = 0.0;
+double QualityManager::gpuStart = 0.0;
+float QualityManager::cpuSum = 0.0f;
+float QualityManager::gpuSum = 0.0f;
+int QualityManager::cpuFrames = 0;
+int QualityManager::gpuFrames = 0;
+GLuint QualityManager::gpuQueries[QualityManager::GPU_QUERIES] = {};
+bool QualityManager::gpuPending[QualityManager::GPU_QUERIES] = {};
+int QualityManager::gpuNext = 0;
+bool QualityManager::gpuActive = false;
+bool QualityManager::overlayVisible = false;
+float QualityManager::viewerX = 0.0f;
+float QualityManager::viewerZ = 0.0f;
+
+GLuint QualityManager::sceneTexture = 0;
+GLuint QualityManager::sceneFramebuffer = 0;
+GLuint QualityManager::sceneDepth = 0;
+int QualityManager::textureWidth = 0;
+int QualityManager::textureHeight = 0;
+int QualityManager::sceneWidth = 0;
+int QualityManager::sceneHeight = 0;
+int QualityManager::targetWidth = 0;
+int QualityManager::targetHeight = 0;
+bool QualityManager::useFramebuffer = false;
+bool QualityManager::sceneActive = false;
+
+static double nowMs()
+{
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+// Acima do orçamento desce proporcional ao excesso; só sobe com folga clara, e devagar.
+static float stepLevel(float level, float meanMs, float budgetMs)
+{
+    float error = (meanMs - budgetMs) / budgetMs;
+    if (error > 0.0f)
+        return level - std::min(1.0f, 0.25f + error * 2.0f);
+    if (error < -0.3f)
+        return level + 0.1f;
+    return level;
+}
+
+void QualityManager::setBudget(float milliseconds)
+{
+    budgetMs = std::max(1.0f, milliseconds);
+    resetWindow();
+}
+
+void QualityManager::setTier(Tier tier)
+{
+    automatic = false;
+    applyLevels(static_cast<float>(tier), static_cast<float>(tier));
+}
+
+void QualityManager::setAutomatic(bool enabled)
+{
+    automatic = enabled;
+    resetWindow();
+}
+
+float QualityManager::level() { return std::min(cpuLevel, gpuLevel); }
+
+QualityManager::Tier QualityManager::tier()
+{
+    return static_cast<Tier>(static_cast<int>(level() + 0.5f));
+}
+
+const char *QualityManager::tierName(Tier tier)
+{
+    static const char *names[TIER_COUNT] = {"LOW", "MEDIUM", "HIGH", "ULTRA"};
+    return tier >= 0 && tier < TIER_COUNT ? names[tier] : "?";
+}
+
+void QualityManager::applyLevels(float cpu, float gpu)
+{
+    auto clampLevel = [](float level) { return std::max(0.0f, std::min(level, static_cast<float>(ULTRA))); };
+    auto lerp = [](float level, float Settings::*field) {
+        int lower = std::min(static_cast<int>(level), ULTRA - 1);
+        float t = level - lower;
+        return TIERS[lower].*field + (TIERS[lower + 1].*field - TIERS[lower].*field) * t;
+    };
+    cpuLevel = clampLevel(cpu);
+    gpuLevel = clampLevel(gpu);
+
+    current.drawDistance = lerp(cpuLevel, &Settings::drawDistance);
+    current.grassDensity = lerp(cpuLevel, &Settings::grassDensity);
+    current.grassDistance = lerp(cpuLevel, &Settings::grassDistance);
+    current.lodDistance = lerp(cpuLevel, &Settings::lodDistance);
+    // Passos de 1/16 na escala: o alvo não muda de tamanho a cada ajuste pequeno.
+    current.renderScale = std::round(lerp(gpuLevel, &Settings::renderScale) * 16.0f) / 16.0f;
+}
+
+void QualityManager::beginWork()
+{
+    workStart = nowMs();
+}
+
+void QualityManager::endWork()
+{
+    workMs += nowMs() - workStart;
+}
+
+void QualityManager::beginGpu()
+{
+    if (!GLExt::loadTimerQuery())
+    {
+        gpuStart = nowMs();
+        return;
+    }
+    if (!gpuQueries[0])
+        GLExt::GenQueries(GPU_QUERIES, gpuQueries);
+
+    // Só lê o que já está pronto: nenhuma consulta espera a GPU.
+    for (int i = 0; i < GPU_QUERIES; ++i)
+    {
+        if (!gpuPending[i])
+            continue;
+        GLuint available = 0;
+        GLExt::GetQueryObjectuiv(gpuQueries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            continue;
+        GLuint nanoseconds = 0;
+        GLExt::GetQueryObjectuiv(gpuQueries[i], GL_QUERY_RESULT, &nanoseconds);
+        gpuPending[i] = false;
+        addGpuSample(static_cast<float>(nanoseconds / 1e6));
+    }
+
+    // Anel cheio (GPU muito atrás): este frame fica sem medida.
+    gpuActive = !gpuPending[gpuNext];
+    if (gpuActive)
+        GLExt::BeginQuery(GL_TIME_ELAPSED, gpuQueries[gpuNext]);
+}
+
+void QualityManager::endGpu()
+{
+    if (!GLExt::hasTimerQuery())
+    {
+        glFinish();
+        addGpuSample(static_cast<float>(nowMs() - gpuStart));
+        return;
+    }
+    if (!gpuActive)
+        return;
+    GLExt::EndQuery(GL_TIME_ELAPSED);
+    gpuPending[gpuNext] = true;
+    gpuNext = (gpuNext + 1) % GPU_QUERIES;
+    gpuActive = false;
+}
+
+void QualityManager::addGpuSample(float milliseconds)
+{
+    // Picos de carga de mapa (bake, geração) não dizem nada sobre o custo de desenhar.
+    if (milliseconds > 250.0f)
+        return;
+    averageGpu = averageGpu == 0.0f ? milliseconds : averageGpu + (milliseconds - averageGpu) * 0.1f;
+    gpuSum += milliseconds;
+    ++gpuFrames;
+}
+
+void QualityManager::endFrame()
+{
+    float frameMs = static_cast<float>(workMs);
+    workMs = 0.0;
+    if (frameMs > 250.0f)
+        return;
+
+    averageCpu = averageCpu == 0.0f ? frameMs : averageCpu + (frameMs - averageCpu) * 0.1f;
+    cpuSum += frameMs;
+    if (++cpuFrames < CONTROL_FRAMES)
+        return;
+    control();
+    resetWindow();
+}
+
+void QualityManager::resetWindow()
+{
+    cpuSum = gpuSum = 0.0f;
+    cpuFrames = gpuFrames = 0;
+}
+
+void QualityManager::control()
+{
+    if (!automatic)
+        return;
+
+    float cpuMean = cpuSum / cpuFrames;
+    float cpu = stepLevel(cpuLevel, cpuMean, budgetMs);
+    float gpu = gpuLevel;
+    // Sem timer query a medida da GPU inclui a CPU do render: com a CPU acima do orçamento
+    // o excesso é dela, e baixar a resolução só borraria a imagem.
+    if (gpuFrames > 0 && (GLExt::hasTimerQuery() || cpuMean <= budgetMs))
+        gpu = stepLevel(gpuLevel, gpuSum / gpuFrames, budgetMs);
+    applyLevels(cpu, gpu);
+}
+
+void QualityManager::setViewer(float x, float z)
+{
+    viewerX = x;
+    viewerZ = z;
+}
+
+bool QualityManager::inDrawDistance(float x, float z, float radius)
+{
+    float dx = x - viewerX, dz = z - viewerZ;
+    float limit = current.drawDistance + radius;
+    return dx * dx + dz * dz <= limit * limit;
+}
+
+bool QualityManager::keepGrass(float x, float z)
+{
+    float dx = x - viewerX, dz = z - viewerZ;
+    if (dx * dx + dz * dz > current.grassDistance * current.grassDistance)
+        return false;
+    if (current.grassDensity >= 1.0f)
+        return true;
+
+    // Hash da posição (as lâminas ficam em uma grade de 0.5): o mesmo subconjunto em todo frame.
+    unsigned int hx = static_cast<unsigned int>(static_cast<int>(std::floor(x * 8.0f)));
+    unsigned int hz = static_cast<unsigned int>(static_cast<int>(std::floor(z * 8.0f)));
+    unsigned int h = hx * 73856093u ^ hz * 19349663u;
+    h ^= h >> 13;
+    h *= 0x5bd1e995u;
+    h ^= h >> 15;
+    return (h & 1023u) < static_cast<unsigned int>(current.grassDensity * 1024.0f);
+}
+
+int QualityManager::detailLevel(float x, float z)
+{
+    float dx = x - viewerX, dz = z - viewerZ;
+    float distSq = dx * dx + dz * dz;
+    float lod = current.lodDistance;
+    if (distSq < lod * lod)
+        return 0;
+    return distSq < 4.0f * lod * lod ? 1 : 2;
+}
+
+void QualityManager::ensureTarget(int width, int height)
+{
+    int needWidth = 64, needHeight = 64;
+    while (needWidth < width)
+        needWidth *= 2;
+    while (needHeight < height)
+        needHeight *= 2;
+    if (sceneTexture && needWidth <= textureWidth && needHeight <= textureHeight)
+        return;
+
+    if (sceneTexture)
+        glDeleteTextures(1, &sceneTexture);
+    if (sceneFramebuffer)
+        GLExt::DeleteFramebuffers(1, &sceneFramebuffer);
+    if (sceneDepth)
+        GLExt::DeleteRenderbuffers(1, &sceneDepth);
+    sceneFramebuffer = sceneDepth = 0;
+
+    textureWidth = needWidth;
+    textureHeight = needHeight;
+    glGenTextures(1, &sceneTexture);
+    GLState::bindTexture(sceneTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, textureWidth, textureHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+
+    useFramebuffer = GLExt::loadFramebuffers();
+    if (!useFramebuffer)
+        return;
+
+    GLExt::GenFramebuffers(1, &sceneFramebuffer);
+    GLExt::BindFramebuffer(GL_FRAMEBUFFER, sceneFramebuffer);
+    GLExt::FramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, sceneTexture, 0);
+    GLExt::GenRenderbuffers(1, &sceneDepth);
+    GLExt::BindRenderbuffer(GL_RENDERBUFFER, sceneDepth);
+    GLExt::RenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, textureWidth, textureHeight);
+    GLExt::FramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, sceneDepth);
+    GLExt::BindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    useFramebuffer = GLExt::CheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    GLExt::BindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (useFramebuffer)
+        return;
+
+    std::cerr << "Qualidade: framebuffer incompleto, usando cópia do back buffer" << std::endl;
+    GLExt::DeleteFramebuffers(1, &sceneFramebuffer);
+    GLExt::DeleteRenderbuffers(1, &sceneDepth);
+    sceneFramebuffer = sceneDepth = 0;
+}
+
+void QualityManager::beginScene(int windowWidth, int windowHeight)
+{
+    targetWidth = windowWidth;
+    targetHeight = windowHeight;
+    sceneActive = current.renderScale < 0.99f && windowWidth > 0 && windowHeight > 0;
+    if (!sceneActive)
+        return;
+
+    sceneWidth = std::max(1, static_cast<int>(windowWidth * current.renderScale));
+    sceneHeight = std::max(1, static_cast<int>(windowHeight * current.renderScale));
+    ensureTarget(sceneWidth, sceneHeight);
+    // Sem FBO a cena vai para o canto do back buffer, que é coberto depois pelo quad ampliado.
+    if (useFramebuffer)
+        GLExt::BindFramebuffer(GL_FRAMEBUFFER, sceneFramebuffer);
+    glViewport(0, 0, sceneWidth, sceneHeight);
+}
+
+void QualityManager::endScene()
+{
+    if (!sceneActive)
+        return;
+    sceneActive = false;
+
+    if (useFramebuffer)
+    {
+        GLExt::BindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+    else
+    {
+        GLState::bindTexture(sceneTexture);
+        glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, sceneWidth, sceneHeight);
+    }
+    glViewport(0, 0, targetWidth, targetHeight);
+
+    GLState::pushAttrib();
+    GLState::disable(GL_LIGHTING);
+    GLState::disable(GL_DEPTH_TEST);
+    GLState::disable(GL_BLEND);
+    GLState::disable(GL_FOG);
+    GLState::enable(GL_TEXTURE_2D);
+    GLState::matrixMode(GL_PROJECTION);
+    GLState::pushMatrix();
+    GLState::loadIdentity();
+    GLState::ortho2D(0.0, 1.0, 0.0, 1.0);
+    GLState::matrixMode(GL_MODELVIEW);
+    GLState::pushMatrix();
+    GLState::loadIdentity();
+
+    float u = sceneWidth / static_cast<float>(textureWidth);
+    float v = sceneHeight / static_cast<float>(textureHeight);
+    GLState::bindTexture(sceneTexture);
+    GLState::texEnvMode(GL_REPLACE);
+    glBegin(GL_QUADS);
+    GLState::texCoord(0.0f, 0.0f);
+    glVertex2f(0.0f, 0.0f);
+    GLState::texCoord(u, 0.0f);
+    glVertex2f(1.0f, 0.0f);
+    GLState::texCoord(u, v);
+    glVertex2f(1.0f, 1.0f);
+    GLState::texCoord(0.0f, v);
+    glVertex2f(0.0f, 1.0f);
+    glEnd();
+
+    GLState::matrixMode(GL_PROJECTION);
+    GLState::popMatrix();
+    GLState::matrixMode(GL_MODELVIEW);
+    GLState::popMatrix();
+    GLState::popAttrib();
+}
+
+void QualityManager::drawOverlay(int windowWidth, int windowHeight)
+{
+    if (!overlayVisible)
+        return;
+
+    char lines[6][96];
+    std::snprintf(lines[0], sizeof(lines[0]), "Qualidade: %s (cpu %.2f, gpu %.2f) %s", tierName(tier()), cpuLevel,
+                  gpuLevel, automatic ? "auto" : "fixo");
+    std::snprintf(lines[1], sizeof(lines[1]), "CPU %.2f ms, GPU %.2f ms%s / %.1f ms", averageCpu, averageGpu,
+                  GLExt::hasTimerQuery() ? "" : " (glFinish)", budgetMs);
+    std::snprintf(lines[2], sizeof(lines[2]), "Escala: %.0f%%", current.renderScale * 100.0f);
+    std::snprintf(lines[3], sizeof(lines[3]), "Distancia: %.0f", current.drawDistance);
+    std::snprintf(lines[4], sizeof(lines[4]), "Grama: %.0f%% ate %.0f", current.grassDensity * 100.0f, current.grassDistance);
+    std::snprintf(lines[5], sizeof(lines[5]), "LOD: %.0f / %.0f", current.lodDistance, current.lodDistance * 2.0f);
+
+    GLState::pushAttrib();
+    GLState::disable(GL_LIGHTING);
+    GLState::disable(GL_DEPTH_TEST);
+    GLState::disable(GL_TEXTURE_2D);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::matrixMode(GL_PROJECTION);
+    GLState::pushMatrix();
+    GLState::loadIdentity();
+    GLState::ortho2D(0, windowWidth, 0, windowHeight);
+    GLState::matrixMode(GL_MODELVIEW);
+    GLState::pushMatrix();
+    GLState::loadIdentity();
+
+    float top = windowHeight - 10.0f;
+    GLState::color(0.0f, 0.0f, 0.0f, 0.55f);
+    glRectf(windowWidth - 330.0f, top - 6 * 16.0f - 8.0f, windowWidth - 10.0f, top);
+    GLState::color(1.0f, 1.0f, 0.6f, 1.0f);
+    for (int i = 0; i < 6; ++i)
+        TextRenderer::print(windowWidth - 322.0f, top - 16.0f * (i + 1), lines[i], 12);
+
+    GLState::matrixMode(GL_PROJECTION);
+    GLState::popMatrix();
+    GLState::matrixMode(GL_MODELVIEW);
+    GLState::popMatrix();
+    GLState::popAttrib();
+}
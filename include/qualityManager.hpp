@@ -0,0 +1,122 @@
+#ifndef QUALITY_MANAGER_HPP
+#define QUALITY_MANAGER_HPP
+
+#include "glState.hpp"
+
+// Qualidade gráfica em níveis nomeados (LOW..ULTRA) e um controle automático que troca
+// qualidade por tempo de frame. O nível é contínuo: entre dois tiers os valores são
+// interpolados, e a cada meio segundo o controle compara as médias recentes com o orçamento
+// e desce rápido / sobe devagar. São dois níveis: o tempo de CPU (update + render) move
+// distância, grama e LOD; o tempo de GPU do render move só a escala de resolução, que é o
+// único custo que ela reduz.
+//
+// Com renderScale < 1 a cena 3D é desenhada em um alvo menor e ampliada para a janela;
+// o HUD continua na resolução cheia.
+class QualityManager
+{
+public:
+    enum Tier
+    {
+        LOW,
+        MEDIUM,
+        HIGH,
+        ULTRA,
+        TIER_COUNT
+    };
+
+    struct Settings
+    {
+        float renderScale;   // fração da resolução da janela usada pela cena 3D
+        float drawDistance;  // objetos mais longe do jogador não são desenhados; define o far plane
+        float grassDensity;  // fração das lâminas de grama desenhadas
+        float grassDistance; // grama some depois dessa distância
+        float lodDistance;   // árvores e pedras perdem segmentos a partir daqui (e de novo no dobro)
+    };
+
+    static const float DEFAULT_BUDGET_MS;
+
+    // Orçamento do tempo de trabalho por frame, em milissegundos.
+    static void setBudget(float milliseconds);
+    static float budget() { return budgetMs; }
+    // Trava em um tier (desliga o controle) ou volta para o automático.
+    static void setTier(Tier tier);
+    static void setAutomatic(bool enabled);
+    static bool isAutomatic() { return automatic; }
+    // Tier mais próximo do menor dos dois níveis.
+    static Tier tier();
+    static float level();
+    static const Settings &settings() { return current; }
+    static const char *tierName(Tier tier);
+
+    // Tempo de CPU: beginWork/endWork em volta do update e do render.
+    static void beginWork();
+    static void endWork();
+    // Tempo de GPU: beginGpu/endGpu em volta do render, antes do swap. Com timer query o
+    // resultado é lido alguns frames depois, sem esperar a GPU; sem ela endGpu faz glFinish
+    // e mede o tempo de parede do render até a GPU terminar.
+    static void beginGpu();
+    static void endGpu();
+    // Fecha a amostra do frame.
+    static void endFrame();
+    static float averageCpuMs() { return averageCpu; }
+    static float averageGpuMs() { return averageGpu; }
+
+    // Posição usada pelas distâncias (o jogador).
+    static void setViewer(float x, float z);
+    static bool inDrawDistance(float x, float z, float radius);
+    // Decide por posição (não muda de um frame para o outro) se a lâmina entra na densidade atual.
+    static bool keepGrass(float x, float z);
+    // 0 = detalhe cheio, 1 = médio, 2 = baixo.
+    static int detailLevel(float x, float z);
+
+    // Entre os dois o chamador desenha a cena 3D; fora da escala 1 ela vai para o alvo reduzido.
+    static void beginScene(int windowWidth, int windowHeight);
+    static void endScene();
+
+    static bool isOverlayVisible() { return overlayVisible; }
+    static void toggleOverlay() { overlayVisible = !overlayVisible; }
+    // Tier, nível, tempos e valores escolhidos no canto da tela.
+    static void drawOverlay(int windowWidth, int windowHeight);
+
+private:
+    static const Settings TIERS[TIER_COUNT];
+    static const int CONTROL_FRAMES = 30;
+    static const int GPU_QUERIES = 4;
+
+    static Settings current;
+    static float cpuLevel; // distância, grama e LOD
+    static float gpuLevel; // escala de resolução
+    static bool automatic;
+    static float budgetMs;
+    static float averageCpu, averageGpu;
+    static double workMs;
+    static double workStart;
+    static double gpuStart;
+    static float cpuSum, gpuSum;
+    static int cpuFrames, gpuFrames;
+    // Anel de queries GL_TIME_ELAPSED; pending = ainda sem resultado lido.
+    static GLuint gpuQueries[GPU_QUERIES];
+    static bool gpuPending[GPU_QUERIES];
+    static int gpuNext;
+    static bool gpuActive;
+    static bool overlayVisible;
+    static float viewerX, viewerZ;
+
+    // Alvo reduzido: textura potência de dois (com FBO quando existe, senão cópia do back buffer).
+    static GLuint sceneTexture;
+    static GLuint sceneFramebuffer;
+    static GLuint sceneDepth;
+    static int textureWidth, textureHeight;
+    static int sceneWidth, sceneHeight;
+    static int targetWidth, targetHeight;
+    static bool useFramebuffer;
+    static bool sceneActive;
+
+    static void applyLevels(float cpu, float gpu);
+    static void addGpuSample(float milliseconds);
+    static void resetWindow();
+    static void control();
+    static void ensureTarget(int width, int height);
+};
+
+#endif
@@ -0,0 +1,566 @@
+#include "renderer.hpp"
+#include "light.hpp"
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+ShaderProgram Renderer::program;
+ShaderProgram Renderer::instancedProgram;
+bool Renderer::instancing = false;
+GLuint Renderer::instanceBuffer = 0;
+bool Renderer::available = false;
+bool Renderer::enabled = false;
+bool Renderer::useBlocks = false;
+bool Renderer::bound = false;
+GLuint Renderer::cameraBuffer = 0;
+GLuint Renderer::lightBuffer = 0;
+GLuint Renderer::materialBuffer = 0;
+Renderer::CameraBlock Renderer::camera;
+Renderer::LightBlock Renderer::lights;
+Renderer::MaterialBlock Renderer::material;
+bool Renderer::materialDirty = true;
+unsigned int Renderer::pointLightsVersion = 0;
+GpuMesh Renderer::cube;
+GpuMesh Renderer::sphere;
+
+// Cabeçalhos por versão: o corpo dos shaders é o mesmo para 3.30 e 1.20.
+static const char *headerModernVS =
+    "#version 330\n"
+    "#define IN in\n"
+    "#define OUT out\n"
+    "#define BLOCK(name) layout(std140) uniform name {\n"
+    "#define END_BLOCK };\n"
+    "#define MEMBER\n";
+
+static const char *headerModernFS =
+    "#version 330\n"
+    "#define IN in\n"
+    "#define BLOCK(name) layout(std140) uniform name {\n"
+    "#define END_BLOCK };\n"
+    "#define MEMBER\n"
+    "#define TEXTURE2D texture\n"
+    "out vec4 fragColor;\n"
+    "#define FRAG_COLOR fragColor\n";
+
+static const char *headerLegacyVS =
+    "#version 120\n"
+    "#define IN attribute\n"
+    "#define OUT varying\n"
+    "#define BLOCK(name)\n"
+    "#define END_BLOCK\n"
+    "#define MEMBER uniform\n";
+
+static const char *headerLegacyFS =
+    "#version 120\n"
+    "#define IN varying\n"
+    "#define BLOCK(name)\n"
+    "#define END_BLOCK\n"
+    "#define MEMBER uniform\n"
+    "#define TEXTURE2D texture2D\n"
+    "#define FRAG_COLOR gl_FragColor\n";
+
+static const char *vertexBody = R"(
+BLOCK(Camera)
+    MEMBER mat4 uView;
+    MEMBER mat4 uProjection;
+END_BLOCK
+
+IN vec3 aPosition;
+IN vec3 aNormal;
+IN vec2 aTexCoord;
+
+#ifdef INSTANCED
+IN vec4 aInstanceModel0;
+IN vec4 aInstanceModel1;
+IN vec4 aInstanceModel2;
+IN vec4 aInstanceModel3;
+IN vec4 aInstanceColor;
+#else
+uniform mat4 uModelView;
+uniform mat3 uNormalMatrix;
+uniform vec4 uTint;
+#endif
+
+OUT vec3 vEyePosition;
+OUT vec3 vNormal;
+OUT vec2 vTexCoord;
+OUT vec4 vTint;
+
+void main()
+{
+#ifdef INSTANCED
+    mat4 modelView = uView * mat4(aInstanceModel0, aInstanceModel1, aInstanceModel2, aInstanceModel3);
+    vec4 eye = modelView * vec4(aPosition, 1.0);
+    vNormal = mat3(modelView[0].xyz, modelView[1].xyz, modelView[2].xyz) * aNormal;
+    vTint = aInstanceColor;
+#else
+    vec4 eye = uModelView * vec4(aPosition, 1.0);
+    vNormal = uNormalMatrix * aNormal;
+    vTint = uTint;
+#endif
+    vEyePosition = eye.xyz;
+    vTexCoord = aTexCoord;
+    gl_Position = uProjection * eye;
+}
+)";
+
+// Mesmo modelo do pipeline fixo: ambiente global + uma luz pontual,
+// Blinn-Phong sem local viewer e textura em GL_MODULATE.
+static const char *fragmentBody = R"(
+BLOCK(Lights)
+    MEMBER vec4 uLightPosition;
+    MEMBER vec4 uLightAmbient;
+    MEMBER vec4 uLightDiffuse;
+    MEMBER vec4 uLightSpecular;
+    MEMBER vec4 uSceneAmbient;
+    MEMBER vec4 uPointPosition[MAX_POINT_LIGHTS];
+    MEMBER vec4 uPointColor[MAX_POINT_LIGHTS];
+    MEMBER vec4 uPointCount;
+END_BLOCK
+
+BLOCK(Material)
+    MEMBER vec4 uMatAmbient;
+    MEMBER vec4 uMatDiffuse;
+    MEMBER vec4 uMatSpecular;
+    MEMBER vec4 uMatEmission;
+    MEMBER vec4 uMatParams;
+END_BLOCK
+
+uniform sampler2D uTexture;
+
+IN vec3 vEyePosition;
+IN vec3 vNormal;
+IN vec2 vTexCoord;
+IN vec4 vTint;
+
+void main()
+{
+    vec3 ambient = uMatAmbient.rgb * vTint.rgb;
+    vec3 albedo = uMatDiffuse.rgb * vTint.rgb;
+    vec3 color = albedo;
+    if (uMatParams.z > 0.5)
+    {
+        vec3 n = normalize(vNormal);
+        vec3 l = uLightPosition.w == 0.0 ? normalize(uLightPosition.xyz)
+                                         : normalize(uLightPosition.xyz - vEyePosition);
+        float diffuse = max(dot(n, l), 0.0);
+        float specular = 0.0;
+        if (diffuse > 0.0)
+            specular = pow(max(dot(n, normalize(l + vec3(0.0, 0.0, 1.0))), 0.0001), uMatParams.x);
+
+        color = uMatEmission.rgb + (uSceneAmbient.rgb + uLightAmbient.rgb) * ambient +
+                diffuse * uLightDiffuse.rgb * albedo +
+                specular * uLightSpecular.rgb * uMatSpecular.rgb;
+
+        // Luzes pontuais: mesma conta da GL_LIGHT1..7 (sem ambiente, atenuação 1 + q*d²).
+        for (int i = 0; i < MAX_POINT_LIGHTS; ++i)
+        {
+            if (float(i) < uPointCount.x)
+            {
+                vec3 toLight = uPointPosition[i].xyz - vEyePosition;
+                float distanceSq = dot(toLight, toLight);
+                vec3 pl = toLight * inversesqrt(distanceSq);
+                float attenuation = 1.0 / (1.0 + uPointPosition[i].w * distanceSq);
+                float pointDiffuse = max(dot(n, pl), 0.0);
+                float pointSpecular = 0.0;
+                if (pointDiffuse > 0.0)
+                    pointSpecular = pow(max(dot(n, normalize(pl + vec3(0.0, 0.0, 1.0))), 0.0001), uMatParams.x);
+                color += attenuation * uPointColor[i].rgb * (pointDiffuse * albedo + pointSpecular * uMatSpecular.rgb);
+            }
+        }
+    }
+
+    vec4 result = vec4(min(color, vec3(1.0)), uMatDiffuse.a * vTint.a);
+    if (uMatParams.y > 0.5)
+        result *= TEXTURE2D(uTexture, vTexCoord);
+    FRAG_COLOR = result;
+}
+)";
+
+bool Renderer::buildProgram(ShaderProgram &target, bool modern, bool instanced)
+{
+    std::string defines = instanced ? "#define INSTANCED\n" : "";
+    std::string vs = std::string(modern ? headerModernVS : headerLegacyVS) + defines + vertexBody;
+    std::string fs = std::string(modern ? headerModernFS : headerLegacyFS) +
+                     "#define MAX_POINT_LIGHTS " + std::to_string(LightManager::MAX_ACTIVE) + "\n" + fragmentBody;
+    return target.build(vs, fs, {{"aPosition", ATTRIB_POSITION},
+                                 {"aNormal", ATTRIB_NORMAL},
+                                 {"aTexCoord", ATTRIB_TEXCOORD},
+                                 {"aInstanceModel0", ATTRIB_INSTANCE_MODEL},
+                                 {"aInstanceModel1", ATTRIB_INSTANCE_MODEL + 1},
+                                 {"aInstanceModel2", ATTRIB_INSTANCE_MODEL + 2},
+                                 {"aInstanceModel3", ATTRIB_INSTANCE_MODEL + 3},
+                                 {"aInstanceColor", ATTRIB_INSTANCE_COLOR}});
+}
+
+void Renderer::bindBlocks(ShaderProgram &target)
+{
+    GLExt::UniformBlockBinding(target.getId(), target.uniformBlock("Camera"), CAMERA_BINDING);
+    GLExt::UniformBlockBinding(target.getId(), target.uniformBlock("Lights"), LIGHT_BINDING);
+    GLExt::UniformBlockBinding(target.getId(), target.uniformBlock("Material"), MATERIAL_BINDING);
+}
+
+bool Renderer::init()
+{
+    available = false;
+    if (!GLExt::load())
+    {
+        std::cerr << "Shaders indisponíveis, usando o pipeline fixo." << std::endl;
+        return false;
+    }
+
+    useBlocks = GLExt::version() >= 33 && GLExt::hasUniformBuffers() && buildProgram(program, true, false);
+    if (!useBlocks && !buildProgram(program, false, false))
+    {
+        std::cerr << "Falha ao criar os shaders, usando o pipeline fixo." << std::endl;
+        return false;
+    }
+
+    // Instancing só com 3.3 (divisor de atributo); sem ele o desenho é feito instância a instância.
+    instancing = useBlocks && GLExt::hasInstancing() && buildProgram(instancedProgram, true, true);
+
+    program.use();
+    GLExt::Uniform1i(program.uniform("uTexture"), 0);
+    GLExt::Uniform4f(program.uniform("uTint"), 1.0f, 1.0f, 1.0f, 1.0f);
+    if (instancing)
+    {
+        instancedProgram.use();
+        GLExt::Uniform1i(instancedProgram.uniform("uTexture"), 0);
+        GLExt::GenBuffers(1, &instanceBuffer);
+    }
+
+    if (useBlocks)
+    {
+        GLuint buffers[3];
+        GLExt::GenBuffers(3, buffers);
+        cameraBuffer = buffers[0];
+        lightBuffer = buffers[1];
+        materialBuffer = buffers[2];
+
+        const GLuint sizes[3] = {sizeof(CameraBlock), sizeof(LightBlock), sizeof(MaterialBlock)};
+        for (int i = 0; i < 3; ++i)
+        {
+            GLExt::BindBuffer(GL_UNIFORM_BUFFER, buffers[i]);
+            GLExt::BufferData(GL_UNIFORM_BUFFER, sizes[i], nullptr, GL_DYNAMIC_DRAW);
+            GLExt::BindBufferBase(GL_UNIFORM_BUFFER, i, buffers[i]);
+        }
+        GLExt::BindBuffer(GL_UNIFORM_BUFFER, 0);
+
+        bindBlocks(program);
+        if (instancing)
+            bindBlocks(instancedProgram);
+    }
+    ShaderProgram::useNone();
+
+    std::vector<GpuVertex> vertices;
+    std::vector<unsigned int> indices;
+    GpuMesh::buildCube(1.0f, vertices, indices);
+    cube.upload(vertices, indices);
+    GpuMesh::buildSphere(1.0f, 16, 16, vertices, indices);
+    sphere.upload(vertices, indices);
+
+    GLfloat white[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    setColor(white[0], white[1], white[2]);
+    setLighting(true);
+
+    std::cout << "Renderizador com shaders ativo (GLSL " << (useBlocks ? "3.30" : "1.20")
+              << (instancing ? ", instancing" : "") << ")" << std::endl;
+    available = true;
+    return true;
+}
+
+void Renderer::shutdown()
+{
+    cube.release();
+    sphere.release();
+    program.release();
+    instancedProgram.release();
+    if (instanceBuffer)
+        GLExt::DeleteBuffers(1, &instanceBuffer);
+    instanceBuffer = 0;
+    instancing = false;
+    if (cameraBuffer)
+    {
+        GLuint buffers[3] = {cameraBuffer, lightBuffer, materialBuffer};
+        GLExt::DeleteBuffers(3, buffers);
+    }
+    cameraBuffer = lightBuffer = materialBuffer = 0;
+    available = false;
+}
+
+void Renderer::setEnabled(bool on) { enabled = on; }
+
+bool Renderer::isActive() { return available && enabled; }
+
+void Renderer::beginFrame()
+{
+    if (!isActive())
+        return;
+
+    std::memcpy(camera.view, GLState::modelview().m, sizeof(camera.view));
+    std::memcpy(camera.projection, GLState::projection().m, sizeof(camera.projection));
+
+    std::memcpy(lights.position, Light::position, sizeof(lights.position));
+    std::memcpy(lights.ambient, Light::ambient, sizeof(lights.ambient));
+    std::memcpy(lights.diffuse, Light::diffuse, sizeof(lights.diffuse));
+    std::memcpy(lights.specular, Light::specular, sizeof(lights.specular));
+    const GLfloat sceneAmbient[4] = {0.2f, 0.2f, 0.2f, 1.0f};
+    std::memcpy(lights.sceneAmbient, sceneAmbient, sizeof(lights.sceneAmbient));
+    lights.pointCount[0] = 0.0f;
+    pointLightsVersion = LightManager::activeVersion() - 1;
+
+    if (useBlocks)
+    {
+        GLExt::BindBuffer(GL_UNIFORM_BUFFER, cameraBuffer);
+        GLExt::BufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CameraBlock), &camera);
+        GLExt::BindBuffer(GL_UNIFORM_BUFFER, lightBuffer);
+        GLExt::BufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(LightBlock), &lights);
+        GLExt::BindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+    else
+    {
+        program.use();
+        GLExt::UniformMatrix4fv(program.uniform("uView"), 1, GL_FALSE, camera.view);
+        GLExt::UniformMatrix4fv(program.uniform("uProjection"), 1, GL_FALSE, camera.projection);
+        GLExt::Uniform4fv(program.uniform("uLightPosition"), 1, lights.position);
+        GLExt::Uniform4fv(program.uniform("uLightAmbient"), 1, lights.ambient);
+        GLExt::Uniform4fv(program.uniform("uLightDiffuse"), 1, lights.diffuse);
+        GLExt::Uniform4fv(program.uniform("uLightSpecular"), 1, lights.specular);
+        GLExt::Uniform4fv(program.uniform("uSceneAmbient"), 1, lights.sceneAmbient);
+        GLExt::Uniform4fv(program.uniform("uPointCount"), 1, lights.pointCount);
+        if (!bound)
+            ShaderProgram::useNone();
+    }
+    materialDirty = true;
+}
+
+void Renderer::begin()
+{
+    if (!isActive() || bound)
+        return;
+    program.use();
+    bound = true;
+}
+
+void Renderer::end()
+{
+    if (!bound)
+        return;
+    ShaderProgram::useNone();
+    bound = false;
+}
+
+void Renderer::setMaterial(const GLfloat ambient[4], const GLfloat diffuse[4],
+                           const GLfloat specular[4], GLfloat shininess)
+{
+    std::memcpy(material.ambient, ambient, sizeof(material.ambient));
+    std::memcpy(material.diffuse, diffuse, sizeof(material.diffuse));
+    std::memcpy(material.specular, specular, sizeof(material.specular));
+    material.params[0] = shininess;
+    materialDirty = true;
+}
+
+void Renderer::setEmission(const GLfloat emission[4])
+{
+    if (std::memcmp(material.emission, emission, sizeof(material.emission)) != 0)
+    {
+        std::memcpy(material.emission, emission, sizeof(material.emission));
+        materialDirty = true;
+    }
+}
+
+void Renderer::setColor(float r, float g, float b, float a)
+{
+    const GLfloat color[4] = {r, g, b, a};
+    std::memcpy(material.ambient, color, sizeof(material.ambient));
+    std::memcpy(material.diffuse, color, sizeof(material.diffuse));
+    materialDirty = true;
+}
+
+void Renderer::setTexture(GLuint texture)
+{
+    if (texture)
+        GLState::bindTexture(texture);
+    float use = texture ? 1.0f : 0.0f;
+    if (material.params[1] != use)
+    {
+        material.params[1] = use;
+        materialDirty = true;
+    }
+}
+
+void Renderer::setLighting(bool on)
+{
+    float use = on ? 1.0f : 0.0f;
+    if (material.params[2] != use)
+    {
+        material.params[2] = use;
+        materialDirty = true;
+    }
+}
+
+void Renderer::matchFixedFunction(float r, float g, float b, float a)
+{
+    GLfloat ambient[4], diffuse[4], specular[4], emission[4], shininess;
+    GLState::getMaterial(GL_AMBIENT, ambient);
+    GLState::getMaterial(GL_DIFFUSE, diffuse);
+    GLState::getMaterial(GL_SPECULAR, specular);
+    GLState::getMaterial(GL_SHININESS, &shininess);
+    GLState::getMaterial(GL_EMISSION, emission);
+    setMaterial(ambient, diffuse, specular, shininess);
+    setEmission(emission);
+
+    bool lighting = GLState::isEnabled(GL_LIGHTING);
+    if (!lighting || GLState::isEnabled(GL_COLOR_MATERIAL))
+        setColor(r, g, b, a);
+    setLighting(lighting);
+    setTexture(GLState::isEnabled(GL_TEXTURE_2D) ? GLState::boundTexture() : 0);
+}
+
+void Renderer::uploadMaterial()
+{
+    if (!materialDirty)
+        return;
+
+    if (useBlocks)
+    {
+        GLExt::BindBuffer(GL_UNIFORM_BUFFER, materialBuffer);
+        GLExt::BufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(MaterialBlock), &material);
+        GLExt::BindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+    else
+    {
+        GLExt::Uniform4fv(program.uniform("uMatAmbient"), 1, material.ambient);
+        GLExt::Uniform4fv(program.uniform("uMatDiffuse"), 1, material.diffuse);
+        GLExt::Uniform4fv(program.uniform("uMatSpecular"), 1, material.specular);
+        GLExt::Uniform4fv(program.uniform("uMatEmission"), 1, material.emission);
+        GLExt::Uniform4fv(program.uniform("uMatParams"), 1, material.params);
+    }
+    materialDirty = false;
+}
+
+void Renderer::uploadPointLights()
+{
+    // Só reenvia quando o LightManager ligou outro conjunto (ou é outro frame).
+    if (pointLightsVersion == LightManager::activeVersion())
+        return;
+    pointLightsVersion = LightManager::activeVersion();
+
+    int count = LightManager::activeCount();
+    for (int i = 0; i < count; ++i)
+    {
+        std::memcpy(lights.pointPosition[i], LightManager::activePosition(i), sizeof(lights.pointPosition[i]));
+        std::memcpy(lights.pointColor[i], LightManager::activeColor(i), sizeof(lights.pointColor[i]));
+    }
+    lights.pointCount[0] = static_cast<GLfloat>(count);
+
+    if (useBlocks)
+    {
+        GLExt::BindBuffer(GL_UNIFORM_BUFFER, lightBuffer);
+        GLExt::BufferSubData(GL_UNIFORM_BUFFER, offsetof(LightBlock, pointPosition),
+                             sizeof(LightBlock) - offsetof(LightBlock, pointPosition), lights.pointPosition);
+        GLExt::BindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+    else
+    {
+        GLExt::Uniform4fv(program.uniform("uPointPosition"), LightManager::MAX_ACTIVE, lights.pointPosition[0]);
+        GLExt::Uniform4fv(program.uniform("uPointColor"), LightManager::MAX_ACTIVE, lights.pointColor[0]);
+        GLExt::Uniform4fv(program.uniform("uPointCount"), 1, lights.pointCount);
+    }
+}
+
+void Renderer::draw(const GpuMesh &mesh)
+{
+    if (!isActive())
+        return;
+
+    bool wasBound = bound;
+    begin();
+    uploadMaterial();
+    uploadPointLights();
+
+    // Malha compacta: a decodificação da posição entra só na modelview. A escala dela é
+    // uniforme, então a matriz das normais continua a do objeto (e não perde precisão no det).
+    Mat4 modelView = mesh.isPacked() ? GLState::modelview() * mesh.decodeMatrix() : GLState::modelview();
+    GLfloat normal[9];
+    GLState::modelview().normalMatrix(normal);
+    GLExt::UniformMatrix4fv(program.uniform("uModelView"), 1, GL_FALSE, modelView.m);
+    GLExt::UniformMatrix3fv(program.uniform("uNormalMatrix"), 1, GL_FALSE, normal);
+
+    mesh.draw();
+
+    if (!wasBound)
+        end();
+}
+
+const GpuMesh &Renderer::unitCube() { return cube; }
+
+const GpuMesh &Renderer::unitSphere() { return sphere; }
+
+bool Renderer::hasInstancing() { return isActive() && instancing; }
+
+void Renderer::drawInstanced(const GpuMesh &mesh, const std::vector<InstanceData> &instances)
+{
+    if (!isActive() || instances.empty())
+        return;
+
+    if (!instancing)
+    {
+        // Sem divisor de atributo: mesmo resultado, uma chamada por instância.
+        bool wasBound = bound;
+        begin();
+        for (const auto &instance : instances)
+        {
+            GLState::pushMatrix();
+            GLState::multMatrix(instance.model);
+            GLExt::Uniform4fv(program.uniform("uTint"), 1, instance.color);
+            draw(mesh);
+            GLState::popMatrix();
+        }
+        GLExt::Uniform4f(program.uniform("uTint"), 1.0f, 1.0f, 1.0f, 1.0f);
+        if (!wasBound)
+            end();
+        return;
+    }
+
+    instancedProgram.use();
+    uploadMaterial();
+    uploadPointLights();
+
+    // Buffer de streaming: descarta o conteúdo anterior antes de reescrever.
+    GLsizeiptr bytes = instances.size() * sizeof(InstanceData);
+    GLExt::BindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    GLExt::BufferData(GL_ARRAY_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+    GLExt::BufferSubData(GL_ARRAY_BUFFER, 0, bytes, instances.data());
+
+    mesh.bind();
+    GLExt::BindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    for (GLuint column = 0; column < 4; ++column)
+    {
+        GLuint location = ATTRIB_INSTANCE_MODEL + column;
+        GLExt::EnableVertexAttribArray(location);
+        GLExt::VertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                                   reinterpret_cast<const void *>(offsetof(InstanceData, model) + column * 4 * sizeof(GLfloat)));
+        GLExt::VertexAttribDivisor(location, 1);
+    }
+    GLExt::EnableVertexAttribArray(ATTRIB_INSTANCE_COLOR);
+    GLExt::VertexAttribPointer(ATTRIB_INSTANCE_COLOR, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                               reinterpret_cast<const void *>(offsetof(InstanceData, color)));
+    GLExt::VertexAttribDivisor(ATTRIB_INSTANCE_COLOR, 1);
+
+    mesh.drawElements(static_cast<GLsizei>(instances.size()));
+
+    // Deixa o VAO da malha como estava para os desenhos sem instância.
+    for (GLuint location = ATTRIB_INSTANCE_MODEL; location <= ATTRIB_INSTANCE_COLOR; ++location)
+    {
+        GLExt::VertexAttribDivisor(location, 0);
+        GLExt::DisableVertexAttribArray(location);
+    }
+    GLExt::BindBuffer(GL_ARRAY_BUFFER, 0);
+    mesh.unbind();
+
+    if (bound)
+        program.use();
+    else
+        ShaderProgram::useNone();
+}
@@ -0,0 +1,116 @@
+#ifndef RENDERER_HPP
+#define RENDERER_HPP
+
+#include "glExt.hpp"
+#include "glState.hpp"
+#include "gpuMesh.hpp"
+#include "shaderProgram.hpp"
+#include "lightManager.hpp"
+
+// Dados por instância lidos pelo shader instanciado (divisor 1).
+struct InstanceData
+{
+    GLfloat model[16];
+    GLfloat color[4];
+};
+
+// Caminho de renderização com GLSL, opcional e paralelo ao pipeline fixo.
+// Usa GLSL 3.30 com uniform blocks quando o contexto permite e cai para
+// GLSL 1.20 com uniforms soltos nos demais casos (mesmos nomes nos dois).
+// Matrizes vêm do GLState, então quem desenha continua usando push/translate.
+class Renderer
+{
+public:
+    static bool init();
+    static void shutdown();
+
+    static void setEnabled(bool on);
+    static bool isActive();
+
+    // Chamar depois de aplicar a câmera: envia view, projeção e luzes.
+    static void beginFrame();
+
+    static void begin();
+    static void end();
+
+    static void setMaterial(const GLfloat ambient[4], const GLfloat diffuse[4],
+                            const GLfloat specular[4], GLfloat shininess);
+    // Equivalente ao GL_COLOR_MATERIAL: ambiente e difusa seguem a cor.
+    static void setColor(float r, float g, float b, float a = 1.0f);
+    static void setEmission(const GLfloat emission[4]);
+    static void setTexture(GLuint texture);
+    static void setLighting(bool on);
+    // Copia o estado do pipeline fixo guardado no GLState (material, GL_COLOR_MATERIAL,
+    // GL_LIGHTING e textura ligada), assim o código de desenho existente não muda.
+    static void matchFixedFunction(float r, float g, float b, float a = 1.0f);
+
+    // Desenha com a modelview atual do GLState como transformação do objeto.
+    static void draw(const GpuMesh &mesh);
+
+    // Uma chamada para todas as instâncias (matriz de modelo + cor em um buffer por frame).
+    // O material atual vale para todas; a cor de cada instância multiplica ambiente e difusa.
+    static void drawInstanced(const GpuMesh &mesh, const std::vector<InstanceData> &instances);
+    static bool hasInstancing();
+
+    static const GpuMesh &unitCube();
+    static const GpuMesh &unitSphere();
+
+private:
+    struct CameraBlock
+    {
+        GLfloat view[16];
+        GLfloat projection[16];
+    };
+
+    struct LightBlock
+    {
+        GLfloat position[4];
+        GLfloat ambient[4];
+        GLfloat diffuse[4];
+        GLfloat specular[4];
+        GLfloat sceneAmbient[4];
+        // Luzes pontuais do LightManager (espaço de câmera, w = atenuação quadrática).
+        GLfloat pointPosition[LightManager::MAX_ACTIVE][4];
+        GLfloat pointColor[LightManager::MAX_ACTIVE][4];
+        GLfloat pointCount[4];
+    };
+
+    struct MaterialBlock
+    {
+        GLfloat ambient[4];
+        GLfloat diffuse[4];
+        GLfloat specular[4];
+        GLfloat emission[4];
+        GLfloat params[4]; // x = brilho, y = usa textura, z = usa iluminação
+    };
+
+    enum BlockBinding : GLuint
+    {
+        CAMERA_BINDING = 0,
+        LIGHT_BINDING = 1,
+        MATERIAL_BINDING = 2
+    };
+
+    static ShaderProgram program;
+    static ShaderProgram instancedProgram;
+    static bool instancing;
+    static GLuint instanceBuffer;
+    static bool available;
+    static bool enabled;
+    static bool useBlocks;
+    static bool bound;
+    static GLuint cameraBuffer, lightBuffer, materialBuffer;
+    static CameraBlock camera;
+    static LightBlock lights;
+    static MaterialBlock material;
+    static bool materialDirty;
+    static unsigned int pointLightsVersion;
+    static GpuMesh cube, sphere;
+
+    static bool buildProgram(ShaderProgram &target, bool modern, bool instanced);
+    static void bindBlocks(ShaderProgram &target);
+    static void uploadMaterial();
+    static void uploadPointLights();
+};
+
+#endif
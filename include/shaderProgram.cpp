@@ -0,0 +1,94 @@
+#include "shaderProgram.hpp"
+#include <iostream>
+
+ShaderProgram::ShaderProgram() : id(0) {}
+
+ShaderProgram::~ShaderProgram() { release(); }
+
+GLuint ShaderProgram::compile(GLenum type, const std::string &source)
+{
+    GLuint shader = GLExt::CreateShader(type);
+    const char *src = source.c_str();
+    GLExt::ShaderSource(shader, 1, &src, nullptr);
+    GLExt::CompileShader(shader);
+
+    GLint status = GL_FALSE;
+    GLExt::GetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE)
+    {
+        char log[1024];
+        GLExt::GetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        std::cerr << "Erro ao compilar shader: " << log << std::endl;
+        GLExt::DeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+bool ShaderProgram::build(const std::string &vertexSource, const std::string &fragmentSource,
+                          const std::vector<std::pair<const char *, GLuint>> &attributes)
+{
+    release();
+
+    GLuint vs = compile(GL_VERTEX_SHADER, vertexSource);
+    if (!vs)
+        return false;
+    GLuint fs = compile(GL_FRAGMENT_SHADER, fragmentSource);
+    if (!fs)
+    {
+        GLExt::DeleteShader(vs);
+        return false;
+    }
+
+    id = GLExt::CreateProgram();
+    GLExt::AttachShader(id, vs);
+    GLExt::AttachShader(id, fs);
+    for (const auto &attribute : attributes)
+        GLExt::BindAttribLocation(id, attribute.second, attribute.first);
+    GLExt::LinkProgram(id);
+
+    GLExt::DeleteShader(vs);
+    GLExt::DeleteShader(fs);
+
+    GLint status = GL_FALSE;
+    GLExt::GetProgramiv(id, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE)
+    {
+        char log[1024];
+        GLExt::GetProgramInfoLog(id, sizeof(log), nullptr, log);
+        std::cerr << "Erro ao linkar shader: " << log << std::endl;
+        release();
+        return false;
+    }
+    return true;
+}
+
+void ShaderProgram::release()
+{
+    if (id)
+        GLExt::DeleteProgram(id);
+    id = 0;
+    uniformCache.clear();
+}
+
+void ShaderProgram::use() const { GLExt::UseProgram(id); }
+
+void ShaderProgram::useNone() { GLExt::UseProgram(0); }
+
+GLint ShaderProgram::uniform(const char *name)
+{
+    auto it = uniformCache.find(name);
+    if (it != uniformCache.end())
+        return it->second;
+
+    GLint location = GLExt::GetUniformLocation(id, name);
+    uniformCache[name] = location;
+    return location;
+}
+
+GLuint ShaderProgram::uniformBlock(const char *name) const
+{
+    if (!GLExt::hasUniformBuffers())
+        return GL_INVALID_INDEX;
+    return GLExt::GetUniformBlockIndex(id, name);
+}
@@ -0,0 +1,36 @@
+#ifndef SHADER_PROGRAM_HPP
+#define SHADER_PROGRAM_HPP
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "glExt.hpp"
+
+class ShaderProgram
+{
+public:
+    ShaderProgram();
+    ~ShaderProgram();
+
+    // attributes: nome -> location, fixados antes do link para não depender do driver.
+    bool build(const std::string &vertexSource, const std::string &fragmentSource,
+               const std::vector<std::pair<const char *, GLuint>> &attributes);
+    void release();
+
+    void use() const;
+    static void useNone();
+
+    GLint uniform(const char *name);
+    GLuint uniformBlock(const char *name) const;
+    GLuint getId() const { return id; }
+    bool isValid() const { return id != 0; }
+
+private:
+    GLuint id;
+    std::unordered_map<std::string, GLint> uniformCache;
+
+    static GLuint compile(GLenum type, const std::string &source);
+};
+
+#endif
@@ -1,16 +1,38 @@
 #include "staticObject.hpp"
 
-extern unsigned int textureWood;
-extern unsigned int textureTrunk;
-extern unsigned int textureRock;
-extern unsigned int textureItem;
-extern unsigned int textureWall;
-extern unsigned int textureLeaves;
-extern unsigned int textureHouseWall;
-extern unsigned int textureRoof;
-extern unsigned int textureDoor;
-extern unsigned int textureBrick;
-extern unsigned int textureFloor;
+TextureAtlas StaticObject::atlas;
+int StaticObject::parts[StaticObject::PART_COUNT];
+GLuint StaticObject::goldTexture = 0;
+
+void StaticObject::loadTextures(bool compress)
+{
+    parts[TRUNK] = atlas.add("src/textures/wood.png");
+    parts[LEAVES] = atlas.add("src/textures/wall.png");
+    parts[ROCK_SURFACE] = atlas.add("src/textures/rock.png");
+    parts[HOUSE_WALL] = atlas.add("src/textures/house_wall.png");
+    // O piso da casa nunca teve imagem (textureFloor ficava 0): branco, só o material.
+    parts[FLOOR] = atlas.addSolid(255, 255, 255);
+    parts[ROOF] = atlas.add("src/textures/roof.png");
+    parts[DOOR] = atlas.add("src/textures/door.png");
+    parts[BRICK] = atlas.add("src/textures/wall.png");
+    parts[WALL_SURFACE] = atlas.add("src/textures/wall.png");
+    parts[WOOD] = atlas.add("src/textures/wood.png");
+    // Adereços pequenos na tela: 256 texels por imagem bastam e o atlas fica em 1024x1024.
+    atlas.build("src/textures/props.atlas", 256, compress);
+    goldTexture = TextureManager::acquire("src/textures/gold.png");
+}
+
+void StaticObject::usePart(Part part)
+{
+    const TextureAtlas::Region &region = atlas.region(parts[part]);
+    const GLfloat matrix[16] = {region.u1 - region.u0, 0.0f, 0.0f, 0.0f,
+                                0.0f, region.v1 - region.v0, 0.0f, 0.0f,
+                                0.0f, 0.0f, 1.0f, 0.0f,
+                                region.u0, region.v0, 0.0f, 1.0f};
+    GLState::matrixMode(GL_TEXTURE);
+    GLState::loadMatrix(matrix);
+    GLState::matrixMode(GL_MODELVIEW);
+}
 
 StaticObject::StaticObject(float x, float y, float z, float size, ObjectType type,
                            float colorR, float colorG, float colorB)
@@ -19,199 +41,252 @@ StaticObject::StaticObject(float x, float y, float z, float size, ObjectType typ
     color[0] = colorR;
     color[1] = colorG;
     color[2] = colorB;
+
+    if (type == BONFIRE)
+        lightId = LightManager::add(x, y + size * 0.6f, z, 1.0f, 0.55f, 0.2f, 8.0f);
+}
+
+StaticObject::~StaticObject()
+{
+    LightManager::remove(lightId);
+}
+
+void StaticObject::update(float deltaTime)
+{
+    // Faíscas da fogueira agora são partículas que sobem e somem sozinhas.
+    if (type == BONFIRE)
+        ParticleSystem::emitBonfire(x, y, z, size, deltaTime);
+}
+
+void StaticObject::bakeWall()
+{
+    // Mesmo material e cantos do quad desenhado no case WALL (frente em z + size * 0.1).
+    const BakeMaterial wall = {{0.2f, 0.2f, 0.2f}, {0.5f, 0.5f, 0.5f}};
+    const float normal[3] = {0.0f, 0.0f, 1.0f};
+    const float corners[4][2] = {{-size, -size}, {size, -size}, {size, size}, {-size, size}};
+    for (int i = 0; i < 4; ++i)
+    {
+        const float position[3] = {x + corners[i][0], y + corners[i][1], z + size * 0.1f};
+        LightBaker::shadePoint(position, normal, LightBaker::contactOcclusion(corners[i][1] + size), wall, bakedCorners[i]);
+    }
+    bakedVersion = LightManager::staticVersion();
 }
+
 void StaticObject::draw()
 {
-    glPushMatrix();
-    glTranslatef(x, y, z);
+    GLState::pushMatrix();
+    GLState::translate(x, y, z);
 
     GLfloat ambient[] = {0.8f, 0.8f, 0.8f, 1.0f};
     GLfloat diffuse[] = {1.0f, 1.0f, 1.0f, 1.0f};
     GLfloat specular[] = {0.2f, 0.2f, 0.2f, 1.0f};
     GLfloat shininess = 10.0f;
 
-    glEnable(GL_LIGHTING);
-    glEnable(GL_TEXTURE_2D);
+    GLState::enable(GL_LIGHTING);
+    GLState::enable(GL_TEXTURE_2D);
 
-    glMaterialfv(GL_FRONT, GL_AMBIENT, ambient);
-    glMaterialfv(GL_FRONT, GL_DIFFUSE, diffuse);
-    glMaterialfv(GL_FRONT, GL_SPECULAR, specular);
-    glMaterialf(GL_FRONT, GL_SHININESS, shininess);
+    GLState::material(GL_AMBIENT, ambient);
+    GLState::material(GL_DIFFUSE, diffuse);
+    GLState::material(GL_SPECULAR, specular);
+    GLState::materialf(GL_SHININESS, shininess);
 
-    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    GLState::texEnvMode(GL_MODULATE);
+
+    // Todas as partes vêm do atlas; cada uma só troca a matriz de textura.
+    GLState::bindTexture(atlas.texture());
+    GLState::matrixMode(GL_TEXTURE);
+    GLState::pushMatrix();
+    GLState::matrixMode(GL_MODELVIEW);
+
+    // Segmentos das quádricas pela distância (QualityManager::detailLevel): cheio, médio, baixo.
+    static const int trunkSlices[3] = {12, 8, 6};
+    static const int trunkStacks[3] = {4, 2, 1};
+    static const int leavesSegments[3] = {24, 12, 8};
+    static const int clusterSegments[3] = {16, 8, 6};
+    static const int rockSegments[3] = {16, 10, 6};
+    int detail = (type == TREE || type == ROCK) ? QualityManager::detailLevel(x, z) : 0;
 
     switch (type)
     {
     case TREE:
     {
-        glBindTexture(GL_TEXTURE_2D, textureTrunk);
+        usePart(TRUNK);
 
         GLfloat trunkAmbient[] = {0.3f, 0.15f, 0.05f, 1.0f};
         GLfloat trunkDiffuse[] = {0.7f, 0.4f, 0.2f, 1.0f};
         GLfloat trunkSpecular[] = {0.1f, 0.1f, 0.05f, 1.0f};
         GLfloat trunkShininess = 5.0f;
 
-        glMaterialfv(GL_FRONT, GL_AMBIENT, trunkAmbient);
-        glMaterialfv(GL_FRONT, GL_DIFFUSE, trunkDiffuse);
-        glMaterialfv(GL_FRONT, GL_SPECULAR, trunkSpecular);
-        glMaterialf(GL_FRONT, GL_SHININESS, trunkShininess);
+        GLState::material(GL_AMBIENT, trunkAmbient);
+        GLState::material(GL_DIFFUSE, trunkDiffuse);
+        GLState::material(GL_SPECULAR, trunkSpecular);
+        GLState::materialf(GL_SHININESS, trunkShininess);
 
-        glPushMatrix();
-        glTranslatef(0.0f, 0.0f, 0.0f);
+        GLState::pushMatrix();
+        GLState::translate(0.0f, 0.0f, 0.0f);
 
         GLUquadric *trunkQuad = gluNewQuadric();
         gluQuadricTexture(trunkQuad, GL_TRUE);
         gluQuadricNormals(trunkQuad, GLU_SMOOTH);
 
-        glRotatef(-90.0f, 1.0f, 0.0f, 0.0f);
+        GLState::rotate(-90.0f, 1.0f, 0.0f, 0.0f);
 
         gluCylinder(trunkQuad,
                     size * 0.2,
                     size * 0.15,
                     size * 1.5,
-                    12,
-                    4);
+                    trunkSlices[detail],
+                    trunkStacks[detail]);
+        GLState::forgetCurrent(GLState::CURRENT_NORMAL | GLState::CURRENT_TEXCOORD);
 
         gluDeleteQuadric(trunkQuad);
-        glPopMatrix();
+        GLState::popMatrix();
 
-        glBindTexture(GL_TEXTURE_2D, textureLeaves);
+        usePart(LEAVES);
 
         GLfloat leavesAmbient[] = {0.2f, 0.3f, 0.1f, 1.0f};
         GLfloat leavesDiffuse[] = {0.3f, 0.7f, 0.3f, 0.8f};
         GLfloat leavesSpecular[] = {0.1f, 0.2f, 0.1f, 1.0f};
         GLfloat leavesShininess = 10.0f;
 
-        glMaterialfv(GL_FRONT, GL_AMBIENT, leavesAmbient);
-        glMaterialfv(GL_FRONT, GL_DIFFUSE, leavesDiffuse);
-        glMaterialfv(GL_FRONT, GL_SPECULAR, leavesSpecular);
-        glMaterialf(GL_FRONT, GL_SHININESS, leavesShininess);
+        GLState::material(GL_AMBIENT, leavesAmbient);
+        GLState::material(GL_DIFFUSE, leavesDiffuse);
+        GLState::material(GL_SPECULAR, leavesSpecular);
+        GLState::materialf(GL_SHININESS, leavesShininess);
 
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLState::enable(GL_BLEND);
+        GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-        glPushMatrix();
-        glTranslatef(0.0f, size * 1.2f, 0.0f);
+        GLState::pushMatrix();
+        GLState::translate(0.0f, size * 1.2f, 0.0f);
 
         GLUquadric *leavesQuad = gluNewQuadric();
         gluQuadricTexture(leavesQuad, GL_TRUE);
-        gluSphere(leavesQuad, size * 0.6f, 24, 24);
+        gluSphere(leavesQuad, size * 0.6f, leavesSegments[detail], leavesSegments[detail]);
+        GLState::forgetCurrent(GLState::CURRENT_NORMAL | GLState::CURRENT_TEXCOORD);
 
         for (int i = 0; i < 3; i++)
         {
-            glPushMatrix();
+            GLState::pushMatrix();
             float angle = i * 120.0f;
             float offset = size * 0.4f;
-            glTranslatef(cos(angle) * offset, size * 0.1f, sin(angle) * offset);
-            gluSphere(gluNewQuadric(), size * 0.3f, 16, 16);
-            glPopMatrix();
+            GLState::translate(cos(angle) * offset, size * 0.1f, sin(angle) * offset);
+            gluSphere(gluNewQuadric(), size * 0.3f, clusterSegments[detail], clusterSegments[detail]);
+            GLState::forgetCurrent(GLState::CURRENT_NORMAL);
+            GLState::popMatrix();
         }
 
         gluDeleteQuadric(leavesQuad);
-        glPopMatrix();
+        GLState::popMatrix();
 
-        glDisable(GL_BLEND);
+        GLState::disable(GL_BLEND);
 
         break;
     }
 
     case ROCK:
     {
-        glBindTexture(GL_TEXTURE_2D, textureRock);
+        usePart(ROCK_SURFACE);
 
         GLfloat rockAmbient[] = {0.2f, 0.2f, 0.2f, 1.0f};
         GLfloat rockDiffuse[] = {0.5f, 0.5f, 0.5f, 1.0f};
         GLfloat rockSpecular[] = {0.1f, 0.1f, 0.1f, 1.0f};
         GLfloat rockShininess = 1.0f;
 
-        glMaterialfv(GL_FRONT, GL_AMBIENT, rockAmbient);
-        glMaterialfv(GL_FRONT, GL_DIFFUSE, rockDiffuse);
-        glMaterialfv(GL_FRONT, GL_SPECULAR, rockSpecular);
-        glMaterialf(GL_FRONT, GL_SHININESS, rockShininess);
+        GLState::material(GL_AMBIENT, rockAmbient);
+        GLState::material(GL_DIFFUSE, rockDiffuse);
+        GLState::material(GL_SPECULAR, rockSpecular);
+        GLState::materialf(GL_SHININESS, rockShininess);
 
-        glPushMatrix();
-        glScalef(size, size * 0.7f, size);
+        GLState::pushMatrix();
+        GLState::scale(size, size * 0.7f, size);
         GLUquadric *quad = gluNewQuadric();
         gluQuadricTexture(quad, GL_TRUE);
-        gluSphere(quad, 0.5f, 16, 16);
+        gluSphere(quad, 0.5f, rockSegments[detail], rockSegments[detail]);
+        GLState::forgetCurrent(GLState::CURRENT_NORMAL | GLState::CURRENT_TEXCOORD);
         gluDeleteQuadric(quad);
-        glPopMatrix();
+        GLState::popMatrix();
         break;
     }
 
     case ITEM:
     {
-        glEnable(GL_LIGHTING);
-        glEnable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, textureItem);
-        glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+        GLState::enable(GL_LIGHTING);
+        GLState::enable(GL_TEXTURE_2D);
+        GLState::bindTexture(goldTexture);
+        GLState::matrixMode(GL_TEXTURE);
+        GLState::loadIdentity();
+        GLState::matrixMode(GL_MODELVIEW);
+        GLState::texEnvMode(GL_MODULATE);
         GLfloat goldAmbient[] = {0.3f, 0.2f, 0.1f, 1.0f};
         GLfloat goldDiffuse[] = {0.8f, 0.7f, 0.2f, 1.0f};
         GLfloat goldSpecular[] = {0.6f, 0.6f, 0.3f, 1.0f};
         GLfloat goldShininess = 50.0f;
         GLfloat goldEmission[] = {0.1f, 0.1f, 0.0f, 1.0f};
 
-        glMaterialfv(GL_FRONT, GL_AMBIENT, goldAmbient);
-        glMaterialfv(GL_FRONT, GL_DIFFUSE, goldDiffuse);
-        glMaterialfv(GL_FRONT, GL_SPECULAR, goldSpecular);
-        glMaterialf(GL_FRONT, GL_SHININESS, goldShininess);
-        glMaterialfv(GL_FRONT, GL_EMISSION, goldEmission);
+        GLState::material(GL_AMBIENT, goldAmbient);
+        GLState::material(GL_DIFFUSE, goldDiffuse);
+        GLState::material(GL_SPECULAR, goldSpecular);
+        GLState::materialf(GL_SHININESS, goldShininess);
+        GLState::material(GL_EMISSION, goldEmission);
 
         static float floatOffset = 0.0f;
         floatOffset += 0.03f;
         float floatHeight = sin(floatOffset) * 0.05f;
 
-        glPushMatrix();
-        glTranslatef(0.0f, floatHeight, 0.0f);
+        GLState::pushMatrix();
+        GLState::translate(0.0f, floatHeight, 0.0f);
         GLUquadric *quad = gluNewQuadric();
         gluQuadricTexture(quad, GL_TRUE);
         gluQuadricNormals(quad, GLU_SMOOTH);
 
-        glPushMatrix();
-        glScalef(1.0f, 0.2f, 1.0f);
+        GLState::pushMatrix();
+        GLState::scale(1.0f, 0.2f, 1.0f);
         gluSphere(quad, size * 0.5f, 24, 24);
-        glPopMatrix();
+        GLState::forgetCurrent(GLState::CURRENT_NORMAL | GLState::CURRENT_TEXCOORD);
+        GLState::popMatrix();
 
-        glDisable(GL_TEXTURE_2D);
+        GLState::disable(GL_TEXTURE_2D);
         GLfloat gemAmbient[] = {0.1f, 0.1f, 0.1f, 1.0f};
         GLfloat gemDiffuse[] = {0.9f, 0.8f, 0.1f, 1.0f};
-        glMaterialfv(GL_FRONT, GL_AMBIENT_AND_DIFFUSE, gemDiffuse);
+        GLState::material(GL_AMBIENT_AND_DIFFUSE, gemDiffuse);
 
         static float rotateAngle = 0.0f;
         rotateAngle += 0.8f;
-        glRotatef(rotateAngle, 0.0f, 1.0f, 0.0f);
+        GLState::rotate(rotateAngle, 0.0f, 1.0f, 0.0f);
         glutSolidTorus(0.05f, 0.15f, 6, 16);
+        GLState::forgetCurrent(GLState::CURRENT_NORMAL);
 
-        glEnable(GL_TEXTURE_2D);
+        GLState::enable(GL_TEXTURE_2D);
         gluDeleteQuadric(quad);
-        glPopMatrix();
+        GLState::popMatrix();
 
         GLfloat noEmission[] = {0.0f, 0.0f, 0.0f, 1.0f};
-        glMaterialfv(GL_FRONT, GL_EMISSION, noEmission);
-        glDisable(GL_TEXTURE_2D);
+        GLState::material(GL_EMISSION, noEmission);
+        GLState::disable(GL_TEXTURE_2D);
 
         break;
     }
 
     case HOUSE:
     {
-        glEnable(GL_TEXTURE_2D);
-        glEnable(GL_LIGHTING);
+        GLState::enable(GL_TEXTURE_2D);
+        GLState::enable(GL_LIGHTING);
 
-        glBindTexture(GL_TEXTURE_2D, textureHouseWall);
+        usePart(HOUSE_WALL);
 
         GLfloat wallAmbient[] = {0.4f, 0.3f, 0.2f, 1.0f};
         GLfloat wallDiffuse[] = {0.8f, 0.7f, 0.6f, 1.0f};
         GLfloat wallSpecular[] = {0.1f, 0.1f, 0.1f, 1.0f};
         GLfloat wallShininess = 10.0f;
 
-        glMaterialfv(GL_FRONT, GL_AMBIENT, wallAmbient);
-        glMaterialfv(GL_FRONT, GL_DIFFUSE, wallDiffuse);
-        glMaterialfv(GL_FRONT, GL_SPECULAR, wallSpecular);
-        glMaterialf(GL_FRONT, GL_SHININESS, wallShininess);
+        GLState::material(GL_AMBIENT, wallAmbient);
+        GLState::material(GL_DIFFUSE, wallDiffuse);
+        GLState::material(GL_SPECULAR, wallSpecular);
+        GLState::materialf(GL_SHININESS, wallShininess);
 
-        glPushMatrix();
-        glTranslatef(0.0f, 0.0f, 0.0f);
+        GLState::pushMatrix();
+        GLState::translate(0.0f, 0.0f, 0.0f);
 
         float houseWidth = size;
         float houseHeight = size * 0.8f;
@@ -219,202 +294,227 @@ void StaticObject::draw()
 
         for (int i = 0; i < 4; i++)
         {
-            glPushMatrix();
-            glRotatef(i * 90.0f, 0.0f, 1.0f, 0.0f);
-            glTranslatef(0.0f, 0.0f, houseDepth / 2);
+            GLState::pushMatrix();
+            GLState::rotate(i * 90.0f, 0.0f, 1.0f, 0.0f);
+            GLState::translate(0.0f, 0.0f, houseDepth / 2);
 
+            // A imagem repetia 2x2 vezes (UV até 2); no atlas não há repetição, então são 4 quads.
             glBegin(GL_QUADS);
-            glNormal3f(0.0f, 0.0f, 1.0f);
-
-            glTexCoord2f(0.0f, 0.0f);
-            glVertex3f(-houseWidth / 2, 0.0f, 0.0f);
-            glTexCoord2f(2.0f, 0.0f);
-            glVertex3f(houseWidth / 2, 0.0f, 0.0f);
-            glTexCoord2f(2.0f, 2.0f);
-            glVertex3f(houseWidth / 2, houseHeight, 0.0f);
-            glTexCoord2f(0.0f, 2.0f);
-            glVertex3f(-houseWidth / 2, houseHeight, 0.0f);
+            GLState::normal(0.0f, 0.0f, 1.0f);
+            for (int tile = 0; tile < 4; ++tile)
+            {
+                float left = -houseWidth / 2 + (tile % 2) * houseWidth / 2;
+                float bottom = (tile / 2) * houseHeight / 2;
+                GLState::texCoord(0.0f, 0.0f);
+                glVertex3f(left, bottom, 0.0f);
+                GLState::texCoord(1.0f, 0.0f);
+                glVertex3f(left + houseWidth / 2, bottom, 0.0f);
+                GLState::texCoord(1.0f, 1.0f);
+                glVertex3f(left + houseWidth / 2, bottom + houseHeight / 2, 0.0f);
+                GLState::texCoord(0.0f, 1.0f);
+                glVertex3f(left, bottom + houseHeight / 2, 0.0f);
+            }
             glEnd();
 
             if (i < 3)
             {
-                glDisable(GL_TEXTURE_2D);
+                GLState::disable(GL_TEXTURE_2D);
                 GLfloat windowAmbient[] = {0.1f, 0.1f, 0.2f, 0.7f};
                 GLfloat windowDiffuse[] = {0.2f, 0.2f, 0.4f, 0.7f};
-                glMaterialfv(GL_FRONT, GL_AMBIENT, windowAmbient);
-                glMaterialfv(GL_FRONT, GL_DIFFUSE, windowDiffuse);
+                GLState::material(GL_AMBIENT, windowAmbient);
+                GLState::material(GL_DIFFUSE, windowDiffuse);
 
-                glEnable(GL_BLEND);
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                GLState::enable(GL_BLEND);
+                GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-                glPushMatrix();
-                glTranslatef(0.0f, houseHeight * 0.5f, 0.01f);
-                glScalef(0.3f, 0.4f, 1.0f);
+                GLState::pushMatrix();
+                GLState::translate(0.0f, houseHeight * 0.5f, 0.01f);
+                GLState::scale(0.3f, 0.4f, 1.0f);
 
                 glBegin(GL_QUADS);
-                glNormal3f(0.0f, 0.0f, 1.0f);
+                GLState::normal(0.0f, 0.0f, 1.0f);
                 glVertex3f(-0.5f, -0.5f, 0.0f);
                 glVertex3f(0.5f, -0.5f, 0.0f);
                 glVertex3f(0.5f, 0.5f, 0.0f);
                 glVertex3f(-0.5f, 0.5f, 0.0f);
                 glEnd();
 
-                glPopMatrix();
-                glDisable(GL_BLEND);
-                glEnable(GL_TEXTURE_2D);
-                glMaterialfv(GL_FRONT, GL_AMBIENT, wallAmbient);
-                glMaterialfv(GL_FRONT, GL_DIFFUSE, wallDiffuse);
+                GLState::popMatrix();
+                GLState::disable(GL_BLEND);
+                GLState::enable(GL_TEXTURE_2D);
+                GLState::material(GL_AMBIENT, wallAmbient);
+                GLState::material(GL_DIFFUSE, wallDiffuse);
             }
-            glPopMatrix();
+            GLState::popMatrix();
         }
 
-        glBindTexture(GL_TEXTURE_2D, textureFloor);
+        usePart(FLOOR);
         glBegin(GL_QUADS);
-        glNormal3f(0.0f, 1.0f, 0.0f);
-        glTexCoord2f(0.0f, 0.0f);
+        GLState::normal(0.0f, 1.0f, 0.0f);
+        GLState::texCoord(0.0f, 0.0f);
         glVertex3f(-houseWidth / 2, 0.0f, -houseDepth / 2);
-        glTexCoord2f(2.0f, 0.0f);
+        GLState::texCoord(1.0f, 0.0f);
         glVertex3f(houseWidth / 2, 0.0f, -houseDepth / 2);
-        glTexCoord2f(2.0f, 2.0f);
+        GLState::texCoord(1.0f, 1.0f);
         glVertex3f(houseWidth / 2, 0.0f, houseDepth / 2);
-        glTexCoord2f(0.0f, 2.0f);
+        GLState::texCoord(0.0f, 1.0f);
         glVertex3f(-houseWidth / 2, 0.0f, houseDepth / 2);
         glEnd();
 
-        glPopMatrix();
-        glBindTexture(GL_TEXTURE_2D, textureRoof);
+        GLState::popMatrix();
+        usePart(ROOF);
 
         GLfloat roofAmbient[] = {0.3f, 0.1f, 0.0f, 1.0f};
         GLfloat roofDiffuse[] = {0.6f, 0.2f, 0.1f, 1.0f};
         GLfloat roofSpecular[] = {0.1f, 0.1f, 0.1f, 1.0f};
         GLfloat roofShininess = 5.0f;
 
-        glMaterialfv(GL_FRONT, GL_AMBIENT, roofAmbient);
-        glMaterialfv(GL_FRONT, GL_DIFFUSE, roofDiffuse);
-        glMaterialfv(GL_FRONT, GL_SPECULAR, roofSpecular);
-        glMaterialf(GL_FRONT, GL_SHININESS, roofShininess);
+        GLState::material(GL_AMBIENT, roofAmbient);
+        GLState::material(GL_DIFFUSE, roofDiffuse);
+        GLState::material(GL_SPECULAR, roofSpecular);
+        GLState::materialf(GL_SHININESS, roofShininess);
 
         float roofHeight = size * 0.4f;
         float roofOverhang = size * 0.1f;
 
-        glPushMatrix();
-        glTranslatef(0.0f, houseHeight, 0.0f);
+        GLState::pushMatrix();
+        GLState::translate(0.0f, houseHeight, 0.0f);
 
         glBegin(GL_TRIANGLES);
-        glNormal3f(0.0f, roofHeight, houseDepth / 2);
-        glTexCoord2f(0.5f, 1.0f);
+        GLState::normal(0.0f, roofHeight, houseDepth / 2);
+        GLState::texCoord(0.5f, 1.0f);
         glVertex3f(0.0f, roofHeight, 0.0f);
-        glTexCoord2f(0.0f, 0.0f);
+        GLState::texCoord(0.0f, 0.0f);
         glVertex3f(-houseWidth / 2 - roofOverhang, 0.0f, -houseDepth / 2 - roofOverhang);
-        glTexCoord2f(1.0f, 0.0f);
+        GLState::texCoord(1.0f, 0.0f);
         glVertex3f(houseWidth / 2 + roofOverhang, 0.0f, -houseDepth / 2 - roofOverhang);
         glEnd();
 
         glBegin(GL_TRIANGLES);
-        glNormal3f(0.0f, roofHeight, -houseDepth / 2);
-        glTexCoord2f(0.5f, 1.0f);
+        GLState::normal(0.0f, roofHeight, -houseDepth / 2);
+        GLState::texCoord(0.5f, 1.0f);
         glVertex3f(0.0f, roofHeight, 0.0f);
-        glTexCoord2f(0.0f, 0.0f);
+        GLState::texCoord(0.0f, 0.0f);
         glVertex3f(-houseWidth / 2 - roofOverhang, 0.0f, houseDepth / 2 + roofOverhang);
-        glTexCoord2f(1.0f, 0.0f);
+        GLState::texCoord(1.0f, 0.0f);
         glVertex3f(houseWidth / 2 + roofOverhang, 0.0f, houseDepth / 2 + roofOverhang);
         glEnd();
 
         glBegin(GL_QUADS);
-        glNormal3f(1.0f, 0.0f, 0.0f);
-        glTexCoord2f(0.0f, 0.0f);
+        GLState::normal(1.0f, 0.0f, 0.0f);
+        GLState::texCoord(0.0f, 0.0f);
         glVertex3f(houseWidth / 2 + roofOverhang, 0.0f, -houseDepth / 2 - roofOverhang);
-        glTexCoord2f(1.0f, 0.0f);
+        GLState::texCoord(1.0f, 0.0f);
         glVertex3f(houseWidth / 2 + roofOverhang, 0.0f, houseDepth / 2 + roofOverhang);
-        glTexCoord2f(0.5f, 1.0f);
+        GLState::texCoord(0.5f, 1.0f);
         glVertex3f(0.0f, roofHeight, 0.0f);
-        glTexCoord2f(0.5f, 1.0f);
+        GLState::texCoord(0.5f, 1.0f);
         glVertex3f(0.0f, roofHeight, 0.0f);
 
-        glNormal3f(-1.0f, 0.0f, 0.0f);
-        glTexCoord2f(0.0f, 0.0f);
+        GLState::normal(-1.0f, 0.0f, 0.0f);
+        GLState::texCoord(0.0f, 0.0f);
         glVertex3f(-houseWidth / 2 - roofOverhang, 0.0f, houseDepth / 2 + roofOverhang);
-        glTexCoord2f(1.0f, 0.0f);
+        GLState::texCoord(1.0f, 0.0f);
         glVertex3f(-houseWidth / 2 - roofOverhang, 0.0f, -houseDepth / 2 - roofOverhang);
-        glTexCoord2f(0.5f, 1.0f);
+        GLState::texCoord(0.5f, 1.0f);
         glVertex3f(0.0f, roofHeight, 0.0f);
-        glTexCoord2f(0.5f, 1.0f);
+        GLState::texCoord(0.5f, 1.0f);
         glVertex3f(0.0f, roofHeight, 0.0f);
         glEnd();
 
-        glPopMatrix();
+        GLState::popMatrix();
 
-        glBindTexture(GL_TEXTURE_2D, textureDoor);
-        glPushMatrix();
-        glTranslatef(0.0f, 0.0f, -houseDepth / 2 - 0.01f);
-        glRotatef(180.0f, 0.0f, 1.0f, 0.0f);
+        usePart(DOOR);
+        GLState::pushMatrix();
+        GLState::translate(0.0f, 0.0f, -houseDepth / 2 - 0.01f);
+        GLState::rotate(180.0f, 0.0f, 1.0f, 0.0f);
 
         GLfloat doorAmbient[] = {0.4f, 0.3f, 0.2f, 1.0f};
         GLfloat doorDiffuse[] = {0.7f, 0.5f, 0.3f, 1.0f};
-        glMaterialfv(GL_FRONT, GL_AMBIENT, doorAmbient);
-        glMaterialfv(GL_FRONT, GL_DIFFUSE, doorDiffuse);
+        GLState::material(GL_AMBIENT, doorAmbient);
+        GLState::material(GL_DIFFUSE, doorDiffuse);
 
         glBegin(GL_QUADS);
-        glNormal3f(0.0f, 0.0f, 1.0f);
-        glTexCoord2f(0.0f, 0.0f);
+        GLState::normal(0.0f, 0.0f, 1.0f);
+        GLState::texCoord(0.0f, 0.0f);
         glVertex3f(-0.3f, 0.0f, 0.0f);
-        glTexCoord2f(1.0f, 0.0f);
+        GLState::texCoord(1.0f, 0.0f);
         glVertex3f(0.3f, 0.0f, 0.0f);
-        glTexCoord2f(1.0f, 1.0f);
+        GLState::texCoord(1.0f, 1.0f);
         glVertex3f(0.3f, houseHeight * 0.6f, 0.0f);
-        glTexCoord2f(0.0f, 1.0f);
+        GLState::texCoord(0.0f, 1.0f);
         glVertex3f(-0.3f, houseHeight * 0.6f, 0.0f);
         glEnd();
 
-        glPopMatrix();
+        GLState::popMatrix();
 
-        glBindTexture(GL_TEXTURE_2D, textureBrick);
-        glPushMatrix();
-        glTranslatef(houseWidth * 0.3f, houseHeight + roofHeight * 0.5f, 0.0f);
-        glScalef(0.1f, 0.3f, 0.1f);
+        usePart(BRICK);
+        GLState::pushMatrix();
+        GLState::translate(houseWidth * 0.3f, houseHeight + roofHeight * 0.5f, 0.0f);
+        GLState::scale(0.1f, 0.3f, 0.1f);
 
         GLfloat chimneyAmbient[] = {0.5f, 0.3f, 0.2f, 1.0f};
         GLfloat chimneyDiffuse[] = {0.8f, 0.5f, 0.4f, 1.0f};
-        glMaterialfv(GL_FRONT, GL_AMBIENT, chimneyAmbient);
-        glMaterialfv(GL_FRONT, GL_DIFFUSE, chimneyDiffuse);
+        GLState::material(GL_AMBIENT, chimneyAmbient);
+        GLState::material(GL_DIFFUSE, chimneyDiffuse);
 
+        // glutSolidCube não gera UV: amostra o meio da região.
+        GLState::texCoord(0.5f, 0.5f);
         glutSolidCube(1.0f);
-        glPopMatrix();
+        GLState::forgetCurrent(GLState::CURRENT_NORMAL);
+        GLState::popMatrix();
 
-        glDisable(GL_TEXTURE_2D);
+        GLState::disable(GL_TEXTURE_2D);
         break;
     }
 
     case WALL:
     {
-        glBindTexture(GL_TEXTURE_2D, textureWall);
+        usePart(WALL_SURFACE);
 
         GLfloat wallAmbient[] = {0.2f, 0.2f, 0.2f, 1.0f};
         GLfloat wallDiffuse[] = {0.5f, 0.5f, 0.5f, 1.0f};
         GLfloat wallSpecular[] = {0.1f, 0.1f, 0.1f, 1.0f};
         GLfloat wallShininess = 1.0f;
 
-        glMaterialfv(GL_FRONT, GL_AMBIENT, wallAmbient);
-        glMaterialfv(GL_FRONT, GL_DIFFUSE, wallDiffuse);
-        glMaterialfv(GL_FRONT, GL_SPECULAR, wallSpecular);
-        glMaterialf(GL_FRONT, GL_SHININESS, wallShininess);
+        GLState::material(GL_AMBIENT, wallAmbient);
+        GLState::material(GL_DIFFUSE, wallDiffuse);
+        GLState::material(GL_SPECULAR, wallSpecular);
+        GLState::materialf(GL_SHININESS, wallShininess);
 
-        glPushMatrix();
-        glScalef(1.0f, 1.0f, 0.1f);
+        // Parede não se move: luz assada nos cantos, desenhada sem iluminação.
+        if (bakedVersion != LightManager::staticVersion())
+            bakeWall();
+        bool lighting = GLState::isEnabled(GL_LIGHTING);
+        bool colorMaterial = GLState::isEnabled(GL_COLOR_MATERIAL);
+        GLState::disable(GL_LIGHTING);
+        GLState::disable(GL_COLOR_MATERIAL);
+
+        GLState::pushMatrix();
+        GLState::scale(1.0f, 1.0f, 0.1f);
 
         float wallSize = size;
         glBegin(GL_QUADS);
-        glNormal3f(0.0f, 0.0f, 1.0f);
-        glTexCoord2f(0.0f, 0.0f);
+        GLState::normal(0.0f, 0.0f, 1.0f);
+        GLState::color(bakedCorners[0]);
+        GLState::texCoord(0.0f, 0.0f);
         glVertex3f(-wallSize, -wallSize, wallSize);
-        glTexCoord2f(1.0f, 0.0f);
+        GLState::color(bakedCorners[1]);
+        GLState::texCoord(1.0f, 0.0f);
         glVertex3f(wallSize, -wallSize, wallSize);
-        glTexCoord2f(1.0f, 1.0f);
+        GLState::color(bakedCorners[2]);
+        GLState::texCoord(1.0f, 1.0f);
         glVertex3f(wallSize, wallSize, wallSize);
-        glTexCoord2f(0.0f, 1.0f);
+        GLState::color(bakedCorners[3]);
+        GLState::texCoord(0.0f, 1.0f);
         glVertex3f(-wallSize, wallSize, wallSize);
         glEnd();
-        glPopMatrix();
+        GLState::popMatrix();
+
+        // A cor do último canto não pode vazar para o próximo objeto.
+        GLState::color(1.0f, 1.0f, 1.0f, 1.0f);
+        GLState::setEnabled(GL_COLOR_MATERIAL, colorMaterial);
+        GLState::setEnabled(GL_LIGHTING, lighting);
         break;
     }
 
@@ -423,32 +523,34 @@ void StaticObject::draw()
         static float flicker = 0.0f;
         flicker += 0.1f;
 
-        glBindTexture(GL_TEXTURE_2D, textureWood);
+        usePart(WOOD);
 
         GLfloat woodAmbient[] = {0.3f, 0.15f, 0.05f, 1.0f};
         GLfloat woodDiffuse[] = {0.6f, 0.3f, 0.1f, 1.0f};
         GLfloat woodSpecular[] = {0.1f, 0.05f, 0.02f, 1.0f};
         GLfloat woodShininess = 10.0f;
 
-        glMaterialfv(GL_FRONT, GL_AMBIENT, woodAmbient);
-        glMaterialfv(GL_FRONT, GL_DIFFUSE, woodDiffuse);
-        glMaterialfv(GL_FRONT, GL_SPECULAR, woodSpecular);
-        glMaterialf(GL_FRONT, GL_SHININESS, woodShininess);
+        GLState::material(GL_AMBIENT, woodAmbient);
+        GLState::material(GL_DIFFUSE, woodDiffuse);
+        GLState::material(GL_SPECULAR, woodSpecular);
+        GLState::materialf(GL_SHININESS, woodShininess);
 
-        glPushMatrix();
-        glBindTexture(GL_TEXTURE_2D, textureRock);
-        glTranslatef(0.0f, -0.1f, 0.0f);
+        GLState::pushMatrix();
+        usePart(ROCK_SURFACE);
+        GLState::translate(0.0f, -0.1f, 0.0f);
+        GLState::texCoord(0.5f, 0.5f);
         glutSolidTorus(0.2f, 0.4f, 8, 16);
+        GLState::forgetCurrent(GLState::CURRENT_NORMAL);
 
-        glBindTexture(GL_TEXTURE_2D, textureWood);
+        usePart(WOOD);
         for (int i = 0; i < 6; i++)
         {
-            glPushMatrix();
+            GLState::pushMatrix();
             float angle = i * 60.0f;
             float tilt = 15.0f + (i % 2) * 10.0f;
 
-            glRotatef(angle, 0.0f, 1.0f, 0.0f);
-            glRotatef(tilt, 0.0f, 0.0f, 1.0f);
+            GLState::rotate(angle, 0.0f, 1.0f, 0.0f);
+            GLState::rotate(tilt, 0.0f, 0.0f, 1.0f);
 
             GLUquadric *logQuad = gluNewQuadric();
             gluQuadricTexture(logQuad, GL_TRUE);
@@ -460,15 +562,16 @@ void StaticObject::draw()
                         size * 0.6f,
                         8,
                         3);
+            GLState::forgetCurrent(GLState::CURRENT_NORMAL | GLState::CURRENT_TEXCOORD);
 
             gluDeleteQuadric(logQuad);
-            glPopMatrix();
+            GLState::popMatrix();
         }
-        glPopMatrix();
+        GLState::popMatrix();
 
-        glDisable(GL_TEXTURE_2D);
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLState::disable(GL_TEXTURE_2D);
+        GLState::enable(GL_BLEND);
+        GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
         GLfloat fireAmbient[] = {0.5f, 0.2f, 0.0f, 0.8f};
         GLfloat fireDiffuse1[] = {1.0f, 0.6f, 0.1f, 0.7f};
@@ -476,12 +579,12 @@ void StaticObject::draw()
         GLfloat fireSpecular[] = {0.8f, 0.5f, 0.2f, 1.0f};
         GLfloat fireShininess = 50.0f;
 
-        glMaterialfv(GL_FRONT, GL_AMBIENT, fireAmbient);
-        glMaterialfv(GL_FRONT, GL_SPECULAR, fireSpecular);
-        glMaterialf(GL_FRONT, GL_SHININESS, fireShininess);
+        GLState::material(GL_AMBIENT, fireAmbient);
+        GLState::material(GL_SPECULAR, fireSpecular);
+        GLState::materialf(GL_SHININESS, fireShininess);
 
-        glPushMatrix();
-        glTranslatef(0.0f, size * 0.3f, 0.0f);
+        GLState::pushMatrix();
+        GLState::translate(0.0f, size * 0.3f, 0.0f);
 
         for (int i = 0; i < 8; i++)
         {
@@ -490,14 +593,14 @@ void StaticObject::draw()
             float offsetX = cos(i * 45.0f) * 0.2f;
             float offsetZ = sin(i * 45.0f) * 0.2f;
 
-            glMaterialfv(GL_FRONT, GL_DIFFUSE, i % 2 == 0 ? fireDiffuse1 : fireDiffuse2);
+            GLState::material(GL_DIFFUSE, i % 2 == 0 ? fireDiffuse1 : fireDiffuse2);
 
-            glPushMatrix();
-            glTranslatef(offsetX, 0.0f, offsetZ);
-            glScalef(scale, scale * heightScale, scale);
+            GLState::pushMatrix();
+            GLState::translate(offsetX, 0.0f, offsetZ);
+            GLState::scale(scale, scale * heightScale, scale);
 
             glBegin(GL_TRIANGLE_FAN);
-            glNormal3f(0.0f, 1.0f, 0.0f);
+            GLState::normal(0.0f, 1.0f, 0.0f);
             glVertex3f(0.0f, 0.3f, 0.0f);
             for (int j = 0; j <= 360; j += 30)
             {
@@ -507,46 +610,33 @@ void StaticObject::draw()
             }
             glEnd();
 
-            glPopMatrix();
+            GLState::popMatrix();
         }
 
-        glPointSize(3.0f);
-        glBegin(GL_POINTS);
-        for (int i = 0; i < 20; i++)
-        {
-            float sparkFlicker = flicker * 2.0f + i;
-            float x = cos(sparkFlicker + i * 18.0f) * 0.1f;
-            float y = 0.1f + fabs(sin(sparkFlicker * 0.7f + i)) * 0.3f;
-            float z = sin(sparkFlicker + i * 22.0f) * 0.1f;
-
-            glMaterialfv(GL_FRONT, GL_DIFFUSE, i % 3 ? fireDiffuse1 : fireDiffuse2);
-            glVertex3f(x, y, z);
-        }
-        glEnd();
-
-        glPopMatrix();
+        GLState::popMatrix();
 
-        glPushMatrix();
-        glTranslatef(0.0f, size * 0.8f, 0.0f);
+        GLState::pushMatrix();
+        GLState::translate(0.0f, size * 0.8f, 0.0f);
         GLfloat smokeAmbient[] = {0.2f, 0.2f, 0.2f, 0.4f};
         GLfloat smokeDiffuse[] = {0.3f, 0.3f, 0.3f, 0.3f};
-        glMaterialfv(GL_FRONT, GL_AMBIENT, smokeAmbient);
-        glMaterialfv(GL_FRONT, GL_DIFFUSE, smokeDiffuse);
+        GLState::material(GL_AMBIENT, smokeAmbient);
+        GLState::material(GL_DIFFUSE, smokeDiffuse);
 
         for (int i = 0; i < 3; i++)
         {
-            glPushMatrix();
+            GLState::pushMatrix();
             float smokeScale = 0.3f + sin(flicker * 0.5f + i) * 0.1f;
             float smokeHeight = i * 0.3f + flicker * 0.05f;
-            glTranslatef(0.0f, smokeHeight, 0.0f);
-            glScalef(smokeScale, smokeScale * 0.5f, smokeScale);
+            GLState::translate(0.0f, smokeHeight, 0.0f);
+            GLState::scale(smokeScale, smokeScale * 0.5f, smokeScale);
             glutSolidSphere(0.2f, 8, 8);
-            glPopMatrix();
+            GLState::forgetCurrent(GLState::CURRENT_NORMAL);
+            GLState::popMatrix();
         }
-        glPopMatrix();
+        GLState::popMatrix();
 
-        glDisable(GL_BLEND);
-        glEnable(GL_TEXTURE_2D);
+        GLState::disable(GL_BLEND);
+        GLState::enable(GL_TEXTURE_2D);
         break;
     }
 
@@ -556,6 +646,9 @@ void StaticObject::draw()
         break;
     }
 
-    glDisable(GL_TEXTURE_2D);
-    glPopMatrix();
+    GLState::disable(GL_TEXTURE_2D);
+    GLState::matrixMode(GL_TEXTURE);
+    GLState::popMatrix();
+    GLState::matrixMode(GL_MODELVIEW);
+    GLState::popMatrix();
 }
\ No newline at end of file
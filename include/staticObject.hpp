@@ -3,16 +3,46 @@
 
 #include "GameObject.hpp"
 #include <GL/glut.h>
+#include "glState.hpp"
+#include "particleSystem.hpp"
+#include "lightManager.hpp"
+#include "lightBaker.hpp"
+#include "qualityManager.hpp"
+#include "textureAtlas.hpp"
+#include "textureManager.hpp"
 
 class StaticObject : public GameObject {
 private:
     GLfloat color[3]; 
+    int lightId = -1; // luz da fogueira no LightManager
+    // Paredes: cor assada nos 4 cantos, refeita quando as luzes fixas mudam.
+    GLubyte bakedCorners[4][4];
+    unsigned int bakedVersion = 0;
+
+    void bakeWall();
+
+    // Imagens das partes, todas no mesmo atlas: um bind só para os objetos fixos do mapa.
+    enum Part
+    {
+        TRUNK, LEAVES, ROCK_SURFACE, HOUSE_WALL, FLOOR, ROOF, DOOR, BRICK, WALL_SURFACE, WOOD, PART_COUNT
+    };
+    static TextureAtlas atlas;
+    static int parts[PART_COUNT];
+    // Moeda fora do atlas: é a mesma textura das moedas instanciadas (EntityRenderer).
+    static GLuint goldTexture;
+    // Leva as UVs 0..1 da parte para a região dela no atlas (matriz de textura).
+    static void usePart(Part part);
 
 public:
     StaticObject(float x, float y, float z, float size, ObjectType type,
                  float colorR, float colorG, float colorB);
+    ~StaticObject() override;
 
+    void update(float deltaTime) override;
     void draw() override;
+
+    // Monta o atlas das partes (em segundo plano); no init, com o contexto GL.
+    static void loadTextures(bool compress);
 };
 
 #endif
@@ -0,0 +1,244 @@
+#include "textRenderer.hpp"
+#include <GL/freeglut_ext.h>
+#include <utility>
+#include <cmath>
+#include <iostream>
+
+GLuint TextRenderer::atlas = 0;
+bool TextRenderer::attempted = false;
+TextRenderer::Font TextRenderer::fonts[TextRenderer::FONT_COUNT];
+std::unordered_map<std::string, TextRenderer::TextRun> TextRenderer::runs;
+void *const TextRenderer::glutFonts[TextRenderer::FONT_COUNT] = {GLUT_BITMAP_HELVETICA_10, GLUT_BITMAP_HELVETICA_12,
+                                                                GLUT_BITMAP_HELVETICA_18};
+
+int TextRenderer::fontIndex(int fontSize)
+{
+    // Mesma escolha de fonte que o HUD fazia com o glutBitmapCharacter.
+    switch (fontSize)
+    {
+    case 10:
+        return 0;
+    case 18:
+        return 2;
+    default:
+        return 1;
+    }
+}
+
+void TextRenderer::init()
+{
+    if (attempted)
+        return;
+    attempted = true;
+
+    const int windowWidth = glutGet(GLUT_WINDOW_WIDTH);
+    const int windowHeight = glutGet(GLUT_WINDOW_HEIGHT);
+    if (windowWidth < ATLAS_WIDTH || windowHeight < ATLAS_HEIGHT)
+    {
+        std::cerr << "Janela pequena demais para montar o atlas de texto, usando glutBitmapCharacter." << std::endl;
+        return;
+    }
+
+    // Distribui as células (avanço + margem) em linhas dentro do atlas.
+    int cellX[FONT_COUNT][GLYPH_COUNT];
+    int cellY[FONT_COUNT][GLYPH_COUNT];
+    int penX = 0, penY = 0;
+    for (int f = 0; f < FONT_COUNT; ++f)
+    {
+        Font &font = fonts[f];
+        font.glutFont = glutFonts[f];
+        // O freeglut desenha todo glifo com a altura da fonte a partir de ~1/4 abaixo da base.
+        int fontHeight = glutBitmapHeight(font.glutFont);
+        font.lineHeight = fontHeight + PADDING * 2;
+        font.descent = fontHeight / 4 + 1 + PADDING;
+
+        for (int i = 0; i < GLYPH_COUNT; ++i)
+        {
+            int advance = glutBitmapWidth(font.glutFont, FIRST_CHAR + i);
+            int cellWidth = advance + PADDING * 2;
+            if (penX + cellWidth > ATLAS_WIDTH)
+            {
+                penX = 0;
+                penY += font.lineHeight;
+            }
+            if (penY + font.lineHeight > ATLAS_HEIGHT)
+            {
+                std::cerr << "Atlas de texto sem espaço para as fontes." << std::endl;
+                return;
+            }
+
+            cellX[f][i] = penX;
+            cellY[f][i] = penY;
+            Glyph &glyph = font.glyphs[i];
+            glyph.advance = static_cast<GLfloat>(advance);
+            glyph.u0 = static_cast<GLfloat>(penX) / ATLAS_WIDTH;
+            glyph.v0 = static_cast<GLfloat>(penY) / ATLAS_HEIGHT;
+            glyph.u1 = static_cast<GLfloat>(penX + cellWidth) / ATLAS_WIDTH;
+            glyph.v1 = static_cast<GLfloat>(penY + font.lineHeight) / ATLAS_HEIGHT;
+            penX += cellWidth;
+        }
+        penX = 0;
+        penY += font.lineHeight;
+    }
+
+    // Desenha os glifos em branco sobre preto no canto do back buffer e lê de volta.
+    GLfloat clearColor[4];
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+
+    GLState::pushAttrib();
+    GLState::disable(GL_LIGHTING);
+    GLState::disable(GL_DEPTH_TEST);
+    GLState::disable(GL_TEXTURE_2D);
+    GLState::disable(GL_BLEND);
+    GLState::disable(GL_FOG);
+    GLState::matrixMode(GL_PROJECTION);
+    GLState::pushMatrix();
+    GLState::loadIdentity();
+    GLState::ortho2D(0, windowWidth, 0, windowHeight);
+    GLState::matrixMode(GL_MODELVIEW);
+    GLState::pushMatrix();
+    GLState::loadIdentity();
+
+    glViewport(0, 0, windowWidth, windowHeight);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    GLState::color(1.0f, 1.0f, 1.0f);
+    for (int f = 0; f < FONT_COUNT; ++f)
+    {
+        for (int i = 0; i < GLYPH_COUNT; ++i)
+        {
+            glRasterPos2i(cellX[f][i] + PADDING, cellY[f][i] + fonts[f].descent);
+            glutBitmapCharacter(fonts[f].glutFont, FIRST_CHAR + i);
+        }
+    }
+
+    std::vector<GLubyte> pixels(ATLAS_WIDTH * ATLAS_HEIGHT);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, ATLAS_WIDTH, ATLAS_HEIGHT, GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+    glClear(GL_COLOR_BUFFER_BIT);
+    GLState::popMatrix();
+    GLState::matrixMode(GL_PROJECTION);
+    GLState::popMatrix();
+    GLState::matrixMode(GL_MODELVIEW);
+    GLState::popAttrib();
+
+    GLuint previous = GLState::boundTexture();
+    glGenTextures(1, &atlas);
+    GLState::bindTexture(atlas);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, ATLAS_WIDTH, ATLAS_HEIGHT, 0, GL_ALPHA, GL_UNSIGNED_BYTE, pixels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    GLState::bindTexture(previous);
+}
+
+void TextRenderer::shutdown()
+{
+    if (atlas)
+        glDeleteTextures(1, &atlas);
+    atlas = 0;
+    attempted = false;
+    runs.clear();
+}
+
+bool TextRenderer::isReady() { return atlas != 0; }
+
+const TextRenderer::TextRun &TextRenderer::layout(const char *text, int font)
+{
+    std::string key(1, static_cast<char>('0' + font));
+    key += text;
+
+    auto found = runs.find(key);
+    if (found != runs.end())
+        return found->second;
+
+    // Textos dinâmicos (contadores, porcentagens) geram chaves novas todo frame.
+    if (runs.size() >= MAX_CACHED_RUNS)
+        runs.clear();
+
+    const Font &f = fonts[font];
+    TextRun run;
+    float pen = 0.0f;
+    for (const char *c = text; *c != '\0'; ++c)
+    {
+        int code = static_cast<unsigned char>(*c);
+        if (code < FIRST_CHAR || code > LAST_CHAR)
+            continue;
+
+        const Glyph &g = f.glyphs[code - FIRST_CHAR];
+        float x0 = pen - PADDING;
+        float x1 = x0 + g.advance + PADDING * 2;
+        float y0 = static_cast<float>(-f.descent);
+        float y1 = y0 + f.lineHeight;
+        run.vertices.push_back({x0, y0, g.u0, g.v0});
+        run.vertices.push_back({x1, y0, g.u1, g.v0});
+        run.vertices.push_back({x1, y1, g.u1, g.v1});
+        run.vertices.push_back({x0, y1, g.u0, g.v1});
+        pen += g.advance;
+    }
+    run.width = pen;
+
+    return runs.emplace(std::move(key), std::move(run)).first->second;
+}
+
+bool TextRenderer::draw(float x, float y, const char *text, int fontSize)
+{
+    if (!atlas)
+        return false;
+
+    const TextRun &run = layout(text, fontIndex(fontSize));
+    if (run.vertices.empty())
+        return true;
+
+    GLState::pushAttrib();
+    GLState::disable(GL_LIGHTING);
+    GLState::enable(GL_TEXTURE_2D);
+    GLState::bindTexture(atlas);
+    GLState::texEnvMode(GL_MODULATE);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Alinha a linha de base ao pixel, como o glRasterPos, para o atlas não borrar.
+    GLState::pushMatrix();
+    GLState::translate(std::floor(x + 0.5f), std::floor(y + 0.5f), 0.0f);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(TextVertex), &run.vertices[0].x);
+    glTexCoordPointer(2, GL_FLOAT, sizeof(TextVertex), &run.vertices[0].u);
+    glDrawArrays(GL_QUADS, 0, static_cast<GLsizei>(run.vertices.size()));
+    GLState::forgetCurrent(GLState::CURRENT_TEXCOORD);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    GLState::popMatrix();
+    GLState::popAttrib();
+    return true;
+}
+
+void TextRenderer::print(float x, float y, const char *text, int fontSize)
+{
+    if (draw(x, y, text, fontSize))
+        return;
+    glRasterPos2f(x, y);
+    for (const char *c = text; *c != '\0'; ++c)
+        glutBitmapCharacter(glutFonts[fontIndex(fontSize)], *c);
+}
+
+float TextRenderer::width(const char *text, int fontSize)
+{
+    int font = fontIndex(fontSize);
+    if (atlas)
+        return layout(text, font).width;
+
+    float total = 0.0f;
+    for (const char *c = text; *c != '\0'; ++c)
+        total += glutBitmapWidth(glutFonts[font], static_cast<unsigned char>(*c));
+    return total;
+}
@@ -0,0 +1,74 @@
+#ifndef TEXT_RENDERER_HPP
+#define TEXT_RENDERER_HPP
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "glState.hpp"
+
+// Texto do HUD a partir de um atlas: as fontes bitmap do GLUT são rasterizadas
+// uma vez em uma textura e cada string vira um vetor de quads guardado em cache
+// (chave = fonte + texto). Cada chamada de draw é um único glDrawArrays.
+class TextRenderer
+{
+public:
+    // Monta o atlas usando o back buffer; chamar no início de um frame, antes do glClear.
+    static void init();
+    static void shutdown();
+    static bool isReady();
+
+    // Mesmo contrato do glRasterPos2f + glutBitmapCharacter: (x, y) é a linha de base
+    // na modelview atual e a cor é a do glColor. Retorna false se o atlas não existe.
+    static bool draw(float x, float y, const char *text, int fontSize);
+    // draw, ou glutBitmapCharacter na mesma fonte quando o atlas não existe.
+    static void print(float x, float y, const char *text, int fontSize);
+    static float width(const char *text, int fontSize);
+
+private:
+    static const int FONT_COUNT = 3;
+    static const int FIRST_CHAR = 32;
+    static const int LAST_CHAR = 126;
+    static const int GLYPH_COUNT = LAST_CHAR - FIRST_CHAR + 1;
+    static const int ATLAS_WIDTH = 512;
+    static const int ATLAS_HEIGHT = 256;
+    static const int PADDING = 2;
+    static const size_t MAX_CACHED_RUNS = 256;
+
+    struct Glyph
+    {
+        GLfloat u0, v0, u1, v1;
+        GLfloat advance;
+    };
+
+    struct Font
+    {
+        void *glutFont;
+        int lineHeight;
+        int descent;
+        Glyph glyphs[GLYPH_COUNT];
+    };
+
+    struct TextVertex
+    {
+        GLfloat x, y;
+        GLfloat u, v;
+    };
+
+    struct TextRun
+    {
+        std::vector<TextVertex> vertices;
+        float width;
+    };
+
+    static GLuint atlas;
+    static bool attempted;
+    static Font fonts[FONT_COUNT];
+    // Fontes do GLUT na ordem do fontIndex: origem dos glifos do atlas e fallback sem ele.
+    static void *const glutFonts[FONT_COUNT];
+    static std::unordered_map<std::string, TextRun> runs;
+
+    static int fontIndex(int fontSize);
+    static const TextRun &layout(const char *text, int font);
+};
+
+#endif
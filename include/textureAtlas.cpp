@@ -0,0 +1,276 @@
+#include "textureAtlas.hpp"
+#include "assetLoader.hpp"
+#include "meshCache.hpp"
+#include "textureCache.hpp"
+#include "textureLoader.hpp"
+#include "textureManager.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+namespace
+{
+    // Menor lado de região: múltiplo de 2^(LEVELS - 1), para cada mipmap cair inteiro na região.
+    const int MIN_REGION = 1 << (TextureAtlas::LEVELS - 1);
+
+    struct SkylineNode
+    {
+        int x, y, width;
+    };
+
+    // Cópia da imagem no atlas com a borda repetida em volta.
+    void blit(const unsigned char *pixels, int width, int height, int channels, unsigned char *atlas,
+              int atlasWidth, int x, int y)
+    {
+        const int padding = TextureAtlas::PADDING;
+        for (int row = -padding; row < height + padding; ++row)
+        {
+            int sourceRow = std::min(std::max(row, 0), height - 1);
+            const unsigned char *src = pixels + static_cast<size_t>(sourceRow) * width * channels;
+            unsigned char *dst = atlas + (static_cast<size_t>(y + row) * atlasWidth + (x - padding)) * channels;
+            for (int column = -padding; column < width + padding; ++column, dst += channels)
+                std::memcpy(dst, src + std::min(std::max(column, 0), width - 1) * channels, channels);
+        }
+    }
+}
+
+int TextureAtlas::add(const char *path)
+{
+    for (size_t i = 0; i < sources.size(); ++i)
+        if (sources[i].path == path)
+            return static_cast<int>(i);
+    sources.push_back({path, {255, 255, 255}, 0, 0, 0, 0});
+    regions.push_back({0.0f, 0.0f, 1.0f, 1.0f});
+    return static_cast<int>(sources.size() - 1);
+}
+
+int TextureAtlas::addSolid(unsigned char r, unsigned char g, unsigned char b)
+{
+    sources.push_back({std::string(), {r, g, b}, 0, 0, 0, 0});
+    regions.push_back({0.0f, 0.0f, 1.0f, 1.0f});
+    return static_cast<int>(sources.size() - 1);
+}
+
+bool TextureAtlas::pack(std::vector<Source> &sources, int maxSide, int &width, int &height)
+{
+    // Mais altas primeiro; cada uma vai onde o topo fica mais baixo (depois, mais à esquerda).
+    std::vector<size_t> order(sources.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return sources[a].height != sources[b].height ? sources[a].height > sources[b].height
+                                                      : sources[a].width > sources[b].width;
+    });
+
+    // Tenta cada largura em potência de 2 e fica com a menor área (empate: a mais quadrada).
+    bool found = false;
+    std::vector<Source> best;
+    for (int candidate = MIN_REGION; candidate <= maxSide; candidate *= 2)
+    {
+        std::vector<Source> placed = sources;
+        std::vector<SkylineNode> skyline = {{0, 0, candidate}};
+        int used = 0;
+        bool fits = true;
+        for (size_t index : order)
+        {
+            int slotWidth = placed[index].width + 2 * PADDING, slotHeight = placed[index].height + 2 * PADDING;
+            int bestNode = -1, bestY = INT_MAX;
+            for (size_t i = 0; i < skyline.size(); ++i)
+            {
+                if (skyline[i].x + slotWidth > candidate)
+                    break;
+                int y = 0;
+                for (size_t j = i, covered = 0; covered < static_cast<size_t>(slotWidth); ++j)
+                {
+                    y = std::max(y, skyline[j].y);
+                    covered += skyline[j].width;
+                }
+                if (y + slotHeight <= maxSide && y < bestY)
+                {
+                    bestY = y;
+                    bestNode = static_cast<int>(i);
+                }
+            }
+            if (bestNode < 0)
+            {
+                fits = false;
+                break;
+            }
+
+            int x = skyline[bestNode].x;
+            placed[index].x = x + PADDING;
+            placed[index].y = bestY + PADDING;
+            used = std::max(used, bestY + slotHeight);
+
+            // Novo degrau cobrindo [x, x + slotWidth); os que ficaram embaixo encolhem ou saem.
+            skyline.insert(skyline.begin() + bestNode, {x, bestY + slotHeight, slotWidth});
+            for (size_t i = bestNode + 1; i < skyline.size();)
+            {
+                int overlap = x + slotWidth - skyline[i].x;
+                if (overlap <= 0)
+                    break;
+                if (overlap < skyline[i].width)
+                {
+                    skyline[i].x += overlap;
+                    skyline[i].width -= overlap;
+                    break;
+                }
+                skyline.erase(skyline.begin() + i);
+            }
+            for (size_t i = 0; i + 1 < skyline.size();)
+            {
+                if (skyline[i].y == skyline[i + 1].y)
+                {
+                    skyline[i].width += skyline[i + 1].width;
+                    skyline.erase(skyline.begin() + i + 1);
+                }
+                else
+                    ++i;
+            }
+        }
+        if (!fits)
+            continue;
+
+        int candidateHeight = MIN_REGION;
+        while (candidateHeight < used)
+            candidateHeight *= 2;
+        long long area = static_cast<long long>(candidate) * candidateHeight;
+        long long bestArea = static_cast<long long>(width) * height;
+        bool squarer = area == bestArea && std::max(candidate, candidateHeight) < std::max(width, height);
+        if (!found || area < bestArea || squarer)
+        {
+            found = true;
+            best = placed;
+            width = candidate;
+            height = candidateHeight;
+        }
+    }
+    if (found)
+        sources = best;
+    return found;
+}
+
+void TextureAtlas::build(const char *cachePath, int maxSourceSize, bool compress)
+{
+    // Registrado no TextureManager: o atlas entra no relatório e no total de memória.
+    if (!name)
+        name = TextureManager::create(cachePath, false, true);
+
+    AssetLoader::start();
+    int maxSide = AssetLoader::textureSizeLimit();
+    std::string cache = TextureCache::pathFor(cachePath);
+    std::vector<Source> layout = sources;
+    // O atlas vive até o fim do programa (é de quem desenha); a volta pelo pump usa this.
+    AssetLoader::enqueue([this, layout, cache, maxSourceSize, maxSide, compress]() mutable {
+        // Tamanho de cada fonte pelo cabeçalho; o hash de todas identifica o cache.
+        std::vector<MappedFile> files(layout.size());
+        int channels = 3;
+        const int parameters[3] = {PADDING, LEVELS, maxSourceSize};
+        uint64_t hash = MeshCache::hash(reinterpret_cast<const char *>(parameters), sizeof(parameters));
+        for (size_t i = 0; i < layout.size(); ++i)
+        {
+            Source &source = layout[i];
+            int width = MIN_REGION, height = MIN_REGION, components = 3;
+            if (!source.path.empty())
+            {
+                if (files[i].open(source.path.c_str()) &&
+                    imageInfo(files[i].data(), files[i].size(), width, height, components))
+                {
+                    width = std::max(MIN_REGION, textureDimension(width, maxSourceSize));
+                    height = std::max(MIN_REGION, textureDimension(height, maxSourceSize));
+                    hash = MeshCache::hash(files[i].data(), files[i].size(), hash);
+                }
+                else
+                {
+                    std::cerr << "Failed to load texture: " << source.path << std::endl;
+                    files[i].close();
+                    width = height = MIN_REGION;
+                }
+            }
+            if (components == 2 || components == 4)
+                channels = 4;
+            source.width = width;
+            source.height = height;
+            hash = MeshCache::hash(reinterpret_cast<const char *>(source.color), sizeof(source.color), hash);
+        }
+
+        // Não coube no GL_MAX_TEXTURE_SIZE: reduz as imagens pela metade até caber.
+        int width = 0, height = 0;
+        while (!pack(layout, maxSide, width, height))
+        {
+            bool reduced = false;
+            for (Source &source : layout)
+                if (source.width > MIN_REGION || source.height > MIN_REGION)
+                {
+                    source.width = std::max(MIN_REGION, source.width / 2);
+                    source.height = std::max(MIN_REGION, source.height / 2);
+                    reduced = true;
+                }
+            if (!reduced)
+            {
+                std::cerr << "Atlas de texturas não cabe em " << maxSide << "x" << maxSide << std::endl;
+                AssetLoader::upload(0, [this]() { TextureManager::complete(name, nullptr); });
+                return;
+            }
+        }
+        for (const Source &source : layout)
+        {
+            const int placement[4] = {source.x, source.y, source.width, source.height};
+            hash = MeshCache::hash(reinterpret_cast<const char *>(placement), sizeof(placement), hash);
+        }
+
+        std::shared_ptr<TextureImage> image = std::make_shared<TextureImage>();
+        if (!TextureCache::load(cache.c_str(), hash, maxSide, compress, *image) || image->width != width ||
+            image->height != height)
+        {
+            image = std::make_shared<TextureImage>();
+            image->width = width;
+            image->height = height;
+            image->channels = channels;
+            image->format = channels == 4 ? GL_RGBA : GL_RGB;
+            image->storage.assign(1, std::vector<unsigned char>(static_cast<size_t>(width) * height * channels, 0));
+
+            std::vector<unsigned char> pixels;
+            for (size_t i = 0; i < layout.size(); ++i)
+            {
+                const Source &source = layout[i];
+                if (!files[i].isOpen() || !decodeImage(files[i].data(), files[i].size(), source.width, source.height,
+                                                       channels, pixels))
+                {
+                    pixels.resize(static_cast<size_t>(source.width) * source.height * channels);
+                    for (size_t p = 0; p < pixels.size(); p += channels)
+                        for (int c = 0; c < channels; ++c)
+                            pixels[p + c] = c < 3 ? source.color[c] : 255;
+                }
+                blit(pixels.data(), source.width, source.height, channels, image->storage[0].data(), width,
+                     source.x, source.y);
+            }
+
+            generateMipmaps(*image, LEVELS);
+            if (compress)
+                compressTexture(*image);
+            if (!TextureCache::write(cache.c_str(), hash, maxSide, compress, *image))
+                std::cerr << "Não foi possível gravar o cache de textura: " << cache << std::endl;
+        }
+
+        std::vector<Region> placed;
+        size_t texels = 0;
+        for (const Source &source : layout)
+        {
+            placed.push_back({static_cast<float>(source.x) / width, static_cast<float>(source.y) / height,
+                              static_cast<float>(source.x + source.width) / width,
+                              static_cast<float>(source.y + source.height) / height});
+            texels += static_cast<size_t>(source.width) * source.height;
+        }
+        AssetLoader::upload(image->bytes(), [this, image, placed, width, height, texels, cache]() {
+            TextureManager::complete(name, image.get());
+            regions = placed;
+            atlasWidth = width;
+            atlasHeight = height;
+            std::cout << "Atlas " << cache << ": " << width << "x" << height << ", " << placed.size() << " regiões, "
+                      << 100.0 * texels / (static_cast<double>(width) * height) << "% ocupado" << std::endl;
+        });
+    });
+}
@@ -0,0 +1,56 @@
+#ifndef TEXTURE_ATLAS_HPP
+#define TEXTURE_ATLAS_HPP
+
+#include <string>
+#include <vector>
+#include "glState.hpp"
+
+// Várias imagens pequenas numa textura só, para trocar de imagem sem trocar de bind.
+// As regiões são empacotadas por skyline (bottom-left) com uma borda de PADDING texels
+// copiada da beirada de cada imagem, então o filtro bilinear e os LEVELS mipmaps do atlas
+// não puxam cor da região vizinha. Monta no AssetLoader e guarda o resultado no cache de
+// texturas; até subir, o nome GL é o branco 1x1 e cada região cobre a textura inteira.
+class TextureAtlas
+{
+public:
+    static const int PADDING = 16;
+    static const int LEVELS = 5; // 1 + log2(PADDING): o último nível ainda tem 1 texel de borda
+
+    struct Region
+    {
+        float u0, v0, u1, v1;
+    };
+
+    // Antes do build; o mesmo caminho devolve o mesmo índice.
+    int add(const char *path);
+    // Região de cor sólida, para partes sem imagem.
+    int addSolid(unsigned char r, unsigned char g, unsigned char b);
+    // Cache em <cachePath>.texcache; maxSourceSize: lado máximo de cada imagem dentro do atlas.
+    // Precisa do contexto GL.
+    void build(const char *cachePath, int maxSourceSize, bool compress);
+
+    GLuint texture() const { return name; }
+    const Region &region(int index) const { return regions[index]; }
+    int width() const { return atlasWidth; }
+    int height() const { return atlasHeight; }
+
+private:
+    struct Source
+    {
+        std::string path; // vazio: cor sólida
+        unsigned char color[3];
+        int width, height;
+        int x, y; // canto da região (sem a borda)
+    };
+
+    std::vector<Source> sources;
+    std::vector<Region> regions;
+    GLuint name = 0;
+    int atlasWidth = 1;
+    int atlasHeight = 1;
+
+    // Posiciona as fontes num atlas de no máximo maxSide x maxSide; false se não couber.
+    static bool pack(std::vector<Source> &sources, int maxSide, int &width, int &height);
+};
+
+#endif
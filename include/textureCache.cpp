@@ -0,0 +1,116 @@
+#include "textureCache.hpp"
+#include "textureCompression.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+static const char TEXTURE_CACHE_MAGIC[4] = {'T', 'E', 'X', 'C'};
+
+static size_t levelBytes(int width, int height, int channels, GLenum compressedFormat)
+{
+    if (compressedFormat)
+        return TextureCompression::compressedSize(width, height, compressedFormat);
+    return static_cast<size_t>(width) * height * channels;
+}
+
+std::string TextureCache::pathFor(const char *sourcePath)
+{
+    return std::string(sourcePath) + ".texcache";
+}
+
+bool TextureCache::load(const char *cachePath, uint64_t sourceHash, int maxSize, bool compress, TextureImage &out)
+{
+    MappedFile file;
+    if (!file.open(cachePath) || file.size() < sizeof(Header))
+        return false;
+
+    Header header;
+    std::memcpy(&header, file.data(), sizeof(Header));
+    if (std::memcmp(header.magic, TEXTURE_CACHE_MAGIC, 4) != 0 || header.version != VERSION ||
+        header.sourceHash != sourceHash || header.maxSize != static_cast<uint32_t>(maxSize) ||
+        header.compress != (compress ? 1u : 0u))
+        return false;
+    if (header.width == 0 || header.height == 0 || header.levelCount == 0 ||
+        header.levelCount > static_cast<uint32_t>(MAX_LEVELS) || header.channels == 0 || header.channels > 4)
+        return false;
+
+    out.levels.clear();
+    int width = static_cast<int>(header.width), height = static_cast<int>(header.height);
+    for (uint32_t level = 0; level < header.levelCount; ++level)
+    {
+        if (header.levelOffset[level] % 16 ||
+            header.levelSize[level] != levelBytes(width, height, header.channels, header.compressedFormat) ||
+            header.levelOffset[level] + header.levelSize[level] > file.size())
+            return false;
+        out.levels.push_back({reinterpret_cast<const unsigned char *>(file.data()) + header.levelOffset[level],
+                              static_cast<size_t>(header.levelSize[level])});
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+
+    out.width = static_cast<int>(header.width);
+    out.height = static_cast<int>(header.height);
+    out.format = header.format;
+    out.channels = static_cast<int>(header.channels);
+    out.compressedFormat = header.compressedFormat;
+    out.storage.clear();
+    out.cache = std::move(file);
+    return true;
+}
+
+bool TextureCache::write(const char *cachePath, uint64_t sourceHash, int maxSize, bool compress,
+                         const TextureImage &image)
+{
+    if (image.levels.empty() || image.levels.size() > static_cast<size_t>(MAX_LEVELS))
+        return false;
+
+    Header header = {};
+    std::memcpy(header.magic, TEXTURE_CACHE_MAGIC, 4);
+    header.version = VERSION;
+    header.sourceHash = sourceHash;
+    header.maxSize = static_cast<uint32_t>(maxSize);
+    header.compress = compress ? 1 : 0;
+    header.width = static_cast<uint32_t>(image.width);
+    header.height = static_cast<uint32_t>(image.height);
+    header.format = image.format;
+    header.channels = static_cast<uint32_t>(image.channels);
+    header.compressedFormat = image.compressedFormat;
+    header.levelCount = static_cast<uint32_t>(image.levels.size());
+    uint64_t offset = (sizeof(Header) + 15) & ~uint64_t(15);
+    for (uint32_t level = 0; level < header.levelCount; ++level)
+    {
+        header.levelOffset[level] = offset;
+        header.levelSize[level] = image.levels[level].size;
+        offset = (offset + image.levels[level].size + 15) & ~uint64_t(15);
+    }
+
+    // Temporário com o id do thread: a mesma imagem pode estar sendo gravada por dois
+    // pedidos com parâmetros de filtro diferentes.
+    std::string temporary = std::string(cachePath) + ".tmp" +
+                            std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out)
+            return false;
+        static const char padding[16] = {0};
+        out.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+        uint64_t written = sizeof(Header);
+        for (uint32_t level = 0; level < header.levelCount; ++level)
+        {
+            out.write(padding, header.levelOffset[level] - written);
+            out.write(reinterpret_cast<const char *>(image.levels[level].data), image.levels[level].size);
+            written = header.levelOffset[level] + image.levels[level].size;
+        }
+        if (!out)
+        {
+            out.close();
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+    std::remove(cachePath);
+    return std::rename(temporary.c_str(), cachePath) == 0;
+}
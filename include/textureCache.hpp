@@ -0,0 +1,44 @@
+#ifndef TEXTURE_CACHE_HPP
+#define TEXTURE_CACHE_HPP
+
+#include <cstdint>
+#include <string>
+#include "textureLoader.hpp"
+
+// Cache binário das texturas, gravado ao lado da imagem (<arquivo>.texcache), com a
+// cadeia de mipmaps inteira já redimensionada (e comprimida, se foi pedido).
+// Layout: Header e os níveis em sequência, cada um alinhado em 16 bytes. O arquivo é
+// mapeado e o upload lê direto do mapeamento; o hash da imagem de origem e as opções de
+// carga vão no header: mudou qualquer um, o cache é ignorado e refeito.
+class TextureCache
+{
+public:
+    static const uint32_t VERSION = 1;
+    static const int MAX_LEVELS = 16;
+
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+        uint64_t sourceHash;
+        uint32_t maxSize;
+        uint32_t compress;
+        uint32_t width;
+        uint32_t height;
+        uint32_t format;
+        uint32_t channels;
+        uint32_t compressedFormat;
+        uint32_t levelCount;
+        uint64_t levelOffset[MAX_LEVELS];
+        uint64_t levelSize[MAX_LEVELS];
+    };
+
+    static std::string pathFor(const char *sourcePath);
+
+    // false se não existe, está corrompido, é de outra versão, fonte ou opções.
+    static bool load(const char *cachePath, uint64_t sourceHash, int maxSize, bool compress, TextureImage &out);
+    static bool write(const char *cachePath, uint64_t sourceHash, int maxSize, bool compress,
+                      const TextureImage &image);
+};
+
+#endif
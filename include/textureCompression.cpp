@@ -0,0 +1,241 @@
+#include "textureCompression.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace
+{
+    uint16_t to565(const int color[3])
+    {
+        int r = (color[0] * 31 + 127) / 255;
+        int g = (color[1] * 63 + 127) / 255;
+        int b = (color[2] * 31 + 127) / 255;
+        return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    void from565(uint16_t packed, int color[3])
+    {
+        int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+        color[0] = (r << 3) | (r >> 2);
+        color[1] = (g << 2) | (g >> 4);
+        color[2] = (b << 3) | (b >> 2);
+    }
+
+    // Índice da cor mais próxima da paleta de 4 cores para cada texel; devolve o erro quadrático.
+    int chooseIndices(const unsigned char block[16][4], uint16_t color0, uint16_t color1, uint32_t &indices)
+    {
+        indices = 0;
+        int palette[4][3];
+        from565(color0, palette[0]);
+        from565(color1, palette[1]);
+        for (int c = 0; c < 3; ++c)
+        {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        // color0 == color1 cai no modo de 3 cores: só o índice 0 é seguro.
+        int candidates = color0 == color1 ? 1 : 4;
+        int error = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            int best = 0, bestDistance = 1 << 30;
+            for (int p = 0; p < candidates; ++p)
+            {
+                int dr = block[i][0] - palette[p][0], dg = block[i][1] - palette[p][1],
+                    db = block[i][2] - palette[p][2];
+                int distance = dr * dr + dg * dg + db * db;
+                if (distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= static_cast<uint32_t>(best) << (2 * i);
+            error += bestDistance;
+        }
+        return error;
+    }
+
+    // Bloco de cor (8 bytes) no modo de 4 cores (color0 > color1), menos no bloco de cor única.
+    void encodeColorBlock(const unsigned char block[16][4], unsigned char *out)
+    {
+        float mean[3] = {0.0f, 0.0f, 0.0f};
+        for (int i = 0; i < 16; ++i)
+            for (int c = 0; c < 3; ++c)
+                mean[c] += block[i][c] / 16.0f;
+
+        float cov[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f}; // rr rg rb gg gb bb
+        for (int i = 0; i < 16; ++i)
+        {
+            float r = block[i][0] - mean[0], g = block[i][1] - mean[1], b = block[i][2] - mean[2];
+            cov[0] += r * r;
+            cov[1] += r * g;
+            cov[2] += r * b;
+            cov[3] += g * g;
+            cov[4] += g * b;
+            cov[5] += b * b;
+        }
+
+        // Eixo principal por iteração de potência.
+        float axis[3] = {1.0f, 1.0f, 1.0f};
+        for (int iteration = 0; iteration < 4; ++iteration)
+        {
+            float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+            float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+            float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+            float length = std::max(std::max(std::abs(x), std::abs(y)), std::abs(z));
+            if (length < 1e-6f)
+                break;
+            axis[0] = x / length;
+            axis[1] = y / length;
+            axis[2] = z / length;
+        }
+
+        int lowest = 0, highest = 0;
+        float minDot = 1e30f, maxDot = -1e30f;
+        for (int i = 0; i < 16; ++i)
+        {
+            float dot = block[i][0] * axis[0] + block[i][1] * axis[1] + block[i][2] * axis[2];
+            if (dot < minDot)
+            {
+                minDot = dot;
+                lowest = i;
+            }
+            if (dot > maxDot)
+            {
+                maxDot = dot;
+                highest = i;
+            }
+        }
+
+        int endpoint0[3] = {block[highest][0], block[highest][1], block[highest][2]};
+        int endpoint1[3] = {block[lowest][0], block[lowest][1], block[lowest][2]};
+        uint16_t color0 = to565(endpoint0), color1 = to565(endpoint1);
+        if (color0 < color1)
+            std::swap(color0, color1);
+        uint32_t indices = 0;
+        int error = chooseIndices(block, color0, color1, indices);
+
+        // Um passo de mínimos quadrados nos extremos com os índices escolhidos.
+        if (color0 != color1)
+        {
+            static const float weights[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+            float aa = 0.0f, ab = 0.0f, bb = 0.0f, ax[3] = {0.0f, 0.0f, 0.0f}, bx[3] = {0.0f, 0.0f, 0.0f};
+            for (int i = 0; i < 16; ++i)
+            {
+                float a = weights[(indices >> (2 * i)) & 3], b = 1.0f - a;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                for (int c = 0; c < 3; ++c)
+                {
+                    ax[c] += a * block[i][c];
+                    bx[c] += b * block[i][c];
+                }
+            }
+            float determinant = aa * bb - ab * ab;
+            if (std::abs(determinant) > 1e-6f)
+            {
+                int refined0[3], refined1[3];
+                for (int c = 0; c < 3; ++c)
+                {
+                    float a = (ax[c] * bb - bx[c] * ab) / determinant;
+                    float b = (bx[c] * aa - ax[c] * ab) / determinant;
+                    refined0[c] = std::min(255, std::max(0, static_cast<int>(a + 0.5f)));
+                    refined1[c] = std::min(255, std::max(0, static_cast<int>(b + 0.5f)));
+                }
+                uint16_t refinedColor0 = to565(refined0), refinedColor1 = to565(refined1);
+                if (refinedColor0 < refinedColor1)
+                    std::swap(refinedColor0, refinedColor1);
+                uint32_t refinedIndices = 0;
+                int refinedError = chooseIndices(block, refinedColor0, refinedColor1, refinedIndices);
+                if (refinedError < error)
+                {
+                    color0 = refinedColor0;
+                    color1 = refinedColor1;
+                    indices = refinedIndices;
+                }
+            }
+        }
+
+        out[0] = color0 & 0xff;
+        out[1] = color0 >> 8;
+        out[2] = color1 & 0xff;
+        out[3] = color1 >> 8;
+        for (int k = 0; k < 4; ++k)
+            out[4 + k] = (indices >> (8 * k)) & 0xff;
+    }
+
+    // Bloco de alfa do BC3 (8 bytes): dois extremos e 6 valores interpolados, 3 bits por texel.
+    void encodeAlphaBlock(const unsigned char block[16][4], unsigned char *out)
+    {
+        int alpha0 = 0, alpha1 = 255;
+        for (int i = 0; i < 16; ++i)
+        {
+            alpha0 = std::max(alpha0, static_cast<int>(block[i][3]));
+            alpha1 = std::min(alpha1, static_cast<int>(block[i][3]));
+        }
+
+        uint64_t indices = 0;
+        if (alpha0 != alpha1)
+        {
+            for (int i = 0; i < 16; ++i)
+            {
+                // Degrau de 0 (alpha1) a 7 (alpha0); o código do degrau d é 1, 8 - d ou 0.
+                int step = ((block[i][3] - alpha1) * 14 + (alpha0 - alpha1)) / (2 * (alpha0 - alpha1));
+                uint64_t code = step == 0 ? 1 : step == 7 ? 0 : 8 - step;
+                indices |= code << (3 * i);
+            }
+        }
+
+        out[0] = static_cast<unsigned char>(alpha0);
+        out[1] = static_cast<unsigned char>(alpha1);
+        for (int k = 0; k < 6; ++k)
+            out[2 + k] = (indices >> (8 * k)) & 0xff;
+    }
+}
+
+GLenum TextureCompression::formatFor(int channels)
+{
+    if (channels == 3)
+        return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    if (channels == 4)
+        return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    return 0;
+}
+
+size_t TextureCompression::compressedSize(int width, int height, GLenum format)
+{
+    size_t blocks = static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4);
+    return blocks * (format == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT ? 16 : 8);
+}
+
+void TextureCompression::compress(const unsigned char *pixels, int width, int height, int channels,
+                                  unsigned char *out)
+{
+    bool alpha = channels == 4;
+    for (int by = 0; by < height; by += 4)
+        for (int bx = 0; bx < width; bx += 4)
+        {
+            // Mips menores que 4x4 repetem a borda.
+            unsigned char block[16][4];
+            for (int y = 0; y < 4; ++y)
+                for (int x = 0; x < 4; ++x)
+                {
+                    const unsigned char *p = pixels + (static_cast<size_t>(std::min(by + y, height - 1)) * width +
+                                                       std::min(bx + x, width - 1)) * channels;
+                    unsigned char *q = block[y * 4 + x];
+                    q[0] = p[0];
+                    q[1] = p[1];
+                    q[2] = p[2];
+                    q[3] = alpha ? p[3] : 255;
+                }
+            if (alpha)
+            {
+                encodeAlphaBlock(block, out);
+                out += 8;
+            }
+            encodeColorBlock(block, out);
+            out += 8;
+        }
+}
@@ -0,0 +1,22 @@
+#ifndef TEXTURE_COMPRESSION_HPP
+#define TEXTURE_COMPRESSION_HPP
+
+#include <cstddef>
+#include "glExt.hpp"
+
+// Compressão em blocos 4x4 feita na CPU, uma vez por textura (o resultado vai para o
+// cache em disco): BC1/DXT1 para RGB (8 bytes por bloco, 1/8 do RGBA) e BC3/DXT5 para
+// RGBA (16 bytes). Extremos pelo eixo principal das cores do bloco, como o stb_dxt.
+// Texturas de um canal ficam sem compressão.
+class TextureCompression
+{
+public:
+    // Formato GL para `channels` canais, ou 0 quando não comprime.
+    static GLenum formatFor(int channels);
+    static size_t compressedSize(int width, int height, GLenum format);
+
+    // pixels: width x height com `channels` canais; out: compressedSize(...) bytes.
+    static void compress(const unsigned char *pixels, int width, int height, int channels, unsigned char *out);
+};
+
+#endif
@@ -1,39 +1,350 @@
 #include "textureLoader.hpp"
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb/stb_image.h"
-#include <GL/glu.h>
+#include "glState.hpp"
+#include "glExt.hpp"
+#include "meshCache.hpp"
+#include "textureCache.hpp"
+#include "textureCompression.hpp"
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <string>
 
-unsigned int loadTexture(const char* filename, bool repeatTexture = true, bool linearFiltering = true) {
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TEXTURE_SSE 1
+#endif
+
+namespace
+{
+    // Mesma conta do GLU: a potência de 2 abaixo, ou a de cima quando os dois bits mais
+    // altos estão ligados (860 -> 1024, 645 -> 512).
+    int nearestPower(int value)
+    {
+        int power = 1;
+        while (value > 1)
+        {
+            if (value == 3)
+                return power * 4;
+            value >>= 1;
+            power *= 2;
+        }
+        return power;
+    }
+
+    // Janela de cada amostra de saída na reamostragem por área: primeira amostra de origem e pesos.
+    struct Taps
+    {
+        int first;
+        std::vector<float> weights;
+    };
+
+    std::vector<Taps> areaTaps(int size, int newSize)
+    {
+        std::vector<Taps> taps(newSize);
+        float scale = static_cast<float>(size) / newSize;
+        for (int i = 0; i < newSize; ++i)
+        {
+            float x0 = i * scale, x1 = (i + 1) * scale;
+            taps[i].first = static_cast<int>(x0);
+            for (int s = taps[i].first; s < size && s < x1; ++s)
+                taps[i].weights.push_back((std::min(x1, s + 1.0f) - std::max(x0, static_cast<float>(s))) / scale);
+        }
+        return taps;
+    }
+
+    // Reamostra por área (caixa) em duas passadas; serve para reduzir e para ampliar.
+    void resample(const unsigned char *src, int width, int height, int channels,
+                  unsigned char *dst, int newWidth, int newHeight)
+    {
+        size_t rowLength = static_cast<size_t>(newWidth) * channels;
+        std::vector<Taps> tapsX = areaTaps(width, newWidth);
+        std::vector<float> rows(static_cast<size_t>(height) * rowLength, 0.0f);
+        for (int y = 0; y < height; ++y)
+        {
+            const unsigned char *in = src + static_cast<size_t>(y) * width * channels;
+            float *out = &rows[y * rowLength];
+            for (int x = 0; x < newWidth; ++x)
+            {
+                const Taps &taps = tapsX[x];
+                for (size_t t = 0; t < taps.weights.size(); ++t)
+                {
+                    const unsigned char *p = in + static_cast<size_t>(taps.first + t) * channels;
+                    for (int c = 0; c < channels; ++c)
+                        out[x * channels + c] += taps.weights[t] * p[c];
+                }
+            }
+        }
+
+        std::vector<Taps> tapsY = areaTaps(height, newHeight);
+        std::vector<float> sum(rowLength);
+        for (int y = 0; y < newHeight; ++y)
+        {
+            std::fill(sum.begin(), sum.end(), 0.0f);
+            for (size_t t = 0; t < tapsY[y].weights.size(); ++t)
+            {
+                const float *row = &rows[(tapsY[y].first + t) * rowLength];
+                float weight = tapsY[y].weights[t];
+                size_t i = 0;
+#ifdef TEXTURE_SSE
+                __m128 w = _mm_set1_ps(weight);
+                for (; i + 4 <= rowLength; i += 4)
+                    _mm_storeu_ps(&sum[i], _mm_add_ps(_mm_loadu_ps(&sum[i]), _mm_mul_ps(w, _mm_loadu_ps(row + i))));
+#endif
+                for (; i < rowLength; ++i)
+                    sum[i] += weight * row[i];
+            }
+            unsigned char *out = dst + static_cast<size_t>(y) * rowLength;
+            for (size_t i = 0; i < rowLength; ++i)
+                out[i] = static_cast<unsigned char>(std::min(255.0f, sum[i] + 0.5f));
+        }
+    }
+
+    // Próximo nível: média de 2x2 (ou de 2 quando um dos lados já é 1).
+    // O caso comum soma as duas linhas em 16 bits com SSE2 e junta os pares de texels depois.
+    void halve(const unsigned char *src, int width, int height, int channels, std::vector<unsigned char> &out)
+    {
+        int newWidth = std::max(1, width / 2), newHeight = std::max(1, height / 2);
+        out.resize(static_cast<size_t>(newWidth) * newHeight * channels);
+        if (width > 1 && height > 1)
+        {
+            size_t rowLength = static_cast<size_t>(width) * channels;
+            std::vector<uint16_t> sums(rowLength);
+            for (int y = 0; y < newHeight; ++y)
+            {
+                const unsigned char *a = src + static_cast<size_t>(2 * y) * rowLength;
+                const unsigned char *b = a + rowLength;
+                unsigned char *q = &out[static_cast<size_t>(y) * newWidth * channels];
+                size_t i = 0;
+                int x = 0;
+#ifdef TEXTURE_SSE
+                const __m128i zero = _mm_setzero_si128();
+                for (; i + 16 <= rowLength; i += 16)
+                {
+                    __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+                    __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(&sums[i]),
+                                     _mm_add_epi16(_mm_unpacklo_epi8(va, zero), _mm_unpacklo_epi8(vb, zero)));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(&sums[i + 8]),
+                                     _mm_add_epi16(_mm_unpackhi_epi8(va, zero), _mm_unpackhi_epi8(vb, zero)));
+                }
+#endif
+                for (; i < rowLength; ++i)
+                    sums[i] = static_cast<uint16_t>(a[i] + b[i]);
+#ifdef TEXTURE_SSE
+                if (channels == 4)
+                {
+                    // Dois texels de saída por vez: cada registrador tem um par de texels de entrada.
+                    const __m128i two = _mm_set1_epi16(2);
+                    for (; x + 2 <= newWidth; x += 2)
+                    {
+                        __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&sums[x * 8]));
+                        __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&sums[x * 8 + 8]));
+                        __m128i pairs = _mm_unpacklo_epi64(_mm_add_epi16(v0, _mm_srli_si128(v0, 8)),
+                                                           _mm_add_epi16(v1, _mm_srli_si128(v1, 8)));
+                        __m128i average = _mm_srli_epi16(_mm_add_epi16(pairs, two), 2);
+                        _mm_storel_epi64(reinterpret_cast<__m128i *>(q + x * 4), _mm_packus_epi16(average, zero));
+                    }
+                }
+#endif
+                for (; x < newWidth; ++x)
+                    for (int c = 0; c < channels; ++c)
+                        q[x * channels + c] = static_cast<unsigned char>(
+                            (sums[2 * x * channels + c] + sums[(2 * x + 1) * channels + c] + 2) / 4);
+            }
+            return;
+        }
+
+        int stepX = width > 1 ? channels : 0;
+        size_t stepY = height > 1 ? static_cast<size_t>(width) * channels : 0;
+        for (int y = 0; y < newHeight; ++y)
+            for (int x = 0; x < newWidth; ++x)
+            {
+                const unsigned char *p = src + (static_cast<size_t>(y) * (height > 1 ? 2 : 1) * width +
+                                                 static_cast<size_t>(x) * (width > 1 ? 2 : 1)) * channels;
+                unsigned char *q = &out[(static_cast<size_t>(y) * newWidth + x) * channels];
+                for (int c = 0; c < channels; ++c)
+                    q[c] = static_cast<unsigned char>(
+                        (p[c] + p[c + stepX] + p[c + stepY] + p[c + stepX + stepY] + 2) / 4);
+            }
+    }
+}
+
+size_t TextureImage::bytes() const
+{
+    size_t total = 0;
+    for (const TextureLevel &level : levels)
+        total += level.size;
+    return total;
+}
+
+int textureDimension(int size, int maxSize)
+{
+    return std::min(nearestPower(size), maxSize);
+}
+
+static GLenum formatForChannels(int channels)
+{
+    if (channels == 1)
+        return GL_RED;
+    if (channels == 4)
+        return GL_RGBA;
+    return GL_RGB;
+}
+
+bool imageInfo(const char *data, size_t size, int &width, int &height, int &channels)
+{
+    return stbi_info_from_memory(reinterpret_cast<const stbi_uc *>(data), static_cast<int>(size), &width, &height,
+                                 &channels) != 0;
+}
+
+bool decodeImage(const char *data, size_t size, int width, int height, int channels, std::vector<unsigned char> &out)
+{
+    int sourceWidth, sourceHeight, sourceChannels;
+    unsigned char *pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc *>(data), static_cast<int>(size),
+                                                  &sourceWidth, &sourceHeight, &sourceChannels, channels);
+    if (!pixels)
+        return false;
+    out.resize(static_cast<size_t>(width) * height * channels);
+    if (sourceWidth == width && sourceHeight == height)
+        std::copy(pixels, pixels + out.size(), out.begin());
+    else
+        resample(pixels, sourceWidth, sourceHeight, channels, out.data(), width, height);
+    stbi_image_free(pixels);
+    return true;
+}
+
+void generateMipmaps(TextureImage &image, int levelCount)
+{
+    std::vector<std::vector<unsigned char>> &storage = image.storage;
+    storage.resize(1);
+    for (int w = image.width, h = image.height; w > 1 || h > 1; w = std::max(1, w / 2), h = std::max(1, h / 2))
+    {
+        if (levelCount > 0 && static_cast<int>(storage.size()) >= levelCount)
+            break;
+        std::vector<unsigned char> next;
+        halve(storage.back().data(), w, h, image.channels, next);
+        storage.push_back(std::move(next));
+    }
+
+    image.compressedFormat = 0;
+    image.cache.close();
+    image.levels.clear();
+    for (const std::vector<unsigned char> &level : storage)
+        image.levels.push_back({level.data(), level.size()});
+}
+
+void compressTexture(TextureImage &image)
+{
+    image.compressedFormat = TextureCompression::formatFor(image.channels);
+    if (!image.compressedFormat)
+        return;
+    int w = image.width, h = image.height;
+    image.levels.clear();
+    for (std::vector<unsigned char> &level : image.storage)
+    {
+        std::vector<unsigned char> blocks(TextureCompression::compressedSize(w, h, image.compressedFormat));
+        TextureCompression::compress(level.data(), w, h, image.channels, blocks.data());
+        level.swap(blocks);
+        image.levels.push_back({level.data(), level.size()});
+        w = std::max(1, w / 2);
+        h = std::max(1, h / 2);
+    }
+}
+
+bool decodeTexture(const char *filename, int maxSize, bool compress, TextureImage &out)
+{
+    MappedFile source;
+    if (!source.open(filename))
+        return false;
+    uint64_t sourceHash = MeshCache::hash(source.data(), source.size());
+    std::string cachePath = TextureCache::pathFor(filename);
+    if (TextureCache::load(cachePath.c_str(), sourceHash, maxSize, compress, out))
+        return true;
+
+    int width, height, nrChannels;
+    if (!imageInfo(source.data(), source.size(), width, height, nrChannels))
+        return false;
+    out.channels = nrChannels;
+    out.format = formatForChannels(nrChannels);
+    out.width = textureDimension(width, maxSize);
+    out.height = textureDimension(height, maxSize);
+    out.storage.resize(1);
+    if (!decodeImage(source.data(), source.size(), out.width, out.height, nrChannels, out.storage[0]))
+        return false;
+
+    generateMipmaps(out);
+    if (compress)
+        compressTexture(out);
+
+    if (!TextureCache::write(cachePath.c_str(), sourceHash, maxSize, compress, out))
+        std::cerr << "Não foi possível gravar o cache de textura: " << cachePath << std::endl;
+    return true;
+}
+
+void uploadPlaceholder(unsigned int textureID, bool repeatTexture)
+{
+    // Branco 1x1 sem mipmap (com GL_LINEAR ela já é completa): o material aparece sem
+    // textura até a imagem chegar.
+    const GLubyte white[4] = {255, 255, 255, 255};
+    GLint wrapMode = repeatTexture ? GL_REPEAT : GL_CLAMP;
+    GLState::bindTexture(textureID);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapMode);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapMode);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+void uploadTexture(unsigned int textureID, const TextureImage &image, bool repeatTexture, bool linearFiltering)
+{
+    GLState::bindTexture(textureID);
+
+    // Linhas RGB de mips pequenos não fecham múltiplo de 4.
+    GLint alignment;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    int width = image.width, height = image.height;
+    for (size_t level = 0; level < image.levels.size(); ++level)
+    {
+        if (image.compressedFormat)
+            GLExt::CompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), image.compressedFormat, width,
+                                        height, 0, static_cast<GLsizei>(image.levels[level].size),
+                                        image.levels[level].data);
+        else
+            glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), image.format, width, height, 0, image.format,
+                         GL_UNSIGNED_BYTE, image.levels[level].data);
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+    // Cadeias curtas (atlas) param antes do 1x1.
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.levels.size()) - 1);
+
+    GLint wrapMode = repeatTexture ? GL_REPEAT : GL_CLAMP;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapMode);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapMode);
+
+    GLint minFilter = linearFiltering ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST;
+    GLint magFilter = linearFiltering ? GL_LINEAR : GL_NEAREST;
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
+}
+
+unsigned int loadTexture(const char* filename, bool repeatTexture, bool linearFiltering) {
     unsigned int textureID;
     glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    GLState::bindTexture(textureID);
 
-    int width, height, nrChannels;
-    unsigned char* data = stbi_load(filename, &width, &height, &nrChannels, 0);
-    if (data) {
-        GLenum format = GL_RGB;
-        if (nrChannels == 1)
-            format = GL_RED;
-        else if (nrChannels == 3)
-            format = GL_RGB;
-        else if (nrChannels == 4)
-            format = GL_RGBA;
-
-        gluBuild2DMipmaps(GL_TEXTURE_2D, format, width, height, format, GL_UNSIGNED_BYTE, data);
-
-        GLint wrapMode = repeatTexture ? GL_REPEAT : GL_CLAMP;
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapMode);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapMode);
-
-        GLint minFilter = linearFiltering ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST;
-        GLint magFilter = linearFiltering ? GL_LINEAR : GL_NEAREST;
-        
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
+    GLint maxSize;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    TextureImage image;
+    if (decodeTexture(filename, maxSize, GLExt::loadTextureCompression(), image)) {
+        uploadTexture(textureID, image, repeatTexture, linearFiltering);
     } else {
         std::cerr << "Failed to load texture: " << filename << std::endl;
     }
-    stbi_image_free(data);
     return textureID;
 }
@@ -1,6 +1,54 @@
 #ifndef TEXTURELOADER_HPP
 #define TEXTURELOADER_HPP
 
-unsigned int loadTexture(const char* filename, bool repeatTexture, bool linearFiltering) ;
+#include <cstddef>
+#include <vector>
+#include "glState.hpp"
+#include "mappedFile.hpp"
+
+struct TextureLevel
+{
+    const unsigned char *data;
+    size_t size;
+};
+
+// Imagem decodificada com a cadeia de mipmaps já pronta. Não usa o contexto GL, então
+// roda em qualquer thread; só o uploadTexture precisa do thread principal.
+// Os níveis apontam para `storage` (decodificada agora) ou para o cache mapeado.
+struct TextureImage
+{
+    int width = 0;
+    int height = 0;
+    GLenum format = GL_RGB;
+    int channels = 3;
+    GLenum compressedFormat = 0; // BC1/BC3, ou 0 quando os níveis são pixels
+    std::vector<TextureLevel> levels; // nível 0 primeiro
+    std::vector<std::vector<unsigned char>> storage;
+    MappedFile cache;
+
+    size_t bytes() const;
+};
+
+// Lê o cache ao lado da imagem (<arquivo>.texcache) ou decodifica e grava o cache: leva
+// para potência de 2 (mesma regra do gluBuild2DMipmaps, limitada a maxSize), monta os
+// mipmaps por média 2x2 e, com compress, comprime em BC1/BC3.
+bool decodeTexture(const char *filename, int maxSize, bool compress, TextureImage &out);
+void uploadTexture(unsigned int textureID, const TextureImage &image, bool repeatTexture, bool linearFiltering);
+// Branco 1x1 no lugar da textura enquanto ela carrega.
+void uploadPlaceholder(unsigned int textureID, bool repeatTexture);
+
+// Partes do decodeTexture, para quem monta a imagem de outro jeito (ex.: atlas).
+// Lado que a imagem terá na GPU: potência de 2 pela regra do GLU, limitada a maxSize.
+int textureDimension(int size, int maxSize);
+// Tamanho e canais pelo cabeçalho, sem decodificar.
+bool imageInfo(const char *data, size_t size, int &width, int &height, int &channels);
+// Decodifica os bytes de um PNG/JPG com `channels` canais e reamostra para width x height.
+bool decodeImage(const char *data, size_t size, int width, int height, int channels, std::vector<unsigned char> &out);
+// A partir de storage[0] (width x height), até levelCount níveis (0: cadeia inteira).
+void generateMipmaps(TextureImage &image, int levelCount = 0);
+// BC1/BC3 nos níveis em storage, quando o número de canais permite.
+void compressTexture(TextureImage &image);
+
+unsigned int loadTexture(const char* filename, bool repeatTexture = true, bool linearFiltering = true);
 
 #endif
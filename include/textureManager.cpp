@@ -0,0 +1,174 @@
+#include "textureManager.hpp"
+#include "assetLoader.hpp"
+#include "glExt.hpp"
+#include "textureLoader.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+
+std::map<std::string, GLuint> TextureManager::byKey;
+std::map<GLuint, TextureManager::Entry> TextureManager::entries;
+size_t TextureManager::requests = 0;
+size_t TextureManager::pending = 0;
+unsigned int TextureManager::generations = 0;
+bool TextureManager::compression = true;
+
+// "./src/a.png", "src\\a.png" e "src/a.png" são o mesmo arquivo.
+std::string TextureManager::keyFor(const char *path, bool repeatTexture, bool linearFiltering)
+{
+    std::string key(path);
+    for (char &c : key)
+        if (c == '\\')
+            c = '/';
+    while (key.compare(0, 2, "./") == 0)
+        key.erase(0, 2);
+    key += repeatTexture ? "|repeat" : "|clamp";
+    key += linearFiltering ? "|linear" : "|nearest";
+    return key;
+}
+
+GLuint TextureManager::acquire(const char *path, bool repeatTexture, bool linearFiltering)
+{
+    ++requests;
+    std::string key = keyFor(path, repeatTexture, linearFiltering);
+    auto found = byKey.find(key);
+    if (found != byKey.end())
+    {
+        ++entries[found->second].references;
+        return found->second;
+    }
+
+    unsigned int generation;
+    GLuint texture = create(key, path, repeatTexture, linearFiltering, generation);
+    byKey[key] = texture;
+
+    AssetLoader::start();
+    std::string file(path);
+    int maxSize = AssetLoader::textureSizeLimit();
+    bool compress = usesCompression();
+    AssetLoader::enqueue([texture, generation, file, maxSize, compress]() {
+        std::shared_ptr<TextureImage> image = std::make_shared<TextureImage>();
+        if (!decodeTexture(file.c_str(), maxSize, compress, *image))
+        {
+            std::cerr << "Failed to load texture: " << file << std::endl;
+            AssetLoader::upload(0, [texture, generation]() { finish(texture, generation, nullptr); });
+            return;
+        }
+        AssetLoader::upload(image->bytes(),
+                            [texture, generation, image]() { finish(texture, generation, image.get()); });
+    });
+    return texture;
+}
+
+GLuint TextureManager::create(const std::string &key, const char *path, bool repeatTexture, bool linearFiltering,
+                              unsigned int &generation)
+{
+    GLuint texture;
+    glGenTextures(1, &texture);
+    uploadPlaceholder(texture, repeatTexture);
+
+    // O nome GL pode voltar para uma entrada nova depois de um release com a carga ainda
+    // no pool: a geração diz a qual pedido o resultado pertence.
+    generation = ++generations;
+    entries[texture] = {key, path, repeatTexture, linearFiltering, generation, 1, false, 1, 1, 1, 0, 4};
+    ++pending;
+    return texture;
+}
+
+GLuint TextureManager::create(const char *name, bool repeatTexture, bool linearFiltering)
+{
+    unsigned int generation;
+    return create(std::string(), name, repeatTexture, linearFiltering, generation);
+}
+
+void TextureManager::complete(GLuint texture, const TextureImage *image)
+{
+    auto entry = entries.find(texture);
+    if (entry != entries.end())
+        finish(texture, entry->second.generation, image);
+}
+
+void TextureManager::finish(GLuint texture, unsigned int generation, const TextureImage *image)
+{
+    // Liberada (e o nome talvez reaproveitado, até com a mesma chave) antes de a imagem chegar.
+    auto entry = entries.find(texture);
+    if (entry == entries.end() || entry->second.generation != generation || entry->second.loaded)
+        return;
+
+    Entry &info = entry->second;
+    info.loaded = true;
+    // Sem imagem fica o branco; só sai da conta de pendentes.
+    if (image)
+    {
+        uploadTexture(texture, *image, info.repeat, info.linear);
+
+        int bytesPerTexel = image->channels == 1 ? 1 : 4;
+        info.width = image->width;
+        info.height = image->height;
+        info.levels = static_cast<int>(image->levels.size());
+        info.compressedFormat = image->compressedFormat;
+        info.bytes = image->compressedFormat ? image->bytes() : 0;
+        for (int level = 0, w = image->width, h = image->height; !info.compressedFormat && level < info.levels;
+             ++level, w = std::max(1, w / 2), h = std::max(1, h / 2))
+            info.bytes += static_cast<size_t>(w) * h * bytesPerTexel;
+    }
+    if (--pending == 0)
+        report();
+}
+
+bool TextureManager::usesCompression()
+{
+    return compression && GLExt::loadTextureCompression();
+}
+
+void TextureManager::release(GLuint texture)
+{
+    auto entry = entries.find(texture);
+    if (entry == entries.end() || --entry->second.references > 0)
+        return;
+    if (!entry->second.loaded)
+        --pending;
+    byKey.erase(entry->second.key);
+    entries.erase(entry);
+    if (GLState::boundTexture() == texture)
+        GLState::bindTexture(0);
+    glDeleteTextures(1, &texture);
+}
+
+size_t TextureManager::textureBytes(GLuint texture)
+{
+    auto entry = entries.find(texture);
+    return entry == entries.end() ? 0 : entry->second.bytes;
+}
+
+size_t TextureManager::totalBytes()
+{
+    size_t total = 0;
+    for (const auto &entry : entries)
+        total += entry.second.bytes;
+    return total;
+}
+
+void TextureManager::report()
+{
+    size_t references = 0, shared = 0;
+    std::cout << "Texturas na GPU:" << std::endl;
+    for (const auto &entry : entries)
+    {
+        const Entry &info = entry.second;
+        references += info.references;
+        shared += info.bytes * (info.references - 1);
+        const char *format = info.compressedFormat == GL_COMPRESSED_RGB_S3TC_DXT1_EXT    ? "BC1"
+                             : info.compressedFormat == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT ? "BC3"
+                                                                                         : "-";
+        char line[256];
+        std::snprintf(line, sizeof(line), "  %-28s %4dx%-4d %2d níveis %-3s %8.1f KB  x%d%s%s", info.path.c_str(),
+                      info.width, info.height, info.levels, format, info.bytes / 1024.0, info.references,
+                      info.repeat ? "" : " clamp", info.loaded ? "" : " (carregando)");
+        std::cout << line << std::endl;
+    }
+    std::cout << "  total: " << entries.size() << " texturas, " << totalBytes() / (1024.0 * 1024.0) << " MB; "
+              << requests << " pedidos, " << references << " referências vivas, "
+              << shared / (1024.0 * 1024.0) << " MB poupados pelo compartilhamento" << std::endl;
+}
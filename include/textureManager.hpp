@@ -0,0 +1,68 @@
+#ifndef TEXTURE_MANAGER_HPP
+#define TEXTURE_MANAGER_HPP
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include "glState.hpp"
+
+struct TextureImage;
+
+// Texturas compartilhadas por caminho + parâmetros de carga (repeat, filtro linear).
+// O mesmo pedido devolve o mesmo nome GL e só soma uma referência; a textura é apagada
+// quando a última referência sai. A carga é assíncrona (AssetLoader): o nome já vale na
+// hora, com um branco 1x1 até a imagem subir. Com suporte do driver as texturas sobem
+// comprimidas (BC1/BC3), lidas do cache em disco a partir da segunda execução.
+class TextureManager
+{
+public:
+    static GLuint acquire(const char *path, bool repeatTexture = true, bool linearFiltering = true);
+    static void release(GLuint texture);
+    // Textura montada por outro módulo (ex.: atlas), sem a busca por caminho: entra na conta
+    // de memória e no relatório com `name`. Já vale com o branco 1x1; release apaga.
+    static GLuint create(const char *name, bool repeatTexture, bool linearFiltering);
+    // Thread principal: sobe a imagem da textura do create (nullptr: falhou, fica o branco).
+    static void complete(GLuint texture, const TextureImage *image);
+    // Liga/desliga a compressão das próximas cargas (ligada por padrão; só vale se o driver suporta).
+    static void setCompression(bool enabled) { compression = enabled; }
+    // Ligada e suportada pelo driver (precisa do contexto GL).
+    static bool usesCompression();
+
+    // Estimativa do que o driver guarda, com mipmaps (RGB sem compressão conta como 4 bytes por texel).
+    static size_t textureBytes(GLuint texture);
+    static size_t totalBytes();
+    // Uma linha por textura (referências, tamanho, memória) e o total no console; também
+    // sai sozinho quando a última textura pendente termina de subir.
+    static void report();
+
+private:
+    struct Entry
+    {
+        std::string key;
+        std::string path;
+        bool repeat;
+        bool linear;
+        unsigned int generation; // muda a cada acquire que cria a entrada
+        int references;
+        bool loaded;
+        int width;
+        int height;
+        int levels;
+        GLenum compressedFormat;
+        size_t bytes;
+    };
+
+    static std::map<std::string, GLuint> byKey;
+    static std::map<GLuint, Entry> entries;
+    static size_t requests;
+    static size_t pending;
+    static unsigned int generations;
+    static bool compression;
+
+    static std::string keyFor(const char *path, bool repeatTexture, bool linearFiltering);
+    static GLuint create(const std::string &key, const char *path, bool repeatTexture, bool linearFiltering,
+                         unsigned int &generation);
+    static void finish(GLuint texture, unsigned int generation, const TextureImage *image);
+};
+
+#endif
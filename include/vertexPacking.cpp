@@ -0,0 +1,205 @@
+#include "vertexPacking.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+// Meio texel de uma textura de 1024 na uv; posição e normal bem abaixo do visível.
+const float VertexPacking::MAX_POSITION_ERROR = 1e-4f;
+const float VertexPacking::MAX_NORMAL_DEGREES = 1.5f;
+const float VertexPacking::MAX_TEXCOORD_ERROR = 1.0f / 2048.0f;
+
+bool VertexPacking::supported()
+{
+    return GLExt::loadBuffers() && GLExt::hasHalfFloatVertex();
+}
+
+GLushort VertexPacking::toHalf(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t rawExponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+    if (rawExponent == 0xFFu)
+        return static_cast<GLushort>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+
+    int exponent = static_cast<int>(rawExponent) - 127 + 15;
+    if (exponent >= 31)
+        return static_cast<GLushort>(sign | 0x7C00u);
+    if (exponent <= 0)
+    {
+        // Subnormal do half (ou zero); arredonda para o par mais próximo.
+        if (exponent < -10)
+            return static_cast<GLushort>(sign);
+        mantissa |= 0x800000u;
+        uint32_t shift = static_cast<uint32_t>(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        uint32_t rest = mantissa & ((1u << shift) - 1u);
+        uint32_t middle = 1u << (shift - 1u);
+        if (rest > middle || (rest == middle && (half & 1u)))
+            ++half;
+        return static_cast<GLushort>(sign | half);
+    }
+
+    uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    uint32_t rest = mantissa & 0x1FFFu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u)))
+        ++half; // o vai-um pode subir o expoente, que é o arredondamento certo
+    return static_cast<GLushort>(half);
+}
+
+float VertexPacking::fromHalf(GLushort value)
+{
+    uint32_t sign = (value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1Fu;
+    uint32_t mantissa = value & 0x3FFu;
+    uint32_t bits;
+    if (exponent == 0)
+    {
+        float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -magnitude : magnitude;
+    }
+    if (exponent == 31)
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    else
+        bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+VertexPacking::Error VertexPacking::pack(const GpuVertex *vertices, size_t count, std::vector<PackedVertex> &out,
+                                         float decode[4])
+{
+    Error error = {0.0f, 0.0f, 0.0f};
+    out.resize(count);
+    float lo[3] = {0.0f, 0.0f, 0.0f}, hi[3] = {0.0f, 0.0f, 0.0f};
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float p[3] = {vertices[i].px, vertices[i].py, vertices[i].pz};
+        for (int c = 0; c < 3; ++c)
+        {
+            lo[c] = i == 0 ? p[c] : std::min(lo[c], p[c]);
+            hi[c] = i == 0 ? p[c] : std::max(hi[c], p[c]);
+        }
+    }
+
+    // Escala única nos três eixos: a normal só muda de comprimento (GL_NORMALIZE resolve).
+    float halfExtent = 0.0f, radius = 0.0f;
+    for (int c = 0; c < 3; ++c)
+    {
+        decode[c] = 0.5f * (lo[c] + hi[c]);
+        halfExtent = std::max(halfExtent, 0.5f * (hi[c] - lo[c]));
+        radius += 0.25f * (hi[c] - lo[c]) * (hi[c] - lo[c]);
+    }
+    radius = std::sqrt(radius);
+    decode[3] = halfExtent > 0.0f ? halfExtent / 32767.0f : 1.0f;
+
+    double maxPosition = 0.0, minNormalDot = 1.0, maxTexCoord = 0.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const GpuVertex &src = vertices[i];
+        PackedVertex &dst = out[i];
+
+        const float p[3] = {src.px, src.py, src.pz};
+        GLshort q[3];
+        for (int c = 0; c < 3; ++c)
+        {
+            float scaled = std::round((p[c] - decode[c]) / decode[3]);
+            q[c] = static_cast<GLshort>(std::max(-32767.0f, std::min(32767.0f, scaled)));
+            maxPosition = std::max(maxPosition, std::fabs(double(decode[c]) + double(q[c]) * decode[3] - p[c]));
+        }
+        dst.px = q[0];
+        dst.py = q[1];
+        dst.pz = q[2];
+        dst.pw = 0;
+
+        float n[3] = {src.nx, src.ny, src.nz};
+        float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        GLbyte b[3] = {0, 0, 0};
+        if (length > 0.0f)
+        {
+            float decoded[3], decodedLength = 0.0f;
+            for (int c = 0; c < 3; ++c)
+            {
+                n[c] /= length;
+                b[c] = static_cast<GLbyte>(std::round(n[c] * 127.0f));
+                decoded[c] = b[c] / 127.0f;
+                decodedLength += decoded[c] * decoded[c];
+            }
+            decodedLength = std::sqrt(decodedLength);
+            if (decodedLength > 0.0f)
+                minNormalDot = std::min<double>(minNormalDot, (n[0] * decoded[0] + n[1] * decoded[1] + n[2] * decoded[2]) /
+                                                                  decodedLength);
+        }
+        dst.nx = b[0];
+        dst.ny = b[1];
+        dst.nz = b[2];
+        dst.nw = 0;
+
+        dst.u = toHalf(src.u);
+        dst.v = toHalf(src.v);
+        maxTexCoord = std::max(maxTexCoord, double(std::fabs(fromHalf(dst.u) - src.u)));
+        maxTexCoord = std::max(maxTexCoord, double(std::fabs(fromHalf(dst.v) - src.v)));
+    }
+
+    error.position = radius > 0.0f ? static_cast<float>(maxPosition / radius) : 0.0f;
+    error.normalDegrees = static_cast<float>(std::acos(std::min(1.0, minNormalDot)) * 180.0 / M_PI);
+    error.texCoord = static_cast<float>(maxTexCoord);
+    return error;
+}
+
+bool VertexPacking::acceptable(const Error &error)
+{
+    return error.position <= MAX_POSITION_ERROR && error.normalDegrees <= MAX_NORMAL_DEGREES &&
+           error.texCoord <= MAX_TEXCOORD_ERROR;
+}
+
+void VertexPacking::plan(const GpuVertex *vertices, size_t count, Plan &out)
+{
+    out = Plan();
+    // O flag só fica verdadeiro depois do GLExt::loadBuffers no thread principal.
+    if (!GLExt::hasHalfFloatVertex())
+        return;
+    out.decided = true;
+    out.error = pack(vertices, count, out.vertices, out.decode);
+    if (!acceptable(out.error))
+        std::vector<PackedVertex>().swap(out.vertices);
+}
+
+bool VertexPacking::upload(GpuMesh &gpu, const GpuVertex *vertices, size_t vertexCount,
+                           const void *indices, size_t indexCount, GLenum indexType, const char *label)
+{
+    Plan decision;
+    if (supported())
+        plan(vertices, vertexCount, decision);
+    return upload(gpu, vertices, vertexCount, decision, indices, indexCount, indexType, label);
+}
+
+bool VertexPacking::upload(GpuMesh &gpu, const GpuVertex *vertices, size_t vertexCount, const Plan &plan,
+                           const void *indices, size_t indexCount, GLenum indexType, const char *label)
+{
+    if (!plan.decided || !supported())
+    {
+        gpu.upload(vertices, vertexCount, indices, indexCount, indexType, GL_TRIANGLES);
+        return false;
+    }
+
+    bool compact = !plan.vertices.empty();
+    if (compact)
+        gpu.uploadPacked(plan.vertices.data(), vertexCount, plan.decode, indices, indexCount, indexType,
+                         GL_TRIANGLES);
+    else
+        gpu.upload(vertices, vertexCount, indices, indexCount, indexType, GL_TRIANGLES);
+
+    const Error &error = plan.error;
+    std::cout << "Vértices " << label << ": " << vertexCount << ", " << std::fixed << std::setprecision(1)
+              << vertexCount * sizeof(GpuVertex) / 1024.0 << " KB -> "
+              << vertexCount * plan.stride() / 1024.0 << " KB"
+              << (compact ? "" : " (mantido em float)") << "; erro posição " << std::setprecision(4)
+              << error.position * 100.0f << "%, normal " << std::setprecision(2) << error.normalDegrees
+              << " graus, uv " << std::setprecision(5) << error.texCoord << std::defaultfloat << std::endl;
+    return compact;
+}
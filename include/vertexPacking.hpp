@@ -0,0 +1,66 @@
+#ifndef VERTEX_PACKING_HPP
+#define VERTEX_PACKING_HPP
+
+#include <vector>
+#include "gpuMesh.hpp"
+
+// Vértice compacto de 16 bytes (o GpuVertex tem 32):
+// posição em 3 x int16 relativa à caixa da malha (a decodificação é uma escala + translação
+// somada à modelview, então serve para o pipeline fixo e para os shaders), normal em
+// 3 x int8 normalizado e uv em 2 x half float. Os campos de preenchimento mantêm cada
+// atributo alinhado em 4 bytes.
+struct PackedVertex
+{
+    GLshort px, py, pz, pw;
+    GLbyte nx, ny, nz, nw;
+    GLushort u, v;
+};
+
+class VertexPacking
+{
+public:
+    // Maior erro da codificação em um conjunto de vértices.
+    struct Error
+    {
+        float position; // relativo ao raio da caixa
+        float normalDegrees;
+        float texCoord; // absoluto, em unidades de uv
+    };
+
+    // O pipeline fixo precisa de glTexCoordPointer com GL_HALF_FLOAT.
+    static bool supported();
+
+    // decode = {centro x, y, z, escala}: posição = centro + q * escala.
+    static Error pack(const GpuVertex *vertices, size_t count, std::vector<PackedVertex> &out, float decode[4]);
+    static bool acceptable(const Error &error);
+
+    // Decisão do formato, sem chamar o GL (roda no worker do AssetLoader). Sem o GLExt
+    // iniciado fica sem decisão e o upload decide na hora.
+    struct Plan
+    {
+        std::vector<PackedVertex> vertices; // vazio: sobe em float
+        float decode[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+        Error error = {0.0f, 0.0f, 0.0f};
+        bool decided = false;
+
+        size_t stride() const { return vertices.empty() ? sizeof(GpuVertex) : sizeof(PackedVertex); }
+    };
+    static void plan(const GpuVertex *vertices, size_t count, Plan &out);
+
+    // Sobe compacto quando é suportado e o erro passa; senão sobe em float como antes.
+    // Escreve no console a memória antes/depois e o erro (label identifica a malha).
+    static bool upload(GpuMesh &gpu, const GpuVertex *vertices, size_t vertexCount,
+                       const void *indices, size_t indexCount, GLenum indexType, const char *label);
+    static bool upload(GpuMesh &gpu, const GpuVertex *vertices, size_t vertexCount, const Plan &plan,
+                       const void *indices, size_t indexCount, GLenum indexType, const char *label);
+
+    static GLushort toHalf(float value);
+    static float fromHalf(GLushort value);
+
+private:
+    static const float MAX_POSITION_ERROR;
+    static const float MAX_NORMAL_DEGREES;
+    static const float MAX_TEXCOORD_ERROR;
+};
+
+#endif
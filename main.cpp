@@ -10,6 +10,28 @@
 #include <memory>
 #include <algorithm>
 #include "data.hpp"
+#include "glState.cpp"
+#include "glExt.cpp"
+#include "shaderProgram.cpp"
+#include "gpuMesh.cpp"
+#include "lightManager.cpp"
+#include "lightBaker.cpp"
+#include "occlusionCuller.cpp"
+#include "minimap.cpp"
+#include "qualityManager.cpp"
+#include "mappedFile.cpp"
+#include "objParser.cpp"
+#include "objBenchmark.cpp"
+#include "meshOptimizer.cpp"
+#include "meshCache.cpp"
+#include "meshGeometry.cpp"
+#include "vertexPacking.cpp"
+#include "gltfParser.cpp"
+#include "assetLoader.cpp"
+#include "textureManager.cpp"
+#include "renderer.cpp"
+#include "textRenderer.cpp"
+#include "hudWidget.cpp"
 #include "portal.cpp"
 #include "skill.cpp"
 #include "staticObject.cpp"
@@ -18,10 +40,16 @@
 #include "mesh.hpp"
 #include "meshLoader.cpp"
 #include "enemy.cpp"
+#include "entityRenderer.cpp"
+#include "healthBarPass.cpp"
+#include "particleSystem.cpp"
 #include "game.cpp"
 #include "Boss.cpp"
 #include "gameObject.cpp"
+#include "textureCompression.cpp"
+#include "textureCache.cpp"
 #include "textureLoader.cpp"
+#include "textureAtlas.cpp"
 #include "light.cpp"
 
 const int DUNGEON_WIDTH = 10;
@@ -47,18 +75,10 @@ unsigned int texturaBoss;
 unsigned int texturaDungeon3;
 unsigned int texturaDungeon2;
 unsigned int texturaDungeon1;
-unsigned int textureWood;
-unsigned int textureTrunk;
-unsigned int textureRock;
 unsigned int textureItem;
-unsigned int textureWall;
-unsigned int textureLeaves;
-unsigned int textureHouseWall;
-unsigned int textureRoof;
-unsigned int textureDoor;
-unsigned int textureBrick;
 unsigned int texturaJogadorCabeca;
-unsigned int textureFloor;
+
+bool usarShaders = false;
 
 void display() { Game::displayCallback(); }
 void reshape(int w, int h) { Game::reshapeCallback(w, h); }
@@ -73,33 +93,33 @@ void Joystick(unsigned int buttonMask, int x, int y, int z) { Game::JoystickCall
 
 void init()
 {
+    GLState::init();
+#ifdef GLSTATE_VALIDATE
+    GLState::setValidation(true);
+#endif
     glClearColor(0.4f, 0.6f, 0.9f, 1.0f);
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_COLOR_MATERIAL);
+    GLState::enable(GL_DEPTH_TEST);
+    GLState::enable(GL_COLOR_MATERIAL);
 
     Light::initLight();
+    if (usarShaders)
+        Renderer::setEnabled(Renderer::init());
 
-    texturaJogador = loadTexture("src/textures/player.png");
-    texturaJogadorCabeca = loadTexture("src/textures/geraldo.png");
-    texturaGrama = loadTexture("src/textures/grass.png");
-    texturaPortal = loadTexture("src/textures/portal.png");
-    texturaParaside = loadTexture("src/textures/grass.png");
-    texturaBoss = loadTexture("src/textures/dungeon.png");
-    texturaDungeon3 = loadTexture("src/textures/dungeon.png");
-    texturaDungeon2 = loadTexture("src/textures/dungeon.png");
-    texturaDungeon1 = loadTexture("src/textures/dungeon.png");
-
-    textureWood = loadTexture("src/textures/wood.png");
-    textureTrunk = loadTexture("src/textures/wood.png");
-    textureRock = loadTexture("src/textures/rock.png");
-    textureItem = loadTexture("src/textures/gold.png");
-    textureWall = loadTexture("src/textures/wall.png");
-    textureLeaves = loadTexture("src/textures/wall.png");
-    textureHouseWall = loadTexture("src/textures/house_wall.png");
-    textureRoof = loadTexture("src/textures/roof.png");
+    // Texturas e malhas decodificam no pool; o primeiro frame sai com os substitutos.
+    AssetLoader::start();
+    texturaJogador = TextureManager::acquire("src/textures/player.png");
+    texturaJogadorCabeca = TextureManager::acquire("src/textures/geraldo.png");
+    texturaGrama = TextureManager::acquire("src/textures/grass.png");
+    texturaPortal = TextureManager::acquire("src/textures/portal.png");
+    texturaParaside = TextureManager::acquire("src/textures/grass.png");
+    texturaBoss = TextureManager::acquire("src/textures/dungeon.png");
+    texturaDungeon3 = TextureManager::acquire("src/textures/dungeon.png");
+    texturaDungeon2 = TextureManager::acquire("src/textures/dungeon.png");
+    texturaDungeon1 = TextureManager::acquire("src/textures/dungeon.png");
 
-    textureDoor = loadTexture("src/textures/door.png");
-    textureBrick = loadTexture("src/textures/wall.png");
+    // Moedas instanciadas (EntityRenderer); o resto dos objetos fixos usa o atlas.
+    textureItem = TextureManager::acquire("src/textures/gold.png");
+    StaticObject::loadTextures(TextureManager::usesCompression());
     
     srand(static_cast<unsigned int>(time(nullptr)));
     Game::initCallback();
@@ -107,7 +127,19 @@ void init()
 
 int main(int argc, char **argv)
 {
+    // Só mede a leitura dos OBJs, sem abrir janela.
+    for (int i = 1; i < argc; ++i)
+        if (std::string(argv[i]) == "--bench-obj")
+            return ObjBenchmark::run();
+
     glutInit(&argc, argv);
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::string(argv[i]) == "--shaders")
+            usarShaders = true;
+        else if (std::string(argv[i]) == "--no-texture-compression")
+            TextureManager::setCompression(false);
+    }
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
     glutInitWindowSize(800, 600);
     glutInitWindowPosition(100, 100);